@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Suivi en direct d'un calcul Saint-Venant 1D qui diffuse ses trames en mémoire
+partagée (SaintVenant1D::ActiverDiffusion, voir src/DiffusionPartagee.h)
+
+    from diffusion_directe import LecteurDiffusion
+    lecteur = LecteurDiffusion('saintvenant')     # /dev/shm/saintvenant
+    lecteur.x, lecteur.zb                         # centres et fond
+    numero, t, h, hu = lecteur.derniere_trame()   # copie de la dernière trame publiée
+
+Affichage en direct (courbe de H si matplotlib est installé, sinon une ligne par
+trame : t, H max et position de la crête) :
+    python3 diffusion_directe.py saintvenant [images_par_seconde]
+
+La lecture ne demande que la bibliothèque standard, ne modifie pas le segment et ne
+ralentit pas le calcul : plusieurs lecteurs peuvent suivre le même calcul.
+"""
+
+import mmap
+import os
+import struct
+import sys
+import time
+from array import array
+
+SIGNATURE = b'SVDIFFUS'
+VERSION = 1
+MARQUEUR = 0x01020304
+# signature, version, marqueur, N, dx, nb_emplacements, terminé, taille d'un
+# emplacement, début des emplacements (ordre d'octets de la machine)
+FORMAT_ENTETE = '=8sIIQdIIQQ'
+POSITION_DERNIERE = 64
+TAILLE_ENTETE = 128
+FORMAT_EMPLACEMENT = '=QdQ'    # séquence, t, numéro
+TAILLE_TETE_EMPLACEMENT = 64
+NB_ESSAIS_LECTURE = 100
+
+
+class LecteurDiffusion:
+    def __init__(self, nom):
+        nom = nom.lstrip('/')
+        with open(os.path.join('/dev/shm', nom), 'rb') as f:
+            self._memoire = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        (signature, version, marqueur, N, dx, nb_emplacements, _, taille_emplacement,
+         debut_emplacements) = struct.unpack_from(FORMAT_ENTETE, self._memoire, 0)
+        if signature != SIGNATURE:
+            raise ValueError(f"{nom} : pas une diffusion Saint-Venant")
+        if marqueur != MARQUEUR:
+            raise ValueError(f"{nom} : écrit sur une machine d'un autre boutisme")
+        if version != VERSION:
+            raise ValueError(f"{nom} : version {version} inconnue")
+        self.nom = nom
+        self.N = N
+        self.dx = dx
+        self.nb_emplacements = nb_emplacements
+        self._taille_emplacement = taille_emplacement
+        self._debut_emplacements = debut_emplacements
+        self.zb = array('d', self._memoire[TAILLE_ENTETE:TAILLE_ENTETE + 8 * N])
+        self.x = [(i + 0.5) * dx for i in range(N)]
+        try:
+            import numpy as np
+            self._np = np
+            self.zb = np.array(self.zb)
+            self.x = np.array(self.x)
+        except ImportError:
+            self._np = None
+
+    def termine(self):
+        """Le calcul a fermé la diffusion (la dernière trame reste lisible)"""
+        return struct.unpack_from('=I', self._memoire, 36)[0] != 0
+
+    def derniere_trame(self):
+        """(numéro, t, h, hu) de la dernière trame publiée, None s'il n'y en a pas encore.
+        Python n'a pas de barrières mémoire : la vérification de la séquence suppose
+        l'ordre des lectures de x86-64. Une trame réécrite pendant la copie est alors
+        détectée et relue."""
+        m = self._memoire
+        N = self.N
+        for _ in range(NB_ESSAIS_LECTURE):
+            k = struct.unpack_from('=Q', m, POSITION_DERNIERE)[0]
+            if k == 0:
+                return None
+            debut = self._debut_emplacements + ((k - 1) % self.nb_emplacements) * self._taille_emplacement
+            s1, t, numero = struct.unpack_from(FORMAT_EMPLACEMENT, m, debut)
+            if s1 != 2 * k:
+                continue   # Déjà réécrit par une trame plus récente
+            donnees = debut + TAILLE_TETE_EMPLACEMENT
+            h = array('d', m[donnees:donnees + 8 * N])
+            hu = array('d', m[donnees + 8 * N:donnees + 16 * N])
+            if struct.unpack_from('=Q', m, debut)[0] != s1:
+                continue
+            if self._np is not None:
+                h, hu = self._np.array(h), self._np.array(hu)
+            return numero, t, h, hu
+        return None
+
+    def fermer(self):
+        self._memoire.close()
+
+
+# ================================================
+# AFFICHAGE EN DIRECT
+# ================================================
+def suivre_texte(lecteur, periode):
+    dernier = 0
+    while True:
+        trame = lecteur.derniere_trame()
+        if trame is not None and trame[0] != dernier:
+            numero, t, h, _ = trame
+            H = [h[i] + lecteur.zb[i] for i in range(lecteur.N)]
+            i_crete = max(range(lecteur.N), key=lambda i: h[i])
+            print(f"trame {numero:7d}  t = {t:9.4f} s  H max = {max(H):.4f} m  "
+                  f"crête en x = {lecteur.x[i_crete]:.3f} m", flush=True)
+            dernier = numero
+        if lecteur.termine():
+            print("calcul terminé")
+            return
+        time.sleep(periode)
+
+
+def suivre_graphique(lecteur, periode, plt):
+    np = lecteur._np
+    figure, axe = plt.subplots(figsize=(10, 4))
+    axe.fill_between(lecteur.x, lecteur.zb, min(lecteur.zb) - 0.1, color='saddlebrown', alpha=0.5)
+    courbe, = axe.plot(lecteur.x, lecteur.zb, color='tab:blue')
+    titre = axe.set_title(lecteur.nom)
+    axe.set_xlabel('x (m)')
+    axe.set_ylabel('H (m)')
+    plt.ion()
+    plt.show()
+    dernier = 0
+    while plt.fignum_exists(figure.number):
+        trame = lecteur.derniere_trame()
+        if trame is not None and trame[0] != dernier:
+            numero, t, h, _ = trame
+            H = np.where(h > 1e-4, h + lecteur.zb, np.nan)
+            courbe.set_ydata(H)
+            axe.set_ylim(np.nanmin(lecteur.zb) - 0.1, max(np.nanmax(H), np.max(lecteur.zb)) + 0.1)
+            titre.set_text(f"{lecteur.nom} : t = {t:.3f} s (trame {numero})"
+                           + (" - terminé" if lecteur.termine() else ""))
+            dernier = numero
+        plt.pause(periode)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    lecteur = LecteurDiffusion(sys.argv[1])
+    periode = 1.0 / float(sys.argv[2]) if len(sys.argv) > 2 else 0.1
+    try:
+        import matplotlib.pyplot as plt
+        if lecteur._np is None:
+            raise ImportError
+    except ImportError:
+        plt = None
+    try:
+        if plt is not None:
+            suivre_graphique(lecteur, periode, plt)
+        else:
+            suivre_texte(lecteur, periode)
+    except KeyboardInterrupt:
+        pass
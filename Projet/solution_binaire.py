@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Sortie binaire en colonnes de Saint-Venant 1D (fichiers .svb, voir src/SortieBinaire.h)
+
+Lecture :
+    from solution_binaire import SolutionBinaire
+    sol = SolutionBinaire('solution.svb')
+    sol.x, sol.zb, sol.t          # centres, fond, temps des trames
+    h, hu = sol.trame(k)          # trame k, lue en O(1) par np.memmap
+    h, u, H = sol.instant(2.5)    # trame la plus proche de t = 2.5 s
+
+Conversion d'un fichier texte de Sauvegarder (t x h u zb H) :
+    python3 solution_binaire.py solution.txt [solution.svb]
+Résumé d'un fichier binaire :
+    python3 solution_binaire.py solution.svb
+
+La conversion lit le texte ligne par ligne (une trame en mémoire à la fois) et ne
+demande que la bibliothèque standard ; la lecture utilise numpy.
+"""
+
+import struct
+import sys
+from array import array
+
+SIGNATURE = b'SVSORTIE'
+SIGNATURE_INDEX = b'SVINDEX\0'
+VERSION = 1
+MARQUEUR = 0x01020304
+# signature, version, marqueur, octets par valeur, réservé, N, dx, début des trames,
+# taille d'une trame, réservé (64 octets, ordre d'octets de la machine)
+FORMAT_ENTETE = '=8sIIIIQdQQQ'
+FORMAT_PIED = '=8sQ'
+TAILLE_ENTETE = struct.calcsize(FORMAT_ENTETE)
+TAILLE_PIED = struct.calcsize(FORMAT_PIED)
+
+
+# ================================================
+# LECTURE
+# ================================================
+class SolutionBinaire:
+    def __init__(self, nom):
+        import numpy as np
+        self.nom = nom
+        with open(nom, 'rb') as f:
+            entete = f.read(TAILLE_ENTETE)
+            f.seek(0, 2)
+            taille = f.tell()
+            if len(entete) < TAILLE_ENTETE:
+                raise ValueError(f"{nom} : fichier tronqué")
+            (signature, version, marqueur, octets, _, N, dx,
+             debut, taille_trame, _) = struct.unpack(FORMAT_ENTETE, entete)
+            if signature != SIGNATURE:
+                raise ValueError(f"{nom} : pas une sortie binaire Saint-Venant")
+            if marqueur != MARQUEUR:
+                raise ValueError(f"{nom} : écrit sur une machine d'un autre boutisme")
+            if version != VERSION or octets != 4:
+                raise ValueError(f"{nom} : version {version} ({octets} octets par valeur) inconnue")
+
+            # Index des temps s'il est complet, sinon trames entières présentes
+            nb = (taille - debut) // taille_trame
+            avec_index = False
+            if taille >= debut + TAILLE_PIED:
+                f.seek(taille - TAILLE_PIED)
+                signature_index, nb_index = struct.unpack(FORMAT_PIED, f.read(TAILLE_PIED))
+                if (signature_index == SIGNATURE_INDEX
+                        and debut + nb_index * (taille_trame + 8) + TAILLE_PIED == taille):
+                    nb, avec_index = nb_index, True
+
+        self.N = N
+        self.dx = dx
+        self.x = np.memmap(nom, dtype=np.float64, mode='r', offset=TAILLE_ENTETE, shape=(N,))
+        self.zb = np.memmap(nom, dtype=np.float64, mode='r', offset=TAILLE_ENTETE + 8 * N, shape=(N,))
+        type_trame = np.dtype([('t', np.float64), ('h', np.float32, (N,)), ('hu', np.float32, (N,))])
+        self.trames = (np.memmap(nom, dtype=type_trame, mode='r', offset=debut, shape=(nb,))
+                       if nb > 0 else np.zeros(0, dtype=type_trame))
+        if avec_index:
+            self.t = np.memmap(nom, dtype=np.float64, mode='r', offset=debut + nb * taille_trame, shape=(nb,))
+        else:
+            self.t = np.array(self.trames['t'])
+
+    def __len__(self):
+        return len(self.t)
+
+    def trame(self, k):
+        """h et hu de la trame k (float32, sans copie)"""
+        trame = self.trames[k]
+        return trame['h'], trame['hu']
+
+    def instant(self, t, critere_h=1e-4):
+        """h, u et H = h + zb de la trame la plus proche du temps t"""
+        import numpy as np
+        k = int(np.argmin(np.abs(np.asarray(self.t) - t)))
+        h, hu = self.trame(k)
+        h = h.astype(np.float64)
+        u = np.where(h > critere_h, hu / np.maximum(h, critere_h), 0.0)
+        return h, u, h + self.zb
+
+
+# ================================================
+# CONVERSION DEPUIS LE TEXTE
+# ================================================
+def _trames_texte(nom):
+    """Trames (t, x, h, u, zb) du fichier texte, séparées par des lignes vides"""
+    t, x, h, u, zb = None, [], [], [], []
+    with open(nom) as f:
+        for ligne in f:
+            valeurs = ligne.split()
+            if not valeurs:
+                if x:
+                    yield t, x, h, u, zb
+                t, x, h, u, zb = None, [], [], [], []
+                continue
+            t = float(valeurs[0])
+            x.append(float(valeurs[1]))
+            h.append(float(valeurs[2]))
+            u.append(float(valeurs[3]))
+            zb.append(float(valeurs[4]))
+    if x:
+        yield t, x, h, u, zb
+
+
+def convertir(nom_texte, nom_binaire):
+    """Convertit un fichier texte de Sauvegarder ; retourne le nombre de trames"""
+    temps = []
+    with open(nom_binaire, 'wb') as sortie:
+        N = None
+        for t, x, h, u, zb in _trames_texte(nom_texte):
+            if N is None:
+                N = len(x)
+                if N < 2:
+                    raise ValueError(f"{nom_texte} : au moins deux cellules attendues")
+                # x est écrit avec 6 chiffres : dx à partir des cellules extrêmes
+                dx = (x[-1] - x[0]) / (N - 1)
+                debut = TAILLE_ENTETE + 16 * N
+                taille_trame = 8 + 8 * N
+                sortie.write(struct.pack(FORMAT_ENTETE, SIGNATURE, VERSION, MARQUEUR, 4, 0,
+                                         N, dx, debut, taille_trame, 0))
+                array('d', [(i + 0.5) * dx for i in range(N)]).tofile(sortie)
+                array('d', zb).tofile(sortie)
+            elif len(x) != N:
+                raise ValueError(f"{nom_texte} : trame de {len(x)} cellules au lieu de {N} (t = {t})")
+            sortie.write(struct.pack('=d', t))
+            array('f', h).tofile(sortie)
+            array('f', [hi * ui for hi, ui in zip(h, u)]).tofile(sortie)
+            temps.append(t)
+
+        if N is None:
+            raise ValueError(f"{nom_texte} : aucune trame")
+        array('d', temps).tofile(sortie)
+        sortie.write(struct.pack(FORMAT_PIED, SIGNATURE_INDEX, len(temps)))
+    return len(temps)
+
+
+def resumer(nom):
+    sol = SolutionBinaire(nom)
+    print(f"{nom} : N = {sol.N}, dx = {sol.dx:g} m, {len(sol)} trames", end='')
+    if len(sol):
+        print(f" de t = {sol.t[0]:g} s à t = {sol.t[-1]:g} s")
+    else:
+        print()
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    entree = sys.argv[1]
+    with open(entree, 'rb') as f:
+        binaire = f.read(8) == SIGNATURE
+    if binaire:
+        resumer(entree)
+    else:
+        sortie = sys.argv[2] if len(sys.argv) > 2 else entree.rsplit('.', 1)[0] + '.svb'
+        nb = convertir(entree, sortie)
+        print(f"{entree} -> {sortie} : {nb} trames")
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Lecture en flux des sorties compressées de Saint-Venant 1D (fichiers .svz, voir
+src/SortieCompressee.h)
+
+    from solution_compressee import SolutionCompressee
+    sol = SolutionCompressee('solution.svz')
+    sol.x, sol.zb                 # centres et fond
+    for t, h, u in sol:           # trames décodées une à une (h, u : listes, ou
+        ...                       # tableaux numpy si numpy est installé)
+
+Résumé d'un fichier (trames, taux de compression par rapport à .svb) :
+    python3 solution_compressee.py solution.svz
+
+Le décodage ne demande que la bibliothèque standard ; une trame ne peut être décodée
+qu'après les précédentes depuis la dernière trame clé.
+"""
+
+import struct
+import sys
+from array import array
+
+SIGNATURE = b'SVCOMPRE'
+VERSION = 1
+MARQUEUR = 0x01020304
+# signature, version, marqueur, N, dx, tolérance h, tolérance u, intervalle des
+# trames clés, réservé (56 octets, ordre d'octets de la machine)
+FORMAT_ENTETE = '=8sIIQdddII'
+FORMAT_TRAME = '=dBI'     # t, clé, taille de la suite
+TAILLE_ENTETE = struct.calcsize(FORMAT_ENTETE)
+TAILLE_TRAME = struct.calcsize(FORMAT_TRAME)
+NB_CLASSES = 96
+PREMIERE_CLASSE_SERIE = 64
+LONGUEUR_CODE_MAX = 15
+
+
+# ================================================
+# DÉCODAGE D'UN CHAMP
+# ================================================
+def _decoder_champ(octets, position, N, cle, q):
+    """Met à jour q (liste de N entiers) ; retourne la position après le champ"""
+    nb_classes = octets[position]
+    position += 1
+    longueurs = {}
+    for _ in range(nb_classes):
+        longueurs[octets[position]] = octets[position + 1]
+        position += 2
+    nb_octets, = struct.unpack_from('=I', octets, position)
+    position += 4
+    bits = octets[position:position + nb_octets]
+    position += nb_octets
+
+    # Code canonique : (longueur, code) -> classe
+    table = {}
+    code = 0
+    for longueur in range(1, LONGUEUR_CODE_MAX + 1):
+        for classe in sorted(c for c, l in longueurs.items() if l == longueur):
+            table[(longueur, code)] = classe
+            code += 1
+        code <<= 1
+
+    n_bits = 8 * len(bits)
+    p = 0
+
+    def lire(n):
+        nonlocal p
+        if p + n > n_bits:
+            raise ValueError("trame corrompue")
+        v = 0
+        for _ in range(n):
+            v = (v << 1) | ((bits[p >> 3] >> (7 - (p & 7))) & 1)
+            p += 1
+        return v
+
+    i = 0
+    while i < N:
+        code, longueur = 0, 0
+        while True:
+            code = (code << 1) | lire(1)
+            longueur += 1
+            classe = table.get((longueur, code))
+            if classe is not None:
+                break
+            if longueur >= LONGUEUR_CODE_MAX:
+                raise ValueError("trame corrompue")
+        if classe >= PREMIERE_CLASSE_SERIE:
+            b = classe - PREMIERE_CLASSE_SERIE + 1
+            L = (1 << (b - 1)) | lire(b - 1)
+            if cle:
+                q[i:i + L] = [0] * L
+            i += L
+        else:
+            b = classe + 1
+            z = (1 << (b - 1)) | lire(b - 1)
+            d = (z >> 1) ^ -(z & 1)
+            q[i] = d if cle else q[i] + d
+            i += 1
+    return position
+
+
+def _reconstruire(q, tolerance):
+    if tolerance > 0.0:
+        pas = 2.0 * tolerance
+        return [v * pas for v in q]
+    # Sans perte : q contient les bits des floats
+    return list(array('f', array('I', q).tobytes()))
+
+
+# ================================================
+# LECTURE
+# ================================================
+class SolutionCompressee:
+    def __init__(self, nom):
+        self.nom = nom
+        with open(nom, 'rb') as f:
+            entete = f.read(TAILLE_ENTETE)
+            if len(entete) < TAILLE_ENTETE:
+                raise ValueError(f"{nom} : fichier tronqué")
+            (signature, version, marqueur, N, dx, tolerance_h, tolerance_u,
+             intervalle_cle, _) = struct.unpack(FORMAT_ENTETE, entete)
+            if signature != SIGNATURE:
+                raise ValueError(f"{nom} : pas une sortie compressée Saint-Venant")
+            if marqueur != MARQUEUR:
+                raise ValueError(f"{nom} : écrit sur une machine d'un autre boutisme")
+            if version != VERSION:
+                raise ValueError(f"{nom} : version {version} inconnue")
+            self.zb = array('d')
+            self.zb.fromfile(f, N)
+        self.N = N
+        self.dx = dx
+        self.tolerance_h = tolerance_h
+        self.tolerance_u = tolerance_u
+        self.intervalle_cle = intervalle_cle
+        self.x = [(i + 0.5) * dx for i in range(N)]
+        try:
+            import numpy as np
+            self._np = np
+            self.zb = np.array(self.zb)
+            self.x = np.array(self.x)
+        except ImportError:
+            self._np = None
+
+    def __iter__(self):
+        """Trames (t, h, u) dans l'ordre du fichier"""
+        N = self.N
+        q_h, q_u = [0] * N, [0] * N
+        with open(self.nom, 'rb') as f:
+            f.seek(TAILLE_ENTETE + 8 * N)
+            while True:
+                entete = f.read(TAILLE_TRAME)
+                if len(entete) < TAILLE_TRAME:
+                    return
+                t, cle, taille = struct.unpack(FORMAT_TRAME, entete)
+                octets = f.read(taille)
+                if len(octets) < taille:
+                    return   # Dernière trame incomplète (calcul interrompu)
+                position = _decoder_champ(octets, 0, N, cle, q_h)
+                _decoder_champ(octets, position, N, cle, q_u)
+                h = _reconstruire(q_h, self.tolerance_h)
+                u = _reconstruire(q_u, self.tolerance_u)
+                if self._np is not None:
+                    h, u = self._np.array(h), self._np.array(u)
+                yield t, h, u
+
+    def tailles_trames(self):
+        """(t, clé, octets) de chaque trame, sans décodage"""
+        resultat = []
+        with open(self.nom, 'rb') as f:
+            f.seek(TAILLE_ENTETE + 8 * self.N)
+            while True:
+                entete = f.read(TAILLE_TRAME)
+                if len(entete) < TAILLE_TRAME:
+                    return resultat
+                t, cle, taille = struct.unpack(FORMAT_TRAME, entete)
+                f.seek(taille, 1)
+                resultat.append((t, cle, TAILLE_TRAME + taille))
+
+
+def resumer(nom):
+    sol = SolutionCompressee(nom)
+    trames = sol.tailles_trames()
+    octets = TAILLE_ENTETE + 8 * sol.N + sum(taille for _, _, taille in trames)
+    octets_svb = 64 + 16 * sol.N + len(trames) * (8 + 8 * sol.N)
+    tolerances = ("sans perte (float)" if sol.tolerance_h == 0.0 and sol.tolerance_u == 0.0
+                  else f"tolérances h {sol.tolerance_h:g} m, u {sol.tolerance_u:g} m/s")
+    print(f"{nom} : N = {sol.N}, dx = {sol.dx:g} m, {tolerances}")
+    if trames:
+        nb_cles = sum(cle for _, cle, _ in trames)
+        print(f"  {len(trames)} trames ({nb_cles} clés) de t = {trames[0][0]:g} s à t = {trames[-1][0]:g} s")
+    print(f"  {octets} octets, taux de compression x{octets_svb / octets:.1f} par rapport à .svb")
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    resumer(sys.argv[1])
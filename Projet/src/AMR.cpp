@@ -0,0 +1,449 @@
+#include "AMR.h"
+#include "SaintVenant.h"
+#include "Schemas.h"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+SaintVenantAMR::SaintVenantAMR() : _N_base(0), _taille_bloc(1), _niveau_max(0), _nb_blocs(0),
+    _L(0.0), _dx_base(0.0), _t(0.0), _dt(0.0), _CFL(0.9), _pas(0), _seuil_pente(0.02), _periode(4)
+{
+    ChoisirSchema("hll/hydrostatique");
+}
+
+
+SaintVenantAMR::~SaintVenantAMR()
+{
+    if (_fichier.is_open())
+        _fichier.close();
+}
+
+
+bool SaintVenantAMR::Initialiser(const SaintVenant1D& reference, int N_base, int niveau_max, int taille_bloc,
+                                 double CFL, string nom_fichier)
+{
+    if (N_base < 2 || niveau_max < 0 || taille_bloc < 1)
+    {
+        cout << "Erreur : grille AMR invalide (N_base >= 2, niveau_max >= 0, taille_bloc >= 1)" << endl;
+        return false;
+    }
+    int N_fin = N_base << niveau_max;
+    if ((int)reference.ObtenirH().size() != N_fin)
+    {
+        cout << "Erreur : le solveur de reference doit avoir N_base * 2^niveau_max = " << N_fin
+             << " cellules (il en a " << reference.ObtenirH().size() << ")" << endl;
+        return false;
+    }
+
+    _N_base = N_base;
+    _niveau_max = niveau_max;
+    _taille_bloc = taille_bloc;
+    _nb_blocs = (N_base + taille_bloc - 1) / taille_bloc;
+    _L = N_fin * reference.ObtenirDx();
+    _dx_base = _L / N_base;
+    _CFL = CFL;
+    _t = 0.0;
+    _pas = 0;
+
+    // Au départ, tout au niveau le plus fin : la grille composite est celle de la référence
+    _zb_fin = reference.ObtenirZb();
+    _niveau_bloc.assign(_nb_blocs, niveau_max);
+    ConstruireGeometrie();
+    _h = reference.ObtenirH();
+    _hu = reference.ObtenirHu();
+
+    // Puis déraffinement loin des fronts
+    Regriller();
+
+    _fichier.open(nom_fichier);
+
+    cout << "Simulation AMR initialisée :" << endl;
+    cout << "  - Grille de base : " << N_base << " cellules (dx = " << _dx_base << " m)" << endl;
+    cout << "  - Niveaux : 0 .. " << niveau_max << " (dx fin = " << _dx_base / (1 << niveau_max) << " m)" << endl;
+    cout << "  - Blocs : " << _nb_blocs << " de " << taille_bloc << " cellules de base" << endl;
+    cout << "  - Cellules composites : " << _h.size() << " (grille fine : " << N_fin << ")" << endl;
+    return true;
+}
+
+
+bool SaintVenantAMR::ChoisirSchema(const string& config)
+{
+    struct EntreeSchema
+    {
+        const char* flux;
+        const char* source;
+        FonctionSchema fonction;
+    };
+    static const EntreeSchema schemas[] = {
+        { FluxPolitiqueRusanov::Nom(), SourceHydrostatique::Nom(), &SaintVenantAMR::CalculerFluxEtMiseAJour<FluxPolitiqueRusanov, SourceHydrostatique> },
+        { FluxPolitiqueHLL::Nom(),     SourceHydrostatique::Nom(), &SaintVenantAMR::CalculerFluxEtMiseAJour<FluxPolitiqueHLL,     SourceHydrostatique> },
+        { FluxPolitiqueRusanov::Nom(), SourcePenteCentree::Nom(),  &SaintVenantAMR::CalculerFluxEtMiseAJour<FluxPolitiqueRusanov, SourcePenteCentree> },
+        { FluxPolitiqueHLL::Nom(),     SourcePenteCentree::Nom(),  &SaintVenantAMR::CalculerFluxEtMiseAJour<FluxPolitiqueHLL,     SourcePenteCentree> },
+    };
+
+    size_t separateur = config.find('/');
+    string flux = NomFluxEffectif(config.substr(0, separateur));
+    string source = (separateur == string::npos) ? SourceHydrostatique::Nom() : config.substr(separateur + 1);
+
+    for (const EntreeSchema& entree : schemas)
+    {
+        if (flux == entree.flux && source == entree.source)
+        {
+            _schema = entree.fonction;
+            _nom_schema = flux + "/" + source;
+            return true;
+        }
+    }
+
+    cout << "Erreur : schema inconnu '" << config << "' (flux : rusanov, hll ; source : hydrostatique, pente)" << endl;
+    return false;
+}
+
+
+void SaintVenantAMR::DefinirCriteres(double seuil_pente, int periode)
+{
+    if (periode < 1)
+    {
+        cout << "Erreur : periode de regrillage " << periode << " invalide (>= 1)" << endl;
+        return;
+    }
+    _seuil_pente = seuil_pente;
+    _periode = periode;
+}
+
+
+// ========================================
+// Géométrie de la grille composite
+// ========================================
+
+int SaintVenantAMR::CellulesBloc(int bloc, int niveau) const
+{
+    int cellules_base = min(_taille_bloc, _N_base - bloc * _taille_bloc);
+    return cellules_base << niveau;
+}
+
+
+double SaintVenantAMR::FondMoyen(int bloc, int niveau, int j) const
+{
+    // Une cellule du niveau donné recouvre r cellules de la grille fine
+    int r = 1 << (_niveau_max - niveau);
+    int premier = ((bloc * _taille_bloc) << _niveau_max) + j * r;
+
+    double somme = 0.0;
+    for (int k = 0; k < r; k++)
+        somme += _zb_fin[premier + k];
+    return somme / r;
+}
+
+
+void SaintVenantAMR::ConstruireGeometrie()
+{
+    _debut_bloc.resize(_nb_blocs + 1);
+    _debut_bloc[0] = 0;
+    for (int b = 0; b < _nb_blocs; b++)
+        _debut_bloc[b + 1] = _debut_bloc[b] + CellulesBloc(b, _niveau_bloc[b]);
+
+    int n = _debut_bloc[_nb_blocs];
+    _zb.resize(n);
+    _dx.resize(n);
+    _x.resize(n);
+    for (int b = 0; b < _nb_blocs; b++)
+    {
+        double dx = _dx_base / (1 << _niveau_bloc[b]);
+        double x_debut = b * _taille_bloc * _dx_base;
+        for (int j = 0; j < _debut_bloc[b + 1] - _debut_bloc[b]; j++)
+        {
+            int i = _debut_bloc[b] + j;
+            _dx[i] = dx;
+            _x[i] = x_debut + (j + 0.5) * dx;
+            _zb[i] = FondMoyen(b, _niveau_bloc[b], j);
+        }
+    }
+    _z_interface.resize(n + 1);
+    _saut_zb.resize(n + 1);
+    ConstruireGeometrieFond(n, _zb.data(), _z_interface.data(), _saut_zb.data());
+
+    // Tampons du pas de temps
+    _h_nouveau.resize(n);
+    _hu_nouveau.resize(n);
+    _face_hG.resize(n + 1);
+    _face_hD.resize(n + 1);
+    _flux_h.resize(n + 1);
+    _flux_hu.resize(n + 1);
+}
+
+
+// ========================================
+// Regrillage
+// ========================================
+
+bool SaintVenantAMR::IndicateurRaffinement(int bloc) const
+{
+    int n = (int)_h.size();
+
+    // Les interfaces du bloc, y compris celles avec les blocs voisins
+    int i_debut = max(0, _debut_bloc[bloc] - 1);
+    int i_fin = min(n - 1, _debut_bloc[bloc + 1]);
+    for (int i = i_debut; i < i_fin; i++)
+    {
+        bool mouille_G = _h[i] > critere_hauteur_deau;
+        bool mouille_D = _h[i+1] > critere_hauteur_deau;
+
+        // Limite mouillé/sec (rivage)
+        if (mouille_G != mouille_D)
+            return true;
+
+        // Front : pente de la surface libre
+        if (mouille_G)
+        {
+            double pente = (_h[i+1] + _zb[i+1] - _h[i] - _zb[i]) / (0.5 * (_dx[i] + _dx[i+1]));
+            if (fabs(pente) > _seuil_pente)
+                return true;
+        }
+    }
+    return false;
+}
+
+
+void SaintVenantAMR::Regriller()
+{
+    // 1. Blocs à raffiner et leurs voisins au niveau max, les autres au niveau 0
+    vector<int> niveaux(_nb_blocs, 0);
+    for (int b = 0; b < _nb_blocs; b++)
+    {
+        if (IndicateurRaffinement(b))
+        {
+            for (int v = max(0, b - 1); v <= min(_nb_blocs - 1, b + 1); v++)
+                niveaux[v] = _niveau_max;
+        }
+    }
+
+    // 2. Au plus un niveau d'écart entre blocs voisins
+    for (int b = 1; b < _nb_blocs; b++)
+        niveaux[b] = max(niveaux[b], niveaux[b-1] - 1);
+    for (int b = _nb_blocs - 2; b >= 0; b--)
+        niveaux[b] = max(niveaux[b], niveaux[b+1] - 1);
+
+    if (niveaux != _niveau_bloc)
+        ChangerNiveaux(niveaux);
+}
+
+
+void SaintVenantAMR::ChangerNiveaux(const vector<int>& niveaux)
+{
+    vector<double> h, hu;
+    vector<double> h_bloc, hu_bloc, h_fils, hu_fils;
+
+    for (int b = 0; b < _nb_blocs; b++)
+    {
+        int ancien = _niveau_bloc[b], nouveau = niveaux[b];
+        h_bloc.assign(_h.begin() + _debut_bloc[b], _h.begin() + _debut_bloc[b + 1]);
+        hu_bloc.assign(_hu.begin() + _debut_bloc[b], _hu.begin() + _debut_bloc[b + 1]);
+
+        // Déraffiner : moyenne des r cellules fines (conserve h dx et hu dx)
+        if (nouveau < ancien)
+        {
+            int r = 1 << (ancien - nouveau);
+            int n = (int)h_bloc.size() / r;
+            for (int j = 0; j < n; j++)
+            {
+                double somme_h = 0.0, somme_hu = 0.0;
+                for (int k = 0; k < r; k++)
+                {
+                    somme_h += h_bloc[j * r + k];
+                    somme_hu += hu_bloc[j * r + k];
+                }
+                h_bloc[j] = somme_h / r;
+                hu_bloc[j] = somme_hu / r;
+            }
+            h_bloc.resize(n);
+            hu_bloc.resize(n);
+        }
+
+        // Raffiner, un niveau à la fois : chaque fils garde la surface libre du père
+        // (le lac au repos reste au repos) et la vitesse du père. Le fond du père est
+        // la moyenne de ceux des fils, donc h dx et hu dx sont conservés. Près du rivage
+        // (un fils serait à sec), les fils reçoivent simplement h et hu du père.
+        for (int l = ancien; l < nouveau; l++)
+        {
+            int n = (int)h_bloc.size();
+            h_fils.resize(2 * n);
+            hu_fils.resize(2 * n);
+            for (int j = 0; j < n; j++)
+            {
+                double eta = h_bloc[j] + FondMoyen(b, l, j);
+                double h1 = eta - FondMoyen(b, l + 1, 2 * j);
+                double h2 = eta - FondMoyen(b, l + 1, 2 * j + 1);
+                if (h_bloc[j] <= 0.0 || h1 < 0.0 || h2 < 0.0)
+                {
+                    h_fils[2*j] = h_fils[2*j + 1] = h_bloc[j];
+                    hu_fils[2*j] = hu_fils[2*j + 1] = hu_bloc[j];
+                }
+                else
+                {
+                    double u = hu_bloc[j] / h_bloc[j];
+                    h_fils[2*j] = h1;
+                    h_fils[2*j + 1] = h2;
+                    hu_fils[2*j] = h1 * u;
+                    hu_fils[2*j + 1] = h2 * u;
+                }
+            }
+            h_bloc.swap(h_fils);
+            hu_bloc.swap(hu_fils);
+        }
+
+        h.insert(h.end(), h_bloc.begin(), h_bloc.end());
+        hu.insert(hu.end(), hu_bloc.begin(), hu_bloc.end());
+    }
+
+    _niveau_bloc = niveaux;
+    ConstruireGeometrie();
+    _h.swap(h);
+    _hu.swap(hu);
+}
+
+
+// ========================================
+// Pas de temps
+// ========================================
+
+void SaintVenantAMR::CalculerPasDeTemps()
+{
+    // Plus petit dx / (|u| + c) : en pratique celui des cellules fines
+    double rapport_min = -1.0;
+    for (size_t i = 0; i < _h.size(); i++)
+    {
+        double u = (_h[i] > critere_hauteur_deau) ? _hu[i] / _h[i] : 0.0;
+        double c = (_h[i] > 1e-10) ? sqrt(_g * _h[i]) : 0.0;
+        double v = fabs(u) + c;
+        if (v > 1e-10 && (rapport_min < 0.0 || _dx[i] / v < rapport_min))
+            rapport_min = _dx[i] / v;
+    }
+
+    if (rapport_min > 0.0)
+        _dt = _CFL * rapport_min;
+    else
+        _dt = 0.01;  // Valeur par défaut si l'eau est immobile partout
+}
+
+
+// Mêmes étapes que SaintVenant1D::Avancer, avec le dx de chaque cellule
+template <class Flux, class Source>
+void SaintVenantAMR::CalculerFluxEtMiseAJour()
+{
+    int n = (int)_h.size();
+    const double* h = _h.data();
+    const GeometrieFond fond = { _zb.data(), _z_interface.data(), _saut_zb.data() };
+
+    // 1. Reconstruction et flux des interfaces 1 .. n-1 (un seul flux par interface)
+    for (int f = 1; f < n; f++)
+        Source::Reconstruire(h, fond, f, _face_hG[f], _face_hD[f]);
+    Flux::Lot(n - 1, &_face_hG[1], &_hu[0], &_face_hD[1], &_hu[1], &_flux_h[1], &_flux_hu[1], _g, critere_hauteur_deau);
+
+    // 2. Cellules intérieures
+    for (int i = 1; i < n - 1; i++)
+    {
+        double coeff = _dt / _dx[i];
+        double Source_i = Source::Source(h, fond, _face_hG.data(), _face_hD.data(), i, _g);
+
+        _h_nouveau[i] = _h[i] - coeff * (_flux_h[i+1] - _flux_h[i]);
+        _hu_nouveau[i] = _hu[i] - coeff * (_flux_hu[i+1] - _flux_hu[i]) + coeff * Source_i;
+    }
+}
+
+
+void SaintVenantAMR::AppliquerConditionsLimites(double* h, double* hu)
+{
+    // Fenêtre ouverte, comme SaintVenant1D
+    int n = (int)_h.size();
+    h[0] = h[1];
+    hu[0] = hu[1];
+    double H_voisin = h[n-2] + _zb[n-2];
+    h[n-1] = max(0.0, H_voisin - _zb[n-1]);
+    hu[n-1] = hu[n-2];
+}
+
+
+void SaintVenantAMR::Avancer()
+{
+    CalculerPasDeTemps();
+
+    (this->*_schema)();
+    AppliquerConditionsLimites(_h_nouveau.data(), _hu_nouveau.data());
+
+    // Cellules sèches
+    for (size_t i = 0; i < _h_nouveau.size(); i++)
+    {
+        if (_h_nouveau[i] < critere_hauteur_deau)
+        {
+            _h_nouveau[i] = 0.0;
+            _hu_nouveau[i] = 0.0;
+        }
+    }
+
+    _h.swap(_h_nouveau);
+    _hu.swap(_hu_nouveau);
+    _t += _dt;
+    _pas++;
+
+    if (_pas % _periode == 0)
+        Regriller();
+}
+
+
+// ========================================
+// Sauvegarde et validation
+// ========================================
+
+void SaintVenantAMR::Sauvegarder()
+{
+    for (size_t i = 0; i < _h.size(); i++)
+    {
+        double u = (_h[i] > critere_hauteur_deau) ? _hu[i] / _h[i] : 0.0;
+        double H = _h[i] + _zb[i];
+
+        // On écrit : t x h u zb H dx
+        _fichier << _t << " " << _x[i] << " " << _h[i] << " " << u << " " << _zb[i] << " " << H << " " << _dx[i] << endl;
+    }
+    _fichier << endl;
+}
+
+
+double SaintVenantAMR::CalculerMasseTotale()
+{
+    // Volume = somme de h * dx, chaque cellule avec son propre dx
+    double volume_total = 0.0;
+    for (size_t i = 0; i < _h.size(); i++)
+        volume_total += _h[i] * _dx[i];
+    return volume_total;
+}
+
+
+double SaintVenantAMR::ObtenirSurfaceMax()
+{
+    double H_max = -99999.0;
+    for (size_t i = 0; i < _h.size(); i++)
+    {
+        if (_h[i] > 1e-6)
+            H_max = max(H_max, _h[i] + _zb[i]);
+    }
+    return H_max;
+}
+
+
+double SaintVenantAMR::ObtenirPositionCrete()
+{
+    double H_max = -99999.0;
+    double x_max = 0.0;
+    for (size_t i = 0; i < _h.size(); i++)
+    {
+        double H_actuel = _h[i] + _zb[i];
+        if (_h[i] > 1e-4 && H_actuel > H_max)
+        {
+            H_max = H_actuel;
+            x_max = _x[i];
+        }
+    }
+    return x_max;
+}
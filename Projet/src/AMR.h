@@ -0,0 +1,144 @@
+#ifndef _AMR_H
+#define _AMR_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+class SaintVenant1D;
+
+// ========================================
+// Raffinement adaptatif par blocs (AMR) pour Saint-Venant 1D
+// ========================================
+// Le domaine est découpé en blocs de taille_bloc cellules de la grille de base.
+// Chaque bloc a un niveau 0 .. niveau_max : au niveau l, ses cellules ont un pas
+// dx_base / 2^l. Les blocs sont mis bout à bout en une seule grille composite de
+// cellules de tailles différentes, sur laquelle le schéma de SaintVenant1D
+// (mêmes politiques de flux et de source) avance avec un pas de temps global.
+//
+// Chaque interface a un seul flux, utilisé par ses deux cellules : aux frontières
+// entre niveaux, ce que perd un côté est exactement ce que gagne l'autre, et la
+// masse (somme de h dx) n'évolue que par les bords et le nettoyage des cellules
+// sèches, comme dans SaintVenant1D, aux arrondis près.
+//
+// Tous les periode pas, un bloc est raffiné au niveau max si un gradient de surface
+// ou une limite mouillé/sec y est détecté (ainsi que ses voisins, pour que le
+// front ne sorte pas de la zone fine avant le regrillage suivant), sinon il est
+// déraffiné. Deux blocs voisins ont au plus un niveau d'écart.
+// Raffiner et déraffiner conservent exactement h dx et hu dx (aux arrondis près).
+class SaintVenantAMR
+{
+private:
+    // Grille de base et niveaux
+    int _N_base;         // Nombre de cellules de la grille de base
+    int _taille_bloc;    // Cellules de base par bloc
+    int _niveau_max;     // Niveau le plus fin (dx_base / 2^niveau_max)
+    int _nb_blocs;
+    double _L;
+    double _dx_base;
+    double critere_hauteur_deau = 1e-4;
+
+    // Paramètres temporels
+    double _t;
+    double _dt;
+    double _CFL;
+    int _pas;            // Nombre de pas effectués
+
+    // Critères de raffinement
+    double _seuil_pente;  // |d(h + zb)/dx| au-delà duquel un bloc est raffiné
+    int _periode;         // Regrillage tous les _periode pas
+
+    // Bathymétrie sur la grille la plus fine (les niveaux plus grossiers en sont la moyenne)
+    std::vector<double> _zb_fin;
+
+    // Blocs : niveau et première cellule dans la grille composite (_debut_bloc[_nb_blocs] = nombre de cellules)
+    std::vector<int> _niveau_bloc;
+    std::vector<int> _debut_bloc;
+
+    // Grille composite
+    std::vector<double> _h;
+    std::vector<double> _hu;
+    std::vector<double> _zb;
+    std::vector<double> _z_interface;   // Tables du fond par interface (voir GeometrieFond, Schemas.h)
+    std::vector<double> _saut_zb;
+    std::vector<double> _dx;   // Pas d'espace de chaque cellule
+    std::vector<double> _x;    // Centre de chaque cellule
+
+    // Tampons du pas de temps
+    std::vector<double> _h_nouveau;
+    std::vector<double> _hu_nouveau;
+    std::vector<double> _face_hG;
+    std::vector<double> _face_hD;
+    std::vector<double> _flux_h;
+    std::vector<double> _flux_hu;
+
+    static constexpr double _g = 9.81;
+
+    std::ofstream _fichier;
+
+    // Schéma : une instanciation de CalculerFluxEtMiseAJour (voir Schemas.h)
+    typedef void (SaintVenantAMR::*FonctionSchema)();
+    FonctionSchema _schema;
+    std::string _nom_schema;
+
+    template <class Flux, class Source>
+    void CalculerFluxEtMiseAJour();
+    void AppliquerConditionsLimites(double* h, double* hu);
+    void CalculerPasDeTemps();
+
+    // Nombre de cellules d'un bloc au niveau donné
+    int CellulesBloc(int bloc, int niveau) const;
+    // Fond moyen de la cellule j d'un bloc au niveau donné
+    double FondMoyen(int bloc, int niveau, int j) const;
+    // Le bloc contient-il un front (gradient de surface ou limite mouillé/sec) ?
+    bool IndicateurRaffinement(int bloc) const;
+    // Reconstruit la grille composite avec les nouveaux niveaux des blocs
+    void ChangerNiveaux(const std::vector<int>& niveaux);
+    void ConstruireGeometrie();
+
+public:
+    SaintVenantAMR();
+    ~SaintVenantAMR();
+
+    // Initialiser à partir d'un solveur uniforme sur la grille la plus fine
+    // (N_base * 2^niveau_max cellules) dont le fond et la condition initiale sont
+    // déjà définis : les constructeurs de fond et de conditions initiales de
+    // SaintVenant1D servent tels quels. Retourne false si les tailles ne correspondent pas.
+    bool Initialiser(const SaintVenant1D& reference, int N_base, int niveau_max, int taille_bloc,
+                     double CFL, std::string nom_fichier);
+
+    // Schéma : mêmes configurations que SaintVenant1D::ChoisirSchema
+    bool ChoisirSchema(const std::string& config);
+    const std::string& ObtenirNomSchema() const { return _nom_schema; }
+
+    // Critères de raffinement : pente de surface seuil_pente, regrillage tous les periode pas
+    void DefinirCriteres(double seuil_pente, int periode);
+
+    // Adapter la grille à l'état courant (appelé par Avancer tous les periode pas)
+    void Regriller();
+
+    // Avancer d'un pas de temps (le pas est fixé par les cellules les plus fines)
+    void Avancer();
+
+    // Sauvegarder la solution : t x h u zb H dx (une ligne par cellule composite)
+    void Sauvegarder();
+
+    // Validation
+    double CalculerMasseTotale();
+    double ObtenirSurfaceMax();
+    double ObtenirPositionCrete();
+
+    // Accesseurs
+    double ObtenirTemps() const { return _t; }
+    double ObtenirDt() const { return _dt; }
+    int ObtenirNombreCellules() const { return (int)_h.size(); }
+    int ObtenirNombreCellulesFines() const { return _N_base << _niveau_max; }
+    const std::vector<int>& ObtenirNiveauxBlocs() const { return _niveau_bloc; }
+    const std::vector<double>& ObtenirH() const { return _h; }
+    const std::vector<double>& ObtenirHu() const { return _hu; }
+    const std::vector<double>& ObtenirZb() const { return _zb; }
+    const std::vector<double>& ObtenirDx() const { return _dx; }
+    const std::vector<double>& ObtenirX() const { return _x; }
+};
+
+#endif // _AMR_H
@@ -0,0 +1,210 @@
+// ========================================
+// Balayage de paramètres à partir de fichiers de scénarios
+// ========================================
+// Lit un ou plusieurs fichiers de scénarios (voir Scenarios.h), développe les
+// grilles de paramètres et calcule toutes les simulations en parallèle sur un
+// ordonnanceur à vol de travail (une simulation SaintVenant1D séquentielle par
+// tâche). Les tâches sont lancées de la plus coûteuse à la moins coûteuse
+// (coût estimé ~ ordre * N^2 * t_final / (CFL * L)).
+//
+// Affiche pour chaque simulation le thread, le temps de calcul, le nombre de pas,
+// les mises à jour de cellules par seconde et quelques diagnostics ; puis le temps
+// total, comparé à la durée qu'aurait eue une répartition statique à tour de rôle
+// dans le même ordre de lancement (tâche k au thread k mod nb_threads, mêmes durées
+// de tâches que celles mesurées).
+//
+// Usage : balayage scenarios.txt [autres fichiers...] [-t nb_threads] [-o rapport.csv]
+
+#include "SaintVenant.h"
+#include "Scenarios.h"
+#include "VolDeTravail.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <map>
+
+using namespace std;
+
+struct ResultatTache
+{
+    bool valide = false;
+    int thread = 0;
+    double debut = 0.0;      // secondes depuis le début du balayage
+    double duree = 0.0;
+    long nb_pas = 0;
+    double mises_a_jour = 0.0;
+    double erreur_masse = 0.0;   // relative
+    double H_max = 0.0;
+    double x_crete = 0.0;
+};
+
+
+static double CoutEstime(const Scenario& s)
+{
+    return s.ordre * (double)s.N * s.N * s.t_final / (s.CFL * s.L);
+}
+
+
+int main(int argc, char** argv)
+{
+    vector<string> fichiers;
+    int nb_threads = max(1, (int)thread::hardware_concurrency());
+    string rapport;
+    for (int k = 1; k < argc; k++)
+    {
+        if (strcmp(argv[k], "-t") == 0 && k + 1 < argc)
+            nb_threads = max(1, atoi(argv[++k]));
+        else if (strcmp(argv[k], "-o") == 0 && k + 1 < argc)
+            rapport = argv[++k];
+        else
+            fichiers.push_back(argv[k]);
+    }
+    if (fichiers.empty())
+    {
+        cout << "Usage : balayage scenarios.txt [autres fichiers...] [-t nb_threads] [-o rapport.csv]" << endl;
+        return 1;
+    }
+
+    vector<Scenario> scenarios;
+    for (const string& fichier : fichiers)
+        if (!LireScenarios(fichier, scenarios))
+            return 1;
+
+    // Les simulations tournent en même temps : deux d'entre elles ne peuvent pas écrire
+    // dans le même fichier (sortie commune à plusieurs sections ou fichiers)
+    map<string, size_t> sorties;
+    for (size_t j = 0; j < scenarios.size(); j++)
+    {
+        const string& nom_sortie = scenarios[j].sortie;
+        if (nom_sortie.empty())
+            continue;
+        auto existante = sorties.find(nom_sortie);
+        if (existante != sorties.end())
+        {
+            cout << "Erreur : les simulations " << existante->second << " et " << j << " ecrivent toutes deux dans '"
+                 << nom_sortie << "'" << endl;
+            return 1;
+        }
+        sorties[nom_sortie] = j;
+    }
+
+    // Ordre de lancement : du plus coûteux au moins coûteux
+    vector<int> ordre(scenarios.size());
+    for (size_t k = 0; k < ordre.size(); k++)
+        ordre[k] = (int)k;
+    stable_sort(ordre.begin(), ordre.end(), [&](int a, int b) { return CoutEstime(scenarios[a]) > CoutEstime(scenarios[b]); });
+
+    cout << scenarios.size() << " simulations, " << nb_threads << " thread(s)" << endl;
+
+    // Les solveurs écrivent leurs messages sur cout : silence pendant le balayage
+    vector<ResultatTache> resultats(scenarios.size());
+    OrdonnanceurVolDeTravail ordonnanceur(nb_threads);
+    streambuf* sortie = cout.rdbuf(nullptr);
+    cout.setstate(ios::failbit);
+    auto debut = chrono::steady_clock::now();
+
+    ordonnanceur.Executer((int)scenarios.size(), [&](int k, int id)
+    {
+        int j = ordre[k];
+        const Scenario& scenario = scenarios[j];
+        ResultatTache& r = resultats[j];
+        r.thread = id;
+        auto debut_tache = chrono::steady_clock::now();
+
+        SaintVenant1D solveur;
+        if (PreparerSolveur(scenario, solveur))
+        {
+            double masse_initiale = solveur.CalculerMasseTotale();
+            // Le dernier pas s'arrête sur t_final : toutes les simulations sont comparées
+            // au même instant
+            while (solveur.ObtenirTemps() < scenario.t_final)
+            {
+                solveur.Avancer(scenario.t_final);
+                r.nb_pas++;
+            }
+            if (!scenario.sortie.empty())
+                solveur.Sauvegarder();
+
+            r.valide = true;
+            r.mises_a_jour = (double)r.nb_pas * scenario.N * scenario.ordre;
+            r.erreur_masse = (masse_initiale > 0.0) ? (solveur.CalculerMasseTotale() - masse_initiale) / masse_initiale : 0.0;
+            r.H_max = solveur.ObtenirSurfaceMax();
+            r.x_crete = solveur.ObtenirPositionCrete();
+        }
+
+        auto fin_tache = chrono::steady_clock::now();
+        r.debut = chrono::duration<double>(debut_tache - debut).count();
+        r.duree = chrono::duration<double>(fin_tache - debut_tache).count();
+    });
+
+    double temps_total = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    cout.rdbuf(sortie);
+    cout.clear();
+
+    // Rapport par simulation
+    cout << setw(5) << "#" << "  " << left << setw(24) << "scenario" << setw(44) << "parametres" << right
+         << setw(7) << "thread" << setw(11) << "temps (s)" << setw(9) << "pas" << setw(14) << "cellules/s"
+         << setw(12) << "masse rel." << setw(10) << "H_max" << setw(9) << "crete" << endl;
+    double somme_durees = 0.0, somme_mises_a_jour = 0.0;
+    int nb_echecs = 0;
+    for (size_t j = 0; j < scenarios.size(); j++)
+    {
+        const ResultatTache& r = resultats[j];
+        cout << setw(5) << j << "  " << left << setw(24) << scenarios[j].nom << setw(44) << scenarios[j].description << right;
+        if (!r.valide)
+        {
+            cout << "  echec (scenario invalide)" << endl;
+            nb_echecs++;
+            continue;
+        }
+        cout << setw(7) << r.thread << setw(11) << fixed << setprecision(4) << r.duree << setw(9) << r.nb_pas
+             << setw(14) << scientific << setprecision(3) << r.mises_a_jour / r.duree
+             << setw(12) << setprecision(2) << r.erreur_masse
+             << setw(10) << fixed << setprecision(4) << r.H_max << setw(9) << setprecision(2) << r.x_crete << endl;
+        somme_durees += r.duree;
+        somme_mises_a_jour += r.mises_a_jour;
+    }
+
+    // Répartition statique équivalente : à tour de rôle dans l'ordre de lancement (des
+    // morceaux contigus de cet ordre, trié par coût, donneraient toutes les tâches
+    // coûteuses au premier thread)
+    double duree_statique = 0.0;
+    for (int id = 0; id < nb_threads; id++)
+    {
+        double somme = 0.0;
+        for (size_t k = id; k < ordre.size(); k += nb_threads)
+            somme += resultats[ordre[k]].duree;
+        duree_statique = max(duree_statique, somme);
+    }
+
+    cout << endl << "Temps total : " << fixed << setprecision(3) << temps_total << " s (somme des taches "
+         << somme_durees << " s, " << ordonnanceur.ObtenirNombreVols() << " vols)" << endl;
+    cout << "Debit global : " << scientific << setprecision(3) << somme_mises_a_jour / temps_total << " cellules/s" << endl;
+    cout << "Repartition statique a tour de role, meme ordre (estime) : " << fixed << setprecision(3) << duree_statique << " s" << endl;
+    if (nb_echecs > 0)
+        cout << nb_echecs << " scenario(s) invalide(s)" << endl;
+
+    // Rapport CSV
+    if (!rapport.empty())
+    {
+        ofstream csv(rapport);
+        csv << "indice,scenario,parametres,thread,debut_s,temps_s,pas,cellules_par_s,erreur_masse,H_max,x_crete\n";
+        for (size_t j = 0; j < scenarios.size(); j++)
+        {
+            const ResultatTache& r = resultats[j];
+            csv << j << "," << scenarios[j].nom << ",\"" << scenarios[j].description << "\"," << r.thread << ","
+                << r.debut << "," << r.duree << "," << r.nb_pas << ","
+                << (r.valide ? r.mises_a_jour / r.duree : 0.0) << "," << r.erreur_masse << ","
+                << r.H_max << "," << r.x_crete << "\n";
+        }
+        cout << "Rapport : " << rapport << endl;
+    }
+    return nb_echecs > 0 ? 1 : 0;
+}
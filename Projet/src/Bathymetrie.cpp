@@ -0,0 +1,270 @@
+#include "Bathymetrie.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+static const char SIGNATURE[8] = { 'S', 'V', 'P', 'R', 'O', 'F', 'I', 'L' };
+static const uint32_t VERSION_PROFIL = 1;
+static const uint32_t MARQUEUR_BOUTISME = 0x01020304;
+
+// En-tête du format binaire (48 octets, les valeurs suivent alignées sur 8 octets)
+struct EnteteProfil
+{
+    char signature[8];
+    uint32_t version;
+    uint32_t marqueur;
+    uint32_t octets_par_valeur;
+    uint32_t reserve;
+    uint64_t n;
+    double x0;
+    double pas;
+};
+
+
+ProfilFond::ProfilFond()
+    : _projection(nullptr), _taille_projection(0), _valeurs(nullptr), _octets_par_valeur(0), _x0(0.0), _pas(0.0),
+      _n(0)
+{
+}
+
+
+ProfilFond::~ProfilFond()
+{
+    Fermer();
+}
+
+
+void ProfilFond::Fermer()
+{
+    if (_projection)
+        munmap(_projection, _taille_projection);
+    _projection = nullptr;
+    _taille_projection = 0;
+    _valeurs = nullptr;
+    _x.clear();
+    _z.clear();
+    _n = 0;
+    _format.clear();
+}
+
+
+bool ProfilFond::Charger(const string& nom_fichier)
+{
+    Fermer();
+
+    ifstream fichier(nom_fichier, ios::binary);
+    if (!fichier.is_open())
+    {
+        cout << "Erreur : impossible de lire le profil '" << nom_fichier << "'" << endl;
+        return false;
+    }
+    char debut[sizeof(SIGNATURE)] = {};
+    fichier.read(debut, sizeof(debut));
+    fichier.close();
+
+    if (memcmp(debut, SIGNATURE, sizeof(SIGNATURE)) == 0)
+        return ProjeterBinaire(nom_fichier);
+    return LireTexte(nom_fichier);
+}
+
+
+bool ProfilFond::LireTexte(const string& nom_fichier)
+{
+    ifstream fichier(nom_fichier);
+    string ligne;
+    int numero = 0;
+    bool entete_possible = true;
+
+    while (getline(fichier, ligne))
+    {
+        numero++;
+        size_t diese = ligne.find('#');
+        if (diese != string::npos)
+            ligne.erase(diese);
+        replace(ligne.begin(), ligne.end(), ',', ' ');
+        replace(ligne.begin(), ligne.end(), ';', ' ');
+        replace(ligne.begin(), ligne.end(), '\t', ' ');
+        if (ligne.find_first_not_of(" \r") == string::npos)
+            continue;
+
+        istringstream flux(ligne);
+        double x, z;
+        if (!(flux >> x >> z))
+        {
+            // Seule la première ligne non vide peut être un en-tête ("x,z")
+            if (entete_possible)
+            {
+                entete_possible = false;
+                continue;
+            }
+            cout << "Erreur : " << nom_fichier << ":" << numero << " : 'x z' attendu" << endl;
+            return false;
+        }
+        entete_possible = false;
+
+        if (!_x.empty() && !(x > _x.back()))
+        {
+            cout << "Erreur : " << nom_fichier << ":" << numero << " : x doit etre strictement croissant" << endl;
+            return false;
+        }
+        _x.push_back(x);
+        _z.push_back(z);
+    }
+
+    _n = _x.size();
+    if (_n < 2)
+    {
+        cout << "Erreur : le profil '" << nom_fichier << "' doit avoir au moins deux points" << endl;
+        return false;
+    }
+    _format = "texte";
+    return true;
+}
+
+
+bool ProfilFond::ProjeterBinaire(const string& nom_fichier)
+{
+    int descripteur = open(nom_fichier.c_str(), O_RDONLY);
+    struct stat infos;
+    if (descripteur < 0 || fstat(descripteur, &infos) != 0)
+    {
+        cout << "Erreur : impossible de lire le profil '" << nom_fichier << "'" << endl;
+        if (descripteur >= 0)
+            close(descripteur);
+        return false;
+    }
+
+    size_t taille = (size_t)infos.st_size;
+    void* projection = (taille >= sizeof(EnteteProfil))
+                     ? mmap(nullptr, taille, PROT_READ, MAP_PRIVATE, descripteur, 0) : MAP_FAILED;
+    close(descripteur);  // La projection reste valide
+    if (projection == MAP_FAILED)
+    {
+        cout << "Erreur : profil binaire '" << nom_fichier << "' tronque ou impossible a projeter" << endl;
+        return false;
+    }
+    _projection = projection;
+    _taille_projection = taille;
+
+    EnteteProfil entete;
+    memcpy(&entete, projection, sizeof(entete));
+    string erreur;
+    if (entete.marqueur != MARQUEUR_BOUTISME)
+        erreur = "ecrit sur une machine d'un autre boutisme";
+    else if (entete.version != VERSION_PROFIL)
+        erreur = "version " + to_string(entete.version) + " inconnue";
+    else if (entete.octets_par_valeur != 4 && entete.octets_par_valeur != 8)
+        erreur = "taille de valeur " + to_string(entete.octets_par_valeur) + " (4 ou 8 attendu)";
+    else if (entete.n < 2 || !(entete.pas > 0.0))
+        erreur = "au moins deux points a pas positif attendus";
+    else if ((taille - sizeof(EnteteProfil)) / entete.octets_par_valeur < entete.n)
+        erreur = "tronque";
+    if (!erreur.empty())
+    {
+        cout << "Erreur : profil binaire '" << nom_fichier << "' " << erreur << endl;
+        Fermer();
+        return false;
+    }
+
+    _valeurs = static_cast<const char*>(projection) + sizeof(EnteteProfil);
+    _octets_par_valeur = (int)entete.octets_par_valeur;
+    _x0 = entete.x0;
+    _pas = entete.pas;
+    _n = (size_t)entete.n;
+    _format = "binaire";
+    return true;
+}
+
+
+void ProfilFond::Reechantillonner(int N, double dx, double x_debut, double* zb) const
+{
+    const double x_premier = X(0), x_dernier = X(_n - 1);
+    const double z_premier = Z(0), z_dernier = Z(_n - 1);
+
+    // Premier segment [X(k), X(k+1)] qui finit après le début de la grille
+    size_t k = 0;
+    if (x_debut > x_premier)
+    {
+        size_t bas = 0, haut = _n - 1;   // X(bas) < x_debut <= X(haut) ou haut = n - 1
+        while (haut - bas > 1)
+        {
+            size_t milieu = bas + (haut - bas) / 2;
+            if (X(milieu) < x_debut) bas = milieu; else haut = milieu;
+        }
+        k = bas;
+    }
+
+    for (int i = 0; i < N; i++)
+    {
+        double a = x_debut + i * dx, b = x_debut + (i + 1) * dx;
+        double integrale = 0.0;
+
+        // Prolongements constants hors du profil
+        if (a < x_premier)
+            integrale += z_premier * (min(b, x_premier) - a);
+        if (b > x_dernier)
+            integrale += z_dernier * (b - max(a, x_dernier));
+
+        // Segments qui recouvrent [a, b] : trapèzes de l'interpolation linéaire
+        while (k + 2 < _n && X(k + 1) <= a)
+            k++;
+        for (size_t j = k; j + 1 < _n && X(j) < b; j++)
+        {
+            double xj = X(j), xj1 = X(j + 1);
+            double xa = max(a, xj), xb = min(b, xj1);
+            if (!(xb > xa))
+                continue;
+            double zj = Z(j), pente = (Z(j + 1) - zj) / (xj1 - xj);
+            double za = zj + pente * (xa - xj), zb_ = zj + pente * (xb - xj);
+            integrale += 0.5 * (za + zb_) * (xb - xa);
+        }
+
+        zb[i] = integrale / (b - a);
+    }
+}
+
+
+bool EcrireProfilBinaire(const string& nom_fichier, double x0, double pas, const vector<double>& z,
+                         bool simple_precision)
+{
+    FILE* fichier = fopen(nom_fichier.c_str(), "wb");
+    if (!fichier)
+    {
+        cout << "Erreur : impossible d'ecrire '" << nom_fichier << "'" << endl;
+        return false;
+    }
+
+    EnteteProfil entete;
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.signature, SIGNATURE, sizeof(SIGNATURE));
+    entete.version = VERSION_PROFIL;
+    entete.marqueur = MARQUEUR_BOUTISME;
+    entete.octets_par_valeur = simple_precision ? 4 : 8;
+    entete.n = z.size();
+    entete.x0 = x0;
+    entete.pas = pas;
+
+    bool ok = fwrite(&entete, 1, sizeof(entete), fichier) == sizeof(entete);
+    if (simple_precision)
+    {
+        vector<float> z_float(z.begin(), z.end());
+        ok = ok && fwrite(z_float.data(), sizeof(float), z_float.size(), fichier) == z_float.size();
+    }
+    else
+        ok = ok && fwrite(z.data(), sizeof(double), z.size(), fichier) == z.size();
+    ok = (fclose(fichier) == 0) && ok;
+
+    if (!ok)
+        cout << "Erreur : ecriture incomplete de '" << nom_fichier << "'" << endl;
+    return ok;
+}
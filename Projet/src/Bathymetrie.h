@@ -0,0 +1,89 @@
+#ifndef _BATHYMETRIE_H
+#define _BATHYMETRIE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// ========================================
+// Profils de fond mesurés
+// ========================================
+// Deux formats de profil en travers (abscisse x en m, altitude z du fond en m) :
+//
+// - texte (CSV) : une ligne "x z" par point, séparés par des virgules, points-virgules,
+//   espaces ou tabulations ; lignes vides, commentaires (#) et en-tête non numérique
+//   ignorés. Les x doivent être strictement croissants.
+//
+// - binaire (transect de MNT à pas régulier), lu par projection en mémoire (mmap) :
+//     "SVPROFIL" (8 octets), uint32 version (1), uint32 marqueur 0x01020304 (ordre des octets)
+//     uint32 octets par valeur (4 : float, 8 : double), uint32 réservé (0)
+//     uint64 nombre de points n, double x du premier point, double pas entre deux points
+//     n valeurs de z
+//   Les nombres sont dans l'ordre d'octets de la machine qui a écrit le fichier ; un
+//   fichier d'une machine d'un autre boutisme est refusé. Seules les pages des points
+//   utilisés par la grille sont lues.
+//
+// Le profil est ramené sur la grille par la moyenne, sur chaque cellule, de
+// l'interpolation linéaire entre les points (exacte, pas d'échantillonnage) : un
+// profil plus fin que la grille est moyenné sans repliement, un profil plus
+// grossier est interpolé. Hors du profil, le fond est prolongé par le premier ou
+// le dernier point.
+
+// Profil lu, quel que soit le format
+class ProfilFond
+{
+private:
+    // Texte : points copiés
+    std::vector<double> _x;
+    std::vector<double> _z;
+
+    // Binaire : valeurs dans le fichier projeté
+    void* _projection;
+    size_t _taille_projection;
+    const void* _valeurs;
+    int _octets_par_valeur;
+    double _x0;
+    double _pas;
+
+    size_t _n;
+    std::string _format;
+
+    void Fermer();
+    bool LireTexte(const std::string& nom_fichier);
+    bool ProjeterBinaire(const std::string& nom_fichier);
+
+public:
+    ProfilFond();
+    ~ProfilFond();
+    ProfilFond(const ProfilFond&) = delete;
+    ProfilFond& operator=(const ProfilFond&) = delete;
+
+    // Format reconnu à la signature ; retourne false (avec un message) si le fichier
+    // est illisible, mal formé ou a moins de deux points
+    bool Charger(const std::string& nom_fichier);
+
+    size_t NombrePoints() const { return _n; }
+    const std::string& Format() const { return _format; }   // "texte" ou "binaire"
+
+    double X(size_t k) const
+    {
+        return _projection ? _x0 + (double)k * _pas : _x[k];
+    }
+    double Z(size_t k) const
+    {
+        if (!_projection)
+            return _z[k];
+        return (_octets_par_valeur == 4) ? (double)static_cast<const float*>(_valeurs)[k]
+                                         : static_cast<const double*>(_valeurs)[k];
+    }
+
+    // Fond moyen des N cellules de largeur dx, la cellule 0 commençant à l'abscisse
+    // x_debut du profil
+    void Reechantillonner(int N, double dx, double x_debut, double* zb) const;
+};
+
+// Ecrit un profil binaire à pas régulier (z en float si simple_precision)
+bool EcrireProfilBinaire(const std::string& nom_fichier, double x0, double pas, const std::vector<double>& z,
+                         bool simple_precision);
+
+#endif // _BATHYMETRIE_H
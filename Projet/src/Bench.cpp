@@ -0,0 +1,477 @@
+// ========================================
+// Micro-benchmarks des noyaux de SaintVenant1D
+// ========================================
+// Pour chaque taille N (1e3, 1e4, ... jusqu'à N_max, 1e8 par défaut, en sautant les
+// tailles qui ne tiennent pas en mémoire) et chaque fraction de cellules
+// sèches, mesure :
+//   FluxHLL, FluxRusanov       : flux d'une interface (méthodes de la classe), N-1 appels
+//   FluxHLLLot, FluxRusanovLot : mêmes flux par lots vectorisés (ceux d'Avancer)
+//   CalculerFluxPhysique       : flux physique de chaque cellule
+//   VitesseMaximale            : réduction de la condition CFL
+//   Avancer                    : un pas de temps complet (ordre 1, HLL)
+//   Sauvegarder                : écriture texte de l'état (N <= N_max_sauvegarde)
+//   SauvegarderBinaire         : même écriture en sortie .svb (voir SortieBinaire.h)
+//   Diffuser                   : publication de l'état en mémoire partagée (voir DiffusionPartagee.h)
+// La partie sèche est à droite du domaine (marche plus haute que l'eau), la partie
+// mouillée porte un soliton : les flux voient des interfaces sèches, mouillées et
+// subsoniques/supersoniques dans des proportions connues.
+//
+// Chaque mesure est répétée jusqu'à durer au moins temps_min (et au moins 3 fois) ;
+// le temps retenu est le meilleur, le médian est aussi donné. Résultats :
+//   ns par élément (interface ou cellule), éléments par seconde, et bande passante
+//   mémoire atteinte = octets par élément (trafic minimal estimé, voir NOYAUX) / temps.
+// Pour Sauvegarder, les octets sont ceux réellement écrits dans le fichier.
+//
+// Le rapport JSON (une mesure par ligne) peut être comparé à celui d'une version
+// précédente avec -r : les mesures plus lentes de plus de 10 % sont signalées et le
+// programme retourne 2.
+//
+// Usage : bench [-n N_max] [-s N_max_sauvegarde] [-t nb_threads] [-m temps_min]
+//               [-o bench.json] [-r reference.json]
+// (à compiler en Release : cmake -DCMAKE_BUILD_TYPE=Release)
+
+#include "SaintVenant.h"
+#include "FluxVectorise.h"
+#include "DiffusionPartagee.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const double G = 9.81;
+static const double CRITERE_H = 1e-4;       // critere_hauteur_deau du solveur
+static const double L_DOMAINE = 75.0;
+static const double SEUIL_REGRESSION = 0.10;
+static const char* FICHIER_SAUVEGARDE = "bench_sauvegarde.tmp";
+static const char* FICHIER_SAUVEGARDE_BINAIRE = "bench_sauvegarde.svb";
+
+// Trafic mémoire minimal par élément (chaque tableau lu ou écrit une fois par balayage)
+struct Noyau
+{
+    const char* nom;
+    const char* element;
+    double octets;
+};
+
+static const Noyau NOYAUX[] = {
+    { "FluxHLL",              "interface", 32.0 },   // lit h, hu ; écrit 2 flux
+    { "FluxRusanov",          "interface", 32.0 },
+    { "FluxHLLLot",           "interface", 32.0 },
+    { "FluxRusanovLot",       "interface", 32.0 },
+    { "CalculerFluxPhysique", "cellule",   32.0 },   // lit h, hu ; écrit F_h, F_hu
+    { "VitesseMaximale",      "cellule",   16.0 },   // lit h, hu
+    { "Sauvegarder",          "cellule",    0.0 },   // octets écrits mesurés
+    { "SauvegarderBinaire",   "cellule",   24.0 },   // lit h, hu ; écrit 2 floats
+    { "Diffuser",             "cellule",   32.0 },   // lit h, hu ; écrit 2 doubles
+    // Reconstruction (lit h, zb, fond de l'interface ; écrit 2 faces) 40 + flux (lit 2 faces et hu ;
+    // écrit 2 flux) 40 + mise à jour (lit h, hu, zb, 2 faces, 2 flux ; écrit 2) 72 + nettoyage (lit et écrit 2) 32
+    { "Avancer",              "cellule",  184.0 },
+};
+
+
+// Temps d'une répétition (s) : meilleur et médian
+struct Mesure
+{
+    int repetitions = 0;
+    double meilleur = 0.0;
+    double median = 0.0;
+};
+
+// Répète tache (qui fait nb_appels appels du noyau) jusqu'à temps_min et au moins repetitions_min fois
+static Mesure Chronometrer(const function<void()>& tache, int nb_appels, double temps_min, int repetitions_min)
+{
+    vector<double> temps;
+    double total = 0.0;
+    while ((int)temps.size() < repetitions_min || total < temps_min)
+    {
+        auto debut = chrono::steady_clock::now();
+        tache();
+        double duree = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+        temps.push_back(duree / nb_appels);
+        total += duree;
+    }
+
+    sort(temps.begin(), temps.end());
+    Mesure mesure;
+    mesure.repetitions = (int)temps.size() * nb_appels;
+    mesure.meilleur = temps[0];
+    mesure.median = temps[temps.size() / 2];
+    return mesure;
+}
+
+
+// Une ligne du rapport
+struct Resultat
+{
+    string noyau;
+    long N = 0;
+    double fraction_seche = 0.0;      // demandée
+    double fraction_mesuree = 0.0;    // cellules avec h <= critere_hauteur_deau
+    long elements = 0;
+    double octets_par_element = 0.0;
+    Mesure mesure;
+
+    double NsParElement() const { return 1e9 * mesure.meilleur / elements; }
+    double NsParElementMedian() const { return 1e9 * mesure.median / elements; }
+    double ElementsParSeconde() const { return elements / mesure.meilleur; }
+    double BandePassante() const { return octets_par_element * elements / mesure.meilleur * 1e-9; }  // Go/s
+};
+
+
+static const Noyau& TrouverNoyau(const string& nom)
+{
+    for (const Noyau& noyau : NOYAUX)
+        if (nom == noyau.nom)
+            return noyau;
+    return NOYAUX[0];
+}
+
+
+static long TailleFichier(const char* nom)
+{
+    struct stat infos;
+    return (stat(nom, &infos) == 0) ? (long)infos.st_size : 0;
+}
+
+
+// Soliton sur la partie mouillée, marche sèche à droite
+static void PreparerSolveur(SaintVenant1D& solveur, long N, double fraction_seche, const char* nom_fichier)
+{
+    // Les messages d'initialisation ne font pas partie du rapport
+    streambuf* sortie = cout.rdbuf(nullptr);
+    double L_mouille = L_DOMAINE * (1.0 - fraction_seche);
+    solveur.Initialiser((int)N, L_DOMAINE, 0.9, nom_fichier);
+    if (fraction_seche > 0.0)
+        solveur.DefinirFondMarche(L_mouille, 3.0);   // plus haut que l'eau (h0 = 2, A = 0.2)
+    else
+        solveur.DefinirFondPlat();
+    solveur.ConditionInitialeSoliton(0.2, 0.4 * L_mouille);
+    cout.rdbuf(sortie);
+}
+
+
+// Mémoire nécessaire pour une taille : tableaux du solveur (mesurés sur un petit
+// solveur préparé et avancé comme ceux du banc, tampons alloués au premier pas
+// compris), tableaux de flux du banc et, si l'état est aussi sauvegardé, second
+// solveur de la sortie binaire, sa trame (h et hu en float) et le segment de la
+// diffusion (fond et deux emplacements de h et hu)
+static double MemoireNecessaire(long N, long N_max_sauvegarde, int nb_threads)
+{
+    static double octets_par_cellule = 0.0;
+    if (octets_par_cellule == 0.0)
+    {
+        const long N_essai = 1000;
+        SaintVenant1D essai;
+        PreparerSolveur(essai, N_essai, 0.0, "");
+        essai.DefinirNombreThreads(nb_threads);
+        essai.Avancer();
+        octets_par_cellule = (double)essai.ObtenirMemoireTableaux() / N_essai;
+    }
+
+    double octets = octets_par_cellule * N + 2.0 * sizeof(double) * N;
+    if (N <= N_max_sauvegarde)
+        octets += octets_par_cellule * N + 2.0 * sizeof(float) * N + 5.0 * sizeof(double) * N;
+    return octets;
+}
+
+
+// Toutes les mesures pour une taille et une fraction sèche
+static void MesurerConfiguration(long N, double fraction_seche, long N_max_sauvegarde, int nb_threads,
+                                 double temps_min, vector<Resultat>& resultats)
+{
+    SaintVenant1D solveur;
+    PreparerSolveur(solveur, N, fraction_seche, FICHIER_SAUVEGARDE);
+    solveur.DefinirNombreThreads(nb_threads);
+
+    const double* h = solveur.ObtenirH().data();
+    const double* hu = solveur.ObtenirHu().data();
+    long nb_seches = 0;
+    for (long i = 0; i < N; i++)
+        nb_seches += (h[i] <= CRITERE_H);
+
+    vector<double> flux_h(N), flux_hu(N);
+    double* fh = flux_h.data();
+    double* fhu = flux_hu.data();
+    long nb_interfaces = N - 1;
+
+    // Au moins ~1e5 éléments par chronométrage pour que l'horloge soit négligeable
+    int nb_appels = (int)max(1L, 100000L / N);
+
+    auto Ajouter = [&](const char* nom, long elements, const Mesure& mesure, double octets_par_element)
+    {
+        Resultat r;
+        r.noyau = nom;
+        r.N = N;
+        r.fraction_seche = fraction_seche;
+        r.fraction_mesuree = (double)nb_seches / N;
+        r.elements = elements;
+        r.octets_par_element = octets_par_element;
+        r.mesure = mesure;
+        resultats.push_back(r);
+
+        cout << setw(22) << left << nom << right << setw(11) << N << setw(7) << fixed << setprecision(2) << r.fraction_mesuree
+             << setw(12) << setprecision(3) << r.NsParElement() << setw(14) << scientific << setprecision(3) << r.ElementsParSeconde()
+             << setw(10) << fixed << setprecision(2) << r.BandePassante() << setw(10) << mesure.repetitions << endl;
+    };
+
+    // Flux d'une interface : l'interface f sépare les cellules f et f+1
+    Ajouter("FluxHLL", nb_interfaces, Chronometrer([&]()
+    {
+        for (int a = 0; a < nb_appels; a++)
+            for (long f = 0; f < nb_interfaces; f++)
+                solveur.FluxHLL(h[f], hu[f], h[f + 1], hu[f + 1], fh[f], fhu[f]);
+    }, nb_appels, temps_min, 3), TrouverNoyau("FluxHLL").octets);
+
+    Ajouter("FluxRusanov", nb_interfaces, Chronometrer([&]()
+    {
+        for (int a = 0; a < nb_appels; a++)
+            for (long f = 0; f < nb_interfaces; f++)
+                solveur.FluxRusanov(h[f], hu[f], h[f + 1], hu[f + 1], fh[f], fhu[f]);
+    }, nb_appels, temps_min, 3), TrouverNoyau("FluxRusanov").octets);
+
+    Ajouter("FluxHLLLot", nb_interfaces, Chronometrer([&]()
+    {
+        for (int a = 0; a < nb_appels; a++)
+            FluxHLLLot((int)nb_interfaces, h, hu, h + 1, hu + 1, fh, fhu, G, CRITERE_H);
+    }, nb_appels, temps_min, 3), TrouverNoyau("FluxHLLLot").octets);
+
+    Ajouter("FluxRusanovLot", nb_interfaces, Chronometrer([&]()
+    {
+        for (int a = 0; a < nb_appels; a++)
+            FluxRusanovLot((int)nb_interfaces, h, hu, h + 1, hu + 1, fh, fhu, G, CRITERE_H);
+    }, nb_appels, temps_min, 3), TrouverNoyau("FluxRusanovLot").octets);
+
+    Ajouter("CalculerFluxPhysique", N, Chronometrer([&]()
+    {
+        for (int a = 0; a < nb_appels; a++)
+            for (long i = 0; i < N; i++)
+                solveur.CalculerFluxPhysique(h[i], hu[i], fh[i], fhu[i]);
+    }, nb_appels, temps_min, 3), TrouverNoyau("CalculerFluxPhysique").octets);
+
+    volatile double v_max = 0.0;
+    Ajouter("VitesseMaximale", N, Chronometrer([&]()
+    {
+        for (int a = 0; a < nb_appels; a++)
+            v_max = solveur.VitesseMaximale();
+    }, nb_appels, temps_min, 3), TrouverNoyau("VitesseMaximale").octets);
+
+    // Ecriture texte : octets réellement écrits (une écriture par sauvegarde)
+    if (N <= N_max_sauvegarde)
+    {
+        long taille_avant = TailleFichier(FICHIER_SAUVEGARDE);
+        Mesure mesure = Chronometrer([&]() { solveur.Sauvegarder(); }, 1, temps_min, 1);
+        double octets = (double)(TailleFichier(FICHIER_SAUVEGARDE) - taille_avant) / mesure.repetitions / N;
+        Ajouter("Sauvegarder", N, mesure, octets);
+
+        // Même état en sortie binaire
+        SaintVenant1D binaire;
+        PreparerSolveur(binaire, N, fraction_seche, FICHIER_SAUVEGARDE_BINAIRE);
+        Ajouter("SauvegarderBinaire", N, Chronometrer([&]() { binaire.Sauvegarder(); }, 1, temps_min, 1),
+                TrouverNoyau("SauvegarderBinaire").octets);
+
+        // Même état publié pour le suivi en direct (deux emplacements suffisent ici)
+        DiffusionPartagee diffusion;
+        if (diffusion.Ouvrir("saintvenant_bench", (int)N, solveur.ObtenirDx(), solveur.ObtenirZb().data(), 2))
+            Ajouter("Diffuser", N, Chronometrer([&]()
+            {
+                diffusion.Publier(solveur.ObtenirTemps(), solveur.ObtenirH().data(), solveur.ObtenirHu().data());
+            }, 1, temps_min, 3), TrouverNoyau("Diffuser").octets);
+    }
+
+    // En dernier : Avancer modifie l'état (et échange les tampons de h et hu)
+    solveur.Avancer();
+    Ajouter("Avancer", N, Chronometrer([&]()
+    {
+        for (int a = 0; a < nb_appels; a++)
+            solveur.Avancer();
+    }, nb_appels, temps_min, 3), TrouverNoyau("Avancer").octets);
+
+    remove(FICHIER_SAUVEGARDE);
+    remove(FICHIER_SAUVEGARDE_BINAIRE);
+}
+
+
+static void EcrireJSON(const string& nom_fichier, const vector<Resultat>& resultats, int nb_threads, double temps_min)
+{
+    ofstream json(nom_fichier);
+    if (!json.is_open())
+    {
+        cout << "Erreur : impossible d'ecrire '" << nom_fichier << "'" << endl;
+        return;
+    }
+
+    char date[32];
+    time_t maintenant = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&maintenant));
+
+    json << "{\n";
+    json << "  \"date\": \"" << date << "\",\n";
+    json << "  \"compilateur\": \"" << __VERSION__ << "\",\n";
+#ifdef NDEBUG
+    json << "  \"optimise\": true,\n";
+#else
+    json << "  \"optimise\": false,\n";
+#endif
+    json << "  \"jeu_instructions\": \"" << NomJeuInstructions() << "\",\n";
+    json << "  \"threads\": " << nb_threads << ",\n";
+    json << "  \"temps_min_s\": " << temps_min << ",\n";
+    json << "  \"mesures\": [\n";
+    json << setprecision(6);
+    for (size_t k = 0; k < resultats.size(); k++)
+    {
+        const Resultat& r = resultats[k];
+        json << "    {\"noyau\": \"" << r.noyau << "\", \"element\": \"" << TrouverNoyau(r.noyau).element
+             << "\", \"N\": " << r.N << ", \"fraction_seche\": " << r.fraction_seche
+             << ", \"fraction_seche_mesuree\": " << r.fraction_mesuree << ", \"repetitions\": " << r.mesure.repetitions
+             << ", \"ns_par_element\": " << r.NsParElement() << ", \"ns_par_element_median\": " << r.NsParElementMedian()
+             << ", \"elements_par_s\": " << r.ElementsParSeconde() << ", \"octets_par_element\": " << r.octets_par_element
+             << ", \"bande_passante_Go_s\": " << r.BandePassante() << "}"
+             << (k + 1 < resultats.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    cout << "Rapport : " << nom_fichier << endl;
+}
+
+
+// Valeur numérique de "cle": dans une ligne du rapport (0 si absente)
+static double LireValeur(const string& ligne, const string& cle)
+{
+    size_t position = ligne.find("\"" + cle + "\": ");
+    if (position == string::npos)
+        return 0.0;
+    return atof(ligne.c_str() + position + cle.size() + 4);
+}
+
+
+static string LireTexte(const string& ligne, const string& cle)
+{
+    size_t position = ligne.find("\"" + cle + "\": \"");
+    if (position == string::npos)
+        return "";
+    position += cle.size() + 5;
+    return ligne.substr(position, ligne.find('"', position) - position);
+}
+
+
+// Compare aux mesures d'un rapport précédent ; retourne le nombre de régressions
+static int Comparer(const string& nom_fichier, const vector<Resultat>& resultats)
+{
+    ifstream reference(nom_fichier);
+    if (!reference.is_open())
+    {
+        cout << "Erreur : impossible d'ouvrir '" << nom_fichier << "'" << endl;
+        return 0;
+    }
+
+    cout << endl << "Comparaison avec " << nom_fichier << " (ecarts de plus de " << (int)(100 * SEUIL_REGRESSION) << " %) :" << endl;
+    int nb_communes = 0, nb_regressions = 0;
+    double somme_log = 0.0;
+    string ligne;
+    while (getline(reference, ligne))
+    {
+        string noyau = LireTexte(ligne, "noyau");
+        if (noyau.empty())
+            continue;
+        long N = (long)LireValeur(ligne, "N");
+        double fraction = LireValeur(ligne, "fraction_seche");
+        double ns_reference = LireValeur(ligne, "ns_par_element");
+
+        for (const Resultat& r : resultats)
+        {
+            if (r.noyau != noyau || r.N != N || fabs(r.fraction_seche - fraction) > 1e-9 || ns_reference <= 0.0)
+                continue;
+            double rapport = r.NsParElement() / ns_reference;
+            somme_log += log(rapport);
+            nb_communes++;
+            if (fabs(rapport - 1.0) > SEUIL_REGRESSION)
+            {
+                bool regression = rapport > 1.0;
+                nb_regressions += regression;
+                cout << "  " << setw(22) << left << noyau << right << setw(11) << N << setw(7) << fixed << setprecision(2) << fraction
+                     << setw(12) << setprecision(3) << ns_reference << " -> " << setw(10) << r.NsParElement() << " ns  x"
+                     << setprecision(2) << rapport << (regression ? "  REGRESSION" : "  gain") << endl;
+            }
+        }
+    }
+
+    if (nb_communes > 0)
+        cout << "  " << nb_communes << " mesures communes, rapport moyen (geometrique) x" << fixed << setprecision(3)
+             << exp(somme_log / nb_communes) << ", " << nb_regressions << " regression(s)" << endl;
+    else
+        cout << "  aucune mesure commune" << endl;
+    return nb_regressions;
+}
+
+
+int main(int argc, char** argv)
+{
+    long N_max = 100000000;
+    long N_max_sauvegarde = 100000;
+    int nb_threads = 1;
+    double temps_min = 0.1;
+    string rapport = "bench.json";
+    string reference;
+    for (int k = 1; k < argc; k++)
+    {
+        if (k + 1 >= argc)
+        {
+            cout << "Usage : bench [-n N_max] [-s N_max_sauvegarde] [-t nb_threads] [-m temps_min] [-o bench.json] [-r reference.json]" << endl;
+            return 1;
+        }
+        if (strcmp(argv[k], "-n") == 0)      N_max = (long)atof(argv[++k]);
+        else if (strcmp(argv[k], "-s") == 0) N_max_sauvegarde = (long)atof(argv[++k]);
+        else if (strcmp(argv[k], "-t") == 0) nb_threads = max(1, atoi(argv[++k]));
+        else if (strcmp(argv[k], "-m") == 0) temps_min = atof(argv[++k]);
+        else if (strcmp(argv[k], "-o") == 0) rapport = argv[++k];
+        else if (strcmp(argv[k], "-r") == 0) reference = argv[++k];
+        else
+        {
+            cout << "Erreur : option inconnue '" << argv[k] << "'" << endl;
+            return 1;
+        }
+    }
+
+#ifndef NDEBUG
+    cout << "Attention : compilation sans optimisation (utiliser -DCMAKE_BUILD_TYPE=Release)" << endl;
+#endif
+
+    const double fractions_seches[] = { 0.0, 0.5, 0.9 };
+    double memoire = (double)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+
+    cout << "Noyaux de SaintVenant1D : jeu d'instructions " << NomJeuInstructions() << ", " << nb_threads << " thread(s)" << endl;
+    cout << setw(22) << left << "noyau" << right << setw(11) << "N" << setw(7) << "sec" << setw(12) << "ns/elem"
+         << setw(14) << "elements/s" << setw(10) << "Go/s" << setw(10) << "repet." << endl;
+
+    vector<Resultat> resultats;
+    for (long N = 1000; N <= N_max; N *= 10)
+    {
+        // Les grandes tailles ne tiennent pas toujours en mémoire
+        double necessaire = MemoireNecessaire(N, N_max_sauvegarde, nb_threads);
+        if (necessaire > 0.8 * memoire)
+        {
+            cout << "N = " << N << " ignore : " << fixed << setprecision(1) << necessaire * 1e-9
+                 << " Go necessaires, " << memoire * 1e-9 << " Go de memoire" << endl;
+            continue;
+        }
+        for (double fraction_seche : fractions_seches)
+            MesurerConfiguration(N, fraction_seche, N_max_sauvegarde, nb_threads, temps_min, resultats);
+    }
+
+    EcrireJSON(rapport, resultats, nb_threads, temps_min);
+    if (!reference.empty() && Comparer(reference, resultats) > 0)
+        return 2;
+    return 0;
+}
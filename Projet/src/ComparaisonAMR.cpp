@@ -0,0 +1,114 @@
+// ========================================
+// Comparaison grille uniforme fine / raffinement adaptatif (AMR)
+// ========================================
+// Soliton sur plage puis plateau (cas D de main.cpp) : la grille la plus fine
+// de l'AMR est comparée à une grille uniforme de même résolution.
+// Affiche le nombre moyen de cellules, le temps de calcul, la surface max,
+// la position de la crête et la variation de masse de chaque calcul.
+//
+// Usage : comparaison_amr [N_base] [niveau_max] [taille_bloc] [t_final]
+// (à compiler en Release pour des temps représentatifs)
+
+#include "SaintVenant.h"
+#include "AMR.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+// Les messages d'initialisation ne font pas partie du rapport
+struct Silence
+{
+    streambuf* _sortie;
+    Silence() : _sortie(cout.rdbuf(nullptr)) {}
+    ~Silence() { cout.rdbuf(_sortie); }
+};
+
+
+static void ConfigurerCas(SaintVenant1D& solveur, int N)
+{
+    solveur.Initialiser(N, 75.0, 0.9, "");
+    solveur.DefinirFondPentePuisPlat(35, 50, 2);
+    solveur.ConditionInitialeSoliton(0.2, 20);
+}
+
+
+static void AfficherLigne(const string& nom, double cellules, double temps, double surface, double crete, double d_masse)
+{
+    cout << setw(16) << nom << setw(12) << fixed << setprecision(0) << cellules
+         << setw(12) << setprecision(4) << temps << setw(14) << setprecision(5) << surface
+         << setw(12) << setprecision(3) << crete << setw(16) << scientific << setprecision(3) << d_masse << endl;
+}
+
+
+int main(int argc, char** argv)
+{
+    int N_base = (argc > 1) ? atoi(argv[1]) : 275;
+    int niveau_max = (argc > 2) ? atoi(argv[2]) : 3;
+    int taille_bloc = (argc > 3) ? atoi(argv[3]) : 8;
+    double t_final = (argc > 4) ? atof(argv[4]) : 6.0;
+    int N_fin = N_base << niveau_max;
+
+    cout << "Comparaison uniforme / AMR : N_base = " << N_base << ", niveau max = " << niveau_max
+         << " (N fin = " << N_fin << "), blocs de " << taille_bloc << ", t = " << t_final << " s" << endl;
+    cout << setw(16) << "grille" << setw(12) << "cellules" << setw(12) << "temps (s)" << setw(14) << "surface max"
+         << setw(12) << "crete (m)" << setw(16) << "masse (var.)" << endl;
+
+    // 1. Grille uniforme fine
+    SaintVenant1D fin;
+    {
+        Silence silence;
+        ConfigurerCas(fin, N_fin);
+    }
+    double masse_fin = fin.CalculerMasseTotale();
+    auto debut = chrono::steady_clock::now();
+    while (fin.ObtenirTemps() < t_final)
+        fin.Avancer();
+    double temps_fin = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    AfficherLigne("uniforme fine", N_fin, temps_fin, fin.ObtenirSurfaceMax(), fin.ObtenirPositionCrete(),
+                  fin.CalculerMasseTotale() - masse_fin);
+
+    // 2. AMR, initialisée depuis la même condition initiale sur la grille fine
+    SaintVenantAMR amr;
+    {
+        Silence silence;
+        SaintVenant1D reference;
+        ConfigurerCas(reference, N_fin);
+        if (!amr.Initialiser(reference, N_base, niveau_max, taille_bloc, 0.9, ""))
+            return 1;
+    }
+    double masse_amr = amr.CalculerMasseTotale();
+    double somme_cellules = 0.0;
+    int nb_pas = 0;
+    debut = chrono::steady_clock::now();
+    while (amr.ObtenirTemps() < t_final)
+    {
+        amr.Avancer();
+        somme_cellules += amr.ObtenirNombreCellules();
+        nb_pas++;
+    }
+    double temps_amr = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    AfficherLigne("AMR", somme_cellules / max(1, nb_pas), temps_amr, amr.ObtenirSurfaceMax(), amr.ObtenirPositionCrete(),
+                  amr.CalculerMasseTotale() - masse_amr);
+
+    // 3. Grille uniforme de base (résolution de la zone grossière de l'AMR)
+    SaintVenant1D base;
+    {
+        Silence silence;
+        ConfigurerCas(base, N_base);
+    }
+    double masse_base = base.CalculerMasseTotale();
+    debut = chrono::steady_clock::now();
+    while (base.ObtenirTemps() < t_final)
+        base.Avancer();
+    double temps_base = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    AfficherLigne("uniforme base", N_base, temps_base, base.ObtenirSurfaceMax(), base.ObtenirPositionCrete(),
+                  base.CalculerMasseTotale() - masse_base);
+
+    cout << fixed << setprecision(1) << "  -> AMR : " << (double)N_fin / (somme_cellules / max(1, nb_pas))
+         << "x moins de cellules, " << temps_fin / temps_amr << "x plus rapide que la grille fine" << endl;
+    return 0;
+}
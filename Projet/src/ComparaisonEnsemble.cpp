@@ -0,0 +1,120 @@
+// ========================================
+// Ensemble de solitons : membres entrelacés contre solveurs séparés
+// ========================================
+// K variantes (amplitude, position de départ) du soliton sur la double pente
+// (cas E de main.cpp). Référence : K SaintVenant1D calculés l'un après l'autre,
+// chacun reconstruisant son fond, comme K processus séparés. Compare le temps
+// de calcul et vérifie que chaque membre est identique bit à bit à son solveur
+// seul après le même nombre de pas. Puis avance l'ensemble jusqu'à t_final
+// (chaque membre avec son propre pas) et écrit les diagnostics de chaque membre
+// dans diagnostics_ensemble.txt.
+//
+// Usage : ensemble [N] [K] [nb_pas] [t_final]
+// (à compiler en Release pour des temps représentatifs)
+
+#include "SaintVenant.h"
+#include "Ensemble.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+static void Preparer(SaintVenant1D& solveur, int N)
+{
+    streambuf* sortie = cout.rdbuf(nullptr);
+    solveur.Initialiser(N, 75.0, 0.9, "");
+    solveur.DefinirFondDoublePente(15, 30, 1.8, 2.2);
+    cout.rdbuf(sortie);
+}
+
+
+// Variante k : amplitude de 0.1 à 0.5 m, départ entre 8 et 12 m
+static double Amplitude(int k, int K) { return 0.1 + 0.4 * k / max(1, K - 1); }
+static double Depart(int k) { return 8.0 + (k % 5); }
+
+
+int main(int argc, char** argv)
+{
+    int N = (argc > 1) ? atoi(argv[1]) : 1000;
+    int K = (argc > 2) ? atoi(argv[2]) : 16;
+    int nb_pas = (argc > 3) ? atoi(argv[3]) : 2000;
+    double t_final = (argc > 4) ? atof(argv[4]) : 6.0;
+
+    cout << "Ensemble de " << K << " solitons, double pente, N = " << N << ", " << nb_pas << " pas" << endl;
+
+    // 1. K solveurs séparés
+    vector<vector<double> > h_separes(K);
+    auto debut = chrono::steady_clock::now();
+    for (int k = 0; k < K; k++)
+    {
+        SaintVenant1D solveur;
+        Preparer(solveur, N);
+        streambuf* sortie = cout.rdbuf(nullptr);
+        solveur.ConditionInitialeSoliton(Amplitude(k, K), Depart(k));
+        cout.rdbuf(sortie);
+        for (int n = 0; n < nb_pas; n++)
+            solveur.Avancer();
+        h_separes[k] = solveur.ObtenirH();
+    }
+    double temps_separes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    // 2. Ensemble
+    debut = chrono::steady_clock::now();
+    SaintVenant1D reference;
+    Preparer(reference, N);
+    SaintVenantEnsemble ensemble;
+    streambuf* sortie = cout.rdbuf(nullptr);
+    ensemble.Initialiser(reference, K, 0.9, "diagnostics_ensemble.txt");
+    cout.rdbuf(sortie);
+    for (int k = 0; k < K; k++)
+        ensemble.ConditionInitialeSoliton(k, Amplitude(k, K), Depart(k));
+    for (int n = 0; n < nb_pas; n++)
+        ensemble.Avancer();
+    double temps_ensemble = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    double ecart = 0.0;
+    for (int k = 0; k < K; k++)
+    {
+        vector<double> h = ensemble.ObtenirH(k);
+        for (int i = 0; i < N; i++)
+            ecart = max(ecart, fabs(h[i] - h_separes[k][i]));
+    }
+
+    double mises_a_jour = (double)N * K * nb_pas;
+    cout << setw(12) << "" << setw(12) << "temps (s)" << setw(18) << "cellules / s" << endl;
+    cout << setw(12) << "separes" << setw(12) << fixed << setprecision(4) << temps_separes
+         << setw(18) << scientific << setprecision(3) << mises_a_jour / temps_separes << endl;
+    cout << setw(12) << "ensemble" << setw(12) << fixed << setprecision(4) << temps_ensemble
+         << setw(18) << scientific << setprecision(3) << mises_a_jour / temps_ensemble << endl;
+    cout << "Acceleration : " << fixed << setprecision(2) << temps_separes / temps_ensemble
+         << ", ecart max sur h : " << scientific << setprecision(3) << ecart << endl;
+
+    // 3. Tous les membres jusqu'à t_final, chacun avec son pas de temps
+    SaintVenantEnsemble final;
+    sortie = cout.rdbuf(nullptr);
+    final.Initialiser(reference, K, 0.9, "diagnostics_ensemble.txt");
+    cout.rdbuf(sortie);
+    for (int k = 0; k < K; k++)
+        final.ConditionInitialeSoliton(k, Amplitude(k, K), Depart(k));
+    final.EcrireDiagnostics();
+    int nb_pas_final = final.AvancerJusqua(t_final);
+    final.EcrireDiagnostics();
+
+    cout << endl << "Jusqu'a t = " << fixed << setprecision(2) << t_final << " s (" << nb_pas_final << " pas) :" << endl;
+    cout << setw(8) << "membre" << setw(10) << "A (m)" << setw(10) << "x0 (m)" << setw(12) << "dt (s)"
+         << setw(16) << "masse (m2)" << setw(12) << "H_max (m)" << setw(12) << "crete (m)" << endl;
+    vector<SaintVenantEnsemble::DiagnosticMembre> diagnostics = final.CalculerDiagnostics();
+    for (int k = 0; k < K; k++)
+    {
+        const SaintVenantEnsemble::DiagnosticMembre& d = diagnostics[k];
+        cout << setw(8) << k << setw(10) << fixed << setprecision(3) << Amplitude(k, K)
+             << setw(10) << setprecision(1) << Depart(k) << setw(12) << scientific << setprecision(3) << d.dt
+             << setw(16) << fixed << setprecision(6) << d.masse << setw(12) << setprecision(4) << d.H_max
+             << setw(12) << setprecision(3) << d.x_crete << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,233 @@
+// ========================================
+// Taux de compression des sorties .svz
+// ========================================
+// Soliton qui monte sur une pente puis un plateau (bord mouillé/sec), sauvegardé tous
+// les k pas en sortie binaire .svb (référence de taille) et en sortie compressée .svz
+// sans perte et avec plusieurs tolérances sur h et u. Pour chaque sortie : taille,
+// taux de compression par rapport à .svb, coût d'écriture et de lecture par cellule et
+// par trame, et erreur maximale relue par rapport à l'état du solveur (le calcul est
+// refait à l'identique pendant la relecture). Verdict : erreur sous la tolérance, ou
+// état identique au float pour les sorties sans perte.
+//
+// Usage : compression_sorties [N] [t_final] [pas_entre_sauvegardes]
+// (à compiler en Release pour des temps représentatifs)
+
+#include "SaintVenant.h"
+#include "SortieBinaire.h"
+#include "SortieCompressee.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <memory>
+#include <sys/stat.h>
+
+using namespace std;
+
+static const char* FICHIER_BINAIRE = "compression_reference.svb";
+static const double CRITERE_H = 1e-4;       // critere_hauteur_deau du solveur
+
+struct Tolerances
+{
+    double h;
+    double u;
+};
+
+static const Tolerances TOLERANCES[] = {
+    { 0.0, 0.0 }, { 1e-6, 1e-5 }, { 1e-5, 1e-4 }, { 1e-4, 1e-3 }, { 1e-3, 1e-2 },
+};
+static const int NB_SORTIES = sizeof(TOLERANCES) / sizeof(TOLERANCES[0]);
+
+
+// Les messages d'initialisation du solveur ne font pas partie du rapport
+struct Silence
+{
+    streambuf* _sortie;
+    Silence() : _sortie(cout.rdbuf(nullptr)) {}
+    ~Silence() { cout.rdbuf(_sortie); }
+};
+
+
+static void PreparerCas(SaintVenant1D& solveur, int N)
+{
+    Silence silence;
+    solveur.Initialiser(N, 75.0, 0.9, "");
+    solveur.DefinirFondPentePuisPlat(35.0, 50.0, 2.0);
+    solveur.ConditionInitialeSoliton(0.2, 20.0);
+}
+
+
+static string NomSortie(int k)
+{
+    return "compression_" + to_string(k) + ".svz";
+}
+
+
+static long TailleFichier(const string& nom)
+{
+    struct stat infos;
+    return (stat(nom.c_str(), &infos) == 0) ? (long)infos.st_size : 0;
+}
+
+
+static double Secondes(chrono::steady_clock::time_point debut)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+}
+
+
+int main(int argc, char** argv)
+{
+    int N = (argc > 1) ? atoi(argv[1]) : 20000;
+    double t_final = (argc > 2) ? atof(argv[2]) : 8.0;
+    int pas_entre_sauvegardes = (argc > 3) ? atoi(argv[3]) : 20;
+    if (N < 100 || !(t_final > 0.0) || pas_entre_sauvegardes < 1)
+    {
+        cout << "Erreur : N >= 100, t_final > 0 et pas_entre_sauvegardes >= 1 attendus" << endl;
+        return 1;
+    }
+
+    // ========================================
+    // 1. Ecriture
+    // ========================================
+    SaintVenant1D solveur;
+    PreparerCas(solveur, N);
+    const double critere_h = CRITERE_H;
+    const double dx = solveur.ObtenirDx();
+
+    SortieBinaire binaire;
+    vector<unique_ptr<SortieCompressee> > sorties;
+    binaire.Ouvrir(FICHIER_BINAIRE);
+    for (int k = 0; k < NB_SORTIES; k++)
+    {
+        sorties.emplace_back(new SortieCompressee());
+        if (!sorties[k]->Ouvrir(NomSortie(k)))
+            return 1;
+        sorties[k]->DefinirTolerances(TOLERANCES[k].h, TOLERANCES[k].u, 100);
+    }
+
+    double temps_binaire = 0.0;
+    vector<double> temps_ecriture(NB_SORTIES, 0.0);
+    long nb_trames = 0, pas = 0;
+    for (;;)
+    {
+        if (pas % pas_entre_sauvegardes == 0)
+        {
+            const double* h = solveur.ObtenirH().data();
+            const double* hu = solveur.ObtenirHu().data();
+            const double* zb = solveur.ObtenirZb().data();
+            auto debut = chrono::steady_clock::now();
+            binaire.EcrireTrame(solveur.ObtenirTemps(), N, dx, zb, h, hu);
+            temps_binaire += Secondes(debut);
+            for (int k = 0; k < NB_SORTIES; k++)
+            {
+                debut = chrono::steady_clock::now();
+                sorties[k]->EcrireTrame(solveur.ObtenirTemps(), N, dx, zb, h, hu, critere_h);
+                temps_ecriture[k] += Secondes(debut);
+            }
+            nb_trames++;
+        }
+        if (solveur.ObtenirTemps() >= t_final)
+            break;
+        solveur.Avancer();
+        pas++;
+    }
+    binaire.Fermer();
+    vector<double> taux(NB_SORTIES);
+    for (int k = 0; k < NB_SORTIES; k++)
+    {
+        taux[k] = sorties[k]->TauxCompression();
+        sorties[k]->Fermer();
+    }
+
+    // ========================================
+    // 2. Relecture, comparée au même calcul refait
+    // ========================================
+    SaintVenant1D relecture;
+    PreparerCas(relecture, N);
+    vector<unique_ptr<LecteurCompresse> > lecteurs;
+    for (int k = 0; k < NB_SORTIES; k++)
+    {
+        lecteurs.emplace_back(new LecteurCompresse());
+        if (!lecteurs[k]->Ouvrir(NomSortie(k)))
+            return 1;
+    }
+
+    vector<double> temps_lecture(NB_SORTIES, 0.0), erreur_h(NB_SORTIES, 0.0), erreur_u(NB_SORTIES, 0.0);
+    vector<bool> identique_float(NB_SORTIES, true), complet(NB_SORTIES, true);
+    vector<double> h_lu, u_lu;
+    for (long trame = 0; trame < nb_trames; trame++)
+    {
+        for (long p = 0; trame > 0 && p < pas_entre_sauvegardes; p++)
+            relecture.Avancer();
+        const vector<double>& h = relecture.ObtenirH();
+        const vector<double>& hu = relecture.ObtenirHu();
+
+        for (int k = 0; k < NB_SORTIES; k++)
+        {
+            double t;
+            auto debut = chrono::steady_clock::now();
+            bool lue = lecteurs[k]->LireTrame(t, h_lu, u_lu);
+            temps_lecture[k] += Secondes(debut);
+            if (!lue || t != relecture.ObtenirTemps())
+            {
+                complet[k] = false;
+                continue;
+            }
+            for (int i = 0; i < N; i++)
+            {
+                double u = (h[i] > critere_h) ? hu[i] / h[i] : 0.0;
+                erreur_h[k] = max(erreur_h[k], fabs(h_lu[i] - h[i]));
+                erreur_u[k] = max(erreur_u[k], fabs(u_lu[i] - u));
+                identique_float[k] = identique_float[k] && h_lu[i] == (double)(float)h[i] && u_lu[i] == (double)(float)u;
+            }
+        }
+    }
+
+    // ========================================
+    // Rapport
+    // ========================================
+    long taille_binaire = TailleFichier(FICHIER_BINAIRE);
+    double cellules_trames = (double)N * nb_trames;
+    cout << "Sorties compressées .svz : soliton sur pente et plateau, N = " << N << ", t = 0 a " << t_final
+         << " s, " << nb_trames << " trames (une tous les " << pas_entre_sauvegardes << " pas)" << endl;
+    cout << "Référence .svb : " << taille_binaire << " octets, écriture "
+         << fixed << setprecision(2) << 1e9 * temps_binaire / cellules_trames << " ns/cellule" << endl << endl;
+
+    cout << setw(10) << "tol h" << setw(10) << "tol u" << setw(12) << "octets" << setw(9) << "taux"
+         << setw(11) << "ecriture" << setw(10) << "lecture" << setw(12) << "erreur h" << setw(12) << "erreur u"
+         << setw(9) << "verdict" << endl;
+    cout << setw(10) << "(m)" << setw(10) << "(m/s)" << setw(12) << "" << setw(9) << "(x)"
+         << setw(11) << "(ns/cel)" << setw(10) << "(ns/cel)" << endl;
+
+    bool tout_bon = true;
+    for (int k = 0; k < NB_SORTIES; k++)
+    {
+        bool sans_perte = TOLERANCES[k].h == 0.0 && TOLERANCES[k].u == 0.0;
+        bool bon = complet[k] && (sans_perte ? identique_float[k]
+                                             : erreur_h[k] <= TOLERANCES[k].h * (1.0 + 1e-9)
+                                               && erreur_u[k] <= TOLERANCES[k].u * (1.0 + 1e-9));
+        tout_bon = tout_bon && bon;
+
+        if (sans_perte)
+            cout << setw(20) << "sans perte (float)";
+        else
+            cout << scientific << setprecision(0) << setw(10) << TOLERANCES[k].h << setw(10) << TOLERANCES[k].u;
+        cout << setw(12) << TailleFichier(NomSortie(k))
+             << fixed << setprecision(1) << setw(9) << taux[k]
+             << setprecision(2) << setw(11) << 1e9 * temps_ecriture[k] / cellules_trames
+             << setw(10) << 1e9 * temps_lecture[k] / cellules_trames
+             << scientific << setprecision(2) << setw(12) << erreur_h[k] << setw(12) << erreur_u[k]
+             << setw(9) << (bon ? "ok" : "NON") << defaultfloat << endl;
+    }
+    cout << endl << "(taux = taille .svb / taille .svz ; sans perte : relu identique à l'état arrondi en float)" << endl;
+
+    remove(FICHIER_BINAIRE);
+    for (int k = 0; k < NB_SORTIES; k++)
+        remove(NomSortie(k).c_str());
+    return tout_bon ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+#include "DiffusionPartagee.h"
+#include <iostream>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+static const char SIGNATURE[8] = { 'S', 'V', 'D', 'I', 'F', 'F', 'U', 'S' };
+static const uint32_t VERSION_DIFFUSION = 1;
+static const uint32_t MARQUEUR_BOUTISME = 0x01020304;
+static const size_t LIGNE_CACHE = 64;
+// Essais de LireDerniere avant d'abandonner (l'écrivain réécrit l'emplacement lu)
+static const int NB_ESSAIS_LECTURE = 100;
+
+static_assert(atomic<uint64_t>::is_always_lock_free, "atomique 64 bits sans verrou nécessaire en mémoire partagée");
+static_assert(sizeof(atomic<uint64_t>) == sizeof(uint64_t), "atomique 64 bits de la taille d'un uint64");
+
+// En-tête du segment (128 octets)
+struct EnteteDiffusion
+{
+    char signature[8];
+    uint32_t version;
+    uint32_t marqueur;
+    uint64_t N;
+    double dx;
+    uint32_t nb_emplacements;
+    atomic<uint32_t> termine;
+    uint64_t taille_emplacement;
+    uint64_t debut_emplacements;
+    uint64_t reserve;
+    alignas(64) atomic<uint64_t> derniere;
+    char reserve2[56];
+};
+static_assert(sizeof(EnteteDiffusion) == 128, "en-tête de 128 octets");
+
+// En-tête d'un emplacement (64 octets), suivi de h puis hu
+struct EnteteEmplacement
+{
+    atomic<uint64_t> sequence;
+    double t;
+    uint64_t numero;
+    char reserve[40];
+};
+static_assert(sizeof(EnteteEmplacement) == 64, "emplacement aligné sur 64 octets");
+
+
+static size_t ArrondirLigne(size_t octets)
+{
+    return (octets + LIGNE_CACHE - 1) / LIGNE_CACHE * LIGNE_CACHE;
+}
+
+
+static size_t TailleEmplacement(int N)
+{
+    return ArrondirLigne(sizeof(EnteteEmplacement) + 2 * (size_t)N * sizeof(double));
+}
+
+
+static size_t DebutEmplacements(int N)
+{
+    return ArrondirLigne(sizeof(EnteteDiffusion) + (size_t)N * sizeof(double));
+}
+
+
+string NomSegmentPartage(const string& nom)
+{
+    return (!nom.empty() && nom[0] == '/') ? nom : "/" + nom;
+}
+
+
+// ========================================
+// Ecrivain
+// ========================================
+DiffusionPartagee::DiffusionPartagee()
+    : _memoire(nullptr), _taille(0), _N(0), _nb_emplacements(0), _nb_trames(0)
+{
+}
+
+
+DiffusionPartagee::~DiffusionPartagee()
+{
+    Fermer();
+}
+
+
+bool DiffusionPartagee::Ouvrir(const string& nom, int N, double dx, const double* zb, int nb_emplacements)
+{
+    Fermer();
+    if (N <= 0 || nb_emplacements < 2)
+    {
+        cout << "Erreur : diffusion '" << nom << "' : N > 0 et au moins 2 emplacements attendus" << endl;
+        return false;
+    }
+    _nom = NomSegmentPartage(nom);
+    _N = N;
+    _nb_emplacements = nb_emplacements;
+    _nb_trames = 0;
+    _taille = DebutEmplacements(N) + (size_t)nb_emplacements * TailleEmplacement(N);
+
+    // Segment neuf : les lecteurs d'une diffusion précédente gardent l'ancien
+    shm_unlink(_nom.c_str());
+    int descripteur = shm_open(_nom.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (descripteur < 0)
+    {
+        cout << "Erreur : impossible de creer la memoire partagee '" << _nom << "' (" << strerror(errno) << ")" << endl;
+        return false;
+    }
+    bool ok = ftruncate(descripteur, (off_t)_taille) == 0;
+    if (ok)
+    {
+        _memoire = mmap(nullptr, _taille, PROT_READ | PROT_WRITE, MAP_SHARED, descripteur, 0);
+        ok = _memoire != MAP_FAILED;
+    }
+    int erreur = errno;
+    close(descripteur);
+    if (!ok)
+    {
+        cout << "Erreur : memoire partagee '" << _nom << "' de " << _taille << " octets impossible ("
+             << strerror(erreur) << ")" << endl;
+        _memoire = nullptr;
+        shm_unlink(_nom.c_str());
+        return false;
+    }
+
+    // Segment mis à zéro par ftruncate : séquences et dernière trame à 0
+    EnteteDiffusion* entete = new (_memoire) EnteteDiffusion();
+    memcpy(entete->signature, SIGNATURE, sizeof(SIGNATURE));
+    entete->version = VERSION_DIFFUSION;
+    entete->marqueur = MARQUEUR_BOUTISME;
+    entete->N = (uint64_t)N;
+    entete->dx = dx;
+    entete->nb_emplacements = (uint32_t)nb_emplacements;
+    entete->taille_emplacement = TailleEmplacement(N);
+    entete->debut_emplacements = DebutEmplacements(N);
+    memcpy((char*)_memoire + sizeof(EnteteDiffusion), zb, (size_t)N * sizeof(double));
+    for (int k = 0; k < nb_emplacements; k++)
+        new ((char*)_memoire + DebutEmplacements(N) + (size_t)k * TailleEmplacement(N)) EnteteEmplacement();
+    atomic_thread_fence(memory_order_release);
+    return true;
+}
+
+
+void DiffusionPartagee::Publier(double t, const double* h, const double* hu)
+{
+    if (_memoire == nullptr)
+        return;
+    EnteteDiffusion* entete = (EnteteDiffusion*)_memoire;
+    uint64_t numero = ++_nb_trames;
+    char* emplacement = (char*)_memoire + DebutEmplacements(_N)
+                      + (size_t)((numero - 1) % _nb_emplacements) * TailleEmplacement(_N);
+    EnteteEmplacement* tete = (EnteteEmplacement*)emplacement;
+    double* donnees = (double*)(emplacement + sizeof(EnteteEmplacement));
+
+    // Séquence impaire (écriture en cours) visible avant les données
+    tete->sequence.store(2 * numero - 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    tete->t = t;
+    tete->numero = numero;
+    memcpy(donnees, h, (size_t)_N * sizeof(double));
+    memcpy(donnees + _N, hu, (size_t)_N * sizeof(double));
+    tete->sequence.store(2 * numero, memory_order_release);
+    entete->derniere.store(numero, memory_order_release);
+}
+
+
+void DiffusionPartagee::Fermer()
+{
+    if (_memoire == nullptr)
+        return;
+    ((EnteteDiffusion*)_memoire)->termine.store(1, memory_order_release);
+    munmap(_memoire, _taille);
+    shm_unlink(_nom.c_str());
+    _memoire = nullptr;
+}
+
+
+// ========================================
+// Lecteur
+// ========================================
+LecteurDiffusion::LecteurDiffusion() : _memoire(nullptr), _taille(0), _N(0), _dx(0.0), _nb_emplacements(0)
+{
+}
+
+
+LecteurDiffusion::~LecteurDiffusion()
+{
+    Fermer();
+}
+
+
+bool LecteurDiffusion::Ouvrir(const string& nom)
+{
+    Fermer();
+    string nom_segment = NomSegmentPartage(nom);
+    int descripteur = shm_open(nom_segment.c_str(), O_RDONLY, 0);
+    if (descripteur < 0)
+    {
+        cout << "Erreur : pas de diffusion '" << nom_segment << "' (" << strerror(errno) << ")" << endl;
+        return false;
+    }
+    struct stat infos;
+    bool ok = fstat(descripteur, &infos) == 0 && (size_t)infos.st_size >= sizeof(EnteteDiffusion);
+    void* memoire = MAP_FAILED;
+    if (ok)
+        memoire = mmap(nullptr, (size_t)infos.st_size, PROT_READ, MAP_SHARED, descripteur, 0);
+    close(descripteur);
+    if (memoire == MAP_FAILED)
+    {
+        cout << "Erreur : diffusion '" << nom_segment << "' illisible" << endl;
+        return false;
+    }
+    _memoire = memoire;
+    _taille = (size_t)infos.st_size;
+
+    const EnteteDiffusion* entete = (const EnteteDiffusion*)_memoire;
+    if (memcmp(entete->signature, SIGNATURE, sizeof(SIGNATURE)) != 0 || entete->marqueur != MARQUEUR_BOUTISME
+        || entete->version != VERSION_DIFFUSION || entete->nb_emplacements < 2
+        || entete->taille_emplacement != TailleEmplacement((int)entete->N)
+        || entete->debut_emplacements != DebutEmplacements((int)entete->N)
+        || _taille < entete->debut_emplacements + entete->nb_emplacements * entete->taille_emplacement)
+    {
+        cout << "Erreur : '" << nom_segment << "' n'est pas une diffusion Saint-Venant (version "
+             << VERSION_DIFFUSION << ")" << endl;
+        Fermer();
+        return false;
+    }
+    _N = (int)entete->N;
+    _dx = entete->dx;
+    _nb_emplacements = (int)entete->nb_emplacements;
+    return true;
+}
+
+
+void LecteurDiffusion::Fermer()
+{
+    if (_memoire != nullptr)
+        munmap((void*)_memoire, _taille);
+    _memoire = nullptr;
+}
+
+
+bool LecteurDiffusion::LireDerniere(uint64_t& numero, double& t, vector<double>& h, vector<double>& hu) const
+{
+    if (_memoire == nullptr)
+        return false;
+    const EnteteDiffusion* entete = (const EnteteDiffusion*)_memoire;
+    h.resize(_N);
+    hu.resize(_N);
+
+    for (int essai = 0; essai < NB_ESSAIS_LECTURE; essai++)
+    {
+        uint64_t k = entete->derniere.load(memory_order_acquire);
+        if (k == 0)
+            return false;
+        const char* emplacement = (const char*)_memoire + DebutEmplacements(_N)
+                                + (size_t)((k - 1) % _nb_emplacements) * TailleEmplacement(_N);
+        const EnteteEmplacement* tete = (const EnteteEmplacement*)emplacement;
+        const double* donnees = (const double*)(emplacement + sizeof(EnteteEmplacement));
+
+        uint64_t s1 = tete->sequence.load(memory_order_acquire);
+        if (s1 != 2 * k)
+            continue;   // Déjà réécrit par une trame plus récente
+        double t_lu = tete->t;
+        memcpy(h.data(), donnees, (size_t)_N * sizeof(double));
+        memcpy(hu.data(), donnees + _N, (size_t)_N * sizeof(double));
+        atomic_thread_fence(memory_order_acquire);
+        if (tete->sequence.load(memory_order_relaxed) != s1)
+            continue;
+
+        numero = k;
+        t = t_lu;
+        return true;
+    }
+    return false;
+}
+
+
+bool LecteurDiffusion::Termine() const
+{
+    return _memoire != nullptr && ((const EnteteDiffusion*)_memoire)->termine.load(memory_order_acquire) != 0;
+}
+
+
+const double* LecteurDiffusion::ObtenirZb() const
+{
+    return (_memoire != nullptr) ? (const double*)((const char*)_memoire + sizeof(EnteteDiffusion)) : nullptr;
+}
@@ -0,0 +1,99 @@
+#ifndef _DIFFUSION_PARTAGEE_H
+#define _DIFFUSION_PARTAGEE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// ========================================
+// Diffusion des trames en mémoire partagée (suivi en direct d'un calcul)
+// ========================================
+// Le calcul publie h et hu dans un anneau de nb_emplacements trames d'un segment de
+// mémoire partagée POSIX (shm_open, /dev/shm/<nom> sous Linux). Un seul écrivain,
+// un nombre quelconque de lecteurs, sans verrou : les lecteurs ne laissent aucune
+// trace dans le segment, l'écrivain n'attend jamais personne et ne touche pas au
+// disque. Chaque emplacement est protégé par un numéro de séquence (seqlock) :
+//   écriture de la trame k : séquence = 2k - 1 (impaire : en cours), données,
+//                            séquence = 2k, puis dernière trame = k ;
+//   lecture : dernière trame k, séquence s1 = 2k, copie, séquence s2 ; la copie est
+//             valide si s2 = s1 (sinon l'emplacement a été réécrit : on recommence).
+// Un lecteur qui lit plus lentement que le calcul ne publie saute simplement des
+// trames ; il ne voit jamais une trame à moitié écrite.
+//
+// Format (version 1), nombres dans l'ordre d'octets de la machine :
+//   en-tête de 128 octets :
+//     "SVDIFFUS" (8 octets), uint32 version, uint32 marqueur 0x01020304
+//     uint64 N, double dx, uint32 nb_emplacements, uint32 terminé (1 : écrivain fermé)
+//     uint64 taille d'un emplacement, uint64 début des emplacements, uint64 réservé
+//     à l'octet 64 (ligne de cache à part) : uint64 numéro de la dernière trame (0 : aucune)
+//   zb (N doubles)
+//   emplacements (alignés sur 64 octets) : uint64 séquence, double t, uint64 numéro,
+//     40 octets réservés, puis N doubles h et N doubles hu
+// Le segment est retiré (shm_unlink) à la fermeture : les lecteurs déjà attachés
+// gardent la dernière trame et voient terminé = 1.
+
+class DiffusionPartagee
+{
+private:
+    std::string _nom;
+    void* _memoire;
+    size_t _taille;
+    int _N;
+    int _nb_emplacements;
+    uint64_t _nb_trames;
+
+public:
+    DiffusionPartagee();
+    ~DiffusionPartagee();
+    DiffusionPartagee(const DiffusionPartagee&) = delete;
+    DiffusionPartagee& operator=(const DiffusionPartagee&) = delete;
+
+    // Crée le segment (un segment de même nom est d'abord retiré ; ses lecteurs
+    // gardent l'ancien). Retourne false (avec un message) en cas d'échec.
+    bool Ouvrir(const std::string& nom, int N, double dx, const double* zb, int nb_emplacements = 8);
+
+    // Publie l'état au temps t (deux copies de N doubles, aucun appel système)
+    void Publier(double t, const double* h, const double* hu);
+
+    // Marque le segment terminé, le retire et le détache (appelé aussi par le destructeur)
+    void Fermer();
+
+    long NombreTrames() const { return (long)_nb_trames; }
+};
+
+class LecteurDiffusion
+{
+private:
+    const void* _memoire;
+    size_t _taille;
+    int _N;
+    double _dx;
+    int _nb_emplacements;
+
+public:
+    LecteurDiffusion();
+    ~LecteurDiffusion();
+    LecteurDiffusion(const LecteurDiffusion&) = delete;
+    LecteurDiffusion& operator=(const LecteurDiffusion&) = delete;
+
+    // S'attache (en lecture seule) au segment d'un calcul en cours. Retourne false
+    // (avec un message) s'il n'existe pas ou n'est pas une diffusion valide.
+    bool Ouvrir(const std::string& nom);
+    void Fermer();
+
+    // Copie la dernière trame publiée. Retourne false si aucune trame n'a encore été
+    // publiée (ou, exceptionnellement, si l'écrivain a réécrit l'emplacement à
+    // chaque essai). numero permet de savoir si la trame est nouvelle.
+    bool LireDerniere(uint64_t& numero, double& t, std::vector<double>& h, std::vector<double>& hu) const;
+
+    bool Termine() const;   // L'écrivain a fermé le segment
+    int ObtenirN() const { return _N; }
+    double ObtenirDx() const { return _dx; }
+    const double* ObtenirZb() const;
+};
+
+// Nom POSIX du segment : "/" ajouté devant s'il manque
+std::string NomSegmentPartage(const std::string& nom);
+
+#endif // _DIFFUSION_PARTAGEE_H
@@ -0,0 +1,123 @@
+#include "EcrivainSauvegardes.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+
+EcrivainSauvegardes::EcrivainSauvegardes(function<void(const Instantane&)> ecrire, int nb_tampons, bool bloquer)
+    : _ecrire(ecrire), _bloquer(bloquer), _en_cours(false), _arret(false), _nb_ecrits(0), _nb_abandonnes(0),
+      _nb_attentes(0), _temps_attente(0.0)
+{
+    // Au moins deux tampons : l'un s'écrit pendant que l'autre se remplit
+    nb_tampons = max(2, nb_tampons);
+    for (int k = 0; k < nb_tampons; k++)
+    {
+        _tampons.emplace_back(new Instantane());
+        _libres.push_back(_tampons.back().get());
+    }
+    _thread = thread(&EcrivainSauvegardes::Boucle, this);
+}
+
+
+EcrivainSauvegardes::~EcrivainSauvegardes()
+{
+    {
+        lock_guard<mutex> verrou(_mutex);
+        _arret = true;
+    }
+    _cv_file.notify_all();
+    _thread.join();
+}
+
+
+void EcrivainSauvegardes::Boucle()
+{
+    unique_lock<mutex> verrou(_mutex);
+    while (true)
+    {
+        _cv_file.wait(verrou, [this] { return !_file.empty() || _arret; });
+        if (_file.empty())
+            return;   // Arrêt demandé et file vide
+
+        Instantane* instantane = _file.front();
+        _file.pop_front();
+        _en_cours = true;
+
+        // Le tampon n'est ni dans la file ni libre : le calcul n'y touche pas
+        verrou.unlock();
+        _ecrire(*instantane);
+        verrou.lock();
+
+        _en_cours = false;
+        _nb_ecrits++;
+        _libres.push_back(instantane);
+        _cv_libres.notify_all();
+    }
+}
+
+
+Instantane* EcrivainSauvegardes::Preparer()
+{
+    unique_lock<mutex> verrou(_mutex);
+    if (_libres.empty())
+    {
+        if (!_bloquer)
+        {
+            _nb_abandonnes++;
+            return nullptr;
+        }
+        _nb_attentes++;
+        auto debut = chrono::steady_clock::now();
+        _cv_libres.wait(verrou, [this] { return !_libres.empty(); });
+        _temps_attente += chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    }
+    Instantane* instantane = _libres.back();
+    _libres.pop_back();
+    return instantane;
+}
+
+
+void EcrivainSauvegardes::Lancer(Instantane* instantane)
+{
+    {
+        lock_guard<mutex> verrou(_mutex);
+        _file.push_back(instantane);
+    }
+    _cv_file.notify_all();
+}
+
+
+void EcrivainSauvegardes::Attendre()
+{
+    unique_lock<mutex> verrou(_mutex);
+    _cv_libres.wait(verrou, [this] { return _file.empty() && !_en_cours; });
+}
+
+
+long EcrivainSauvegardes::ObtenirNombreEcrits()
+{
+    lock_guard<mutex> verrou(_mutex);
+    return _nb_ecrits;
+}
+
+
+long EcrivainSauvegardes::ObtenirNombreAbandonnes()
+{
+    lock_guard<mutex> verrou(_mutex);
+    return _nb_abandonnes;
+}
+
+
+long EcrivainSauvegardes::ObtenirNombreAttentes()
+{
+    lock_guard<mutex> verrou(_mutex);
+    return _nb_attentes;
+}
+
+
+double EcrivainSauvegardes::ObtenirTempsAttente()
+{
+    lock_guard<mutex> verrou(_mutex);
+    return _temps_attente;
+}
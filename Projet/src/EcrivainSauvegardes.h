@@ -0,0 +1,76 @@
+#ifndef _ECRIVAIN_SAUVEGARDES_H
+#define _ECRIVAIN_SAUVEGARDES_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// ========================================
+// Ecriture des sauvegardes en arrière-plan
+// ========================================
+// Le pas de temps copie l'état dans un tampon libre d'une petite réserve (Preparer,
+// puis Lancer) et continue ; un thread dédié met en forme et écrit les instantanés
+// dans l'ordre, puis rend leurs tampons à la réserve (pas d'allocation en régime
+// établi). La file est bornée par le nombre de tampons. Quand le disque ne suit pas
+// et que tous les tampons sont en attente :
+// - politique bloquante : Preparer attend qu'un tampon se libère (aucune sauvegarde
+//   perdue, le calcul ralentit au rythme de l'écriture) ;
+// - politique d'abandon : Preparer retourne nullptr et la sauvegarde est perdue
+//   (comptée), le calcul ne ralentit jamais.
+// Le destructeur écrit tous les instantanés en attente avant d'arrêter le thread.
+
+struct Instantane
+{
+    double t = 0.0;
+    std::vector<double> h;
+    std::vector<double> hu;
+    std::vector<double> zb;
+};
+
+class EcrivainSauvegardes
+{
+private:
+    std::function<void(const Instantane&)> _ecrire;   // Appelée par le thread d'écriture
+    std::vector<std::unique_ptr<Instantane> > _tampons;
+    std::vector<Instantane*> _libres;
+    std::deque<Instantane*> _file;
+    bool _bloquer;
+    bool _en_cours;   // Un instantané est en cours d'écriture
+    bool _arret;
+    long _nb_ecrits;
+    long _nb_abandonnes;
+    long _nb_attentes;
+    double _temps_attente;   // Temps passé par le calcul à attendre un tampon (s)
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cv_file;      // Instantané à écrire ou arrêt
+    std::condition_variable _cv_libres;    // Tampon libéré
+
+    void Boucle();
+
+public:
+    EcrivainSauvegardes(std::function<void(const Instantane&)> ecrire, int nb_tampons, bool bloquer);
+
+    // Ecrit les instantanés en attente
+    ~EcrivainSauvegardes();
+
+    // Tampon libre à remplir ; nullptr (sauvegarde abandonnée) si aucun n'est libre
+    // avec la politique d'abandon
+    Instantane* Preparer();
+    // Met le tampon rempli dans la file d'écriture
+    void Lancer(Instantane* instantane);
+    // Attend que tous les instantanés lancés soient écrits
+    void Attendre();
+
+    long ObtenirNombreEcrits();
+    long ObtenirNombreAbandonnes();
+    long ObtenirNombreAttentes();        // Appels de Preparer qui ont dû attendre
+    double ObtenirTempsAttente();
+};
+
+#endif // _ECRIVAIN_SAUVEGARDES_H
@@ -0,0 +1,475 @@
+#include "Ensemble.h"
+#include "SaintVenant.h"
+#include "Schemas.h"
+#include "SommeCompensee.h"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+SaintVenantEnsemble::SaintVenantEnsemble() : _N(0), _K(0), _v_max_valide(false)
+{
+    ChoisirFlux("hll");
+}
+
+
+SaintVenantEnsemble::~SaintVenantEnsemble()
+{
+    if (_fichier.is_open())
+        _fichier.close();
+}
+
+
+bool SaintVenantEnsemble::Initialiser(const SaintVenant1D& reference, int nb_membres, double CFL, string nom_fichier)
+{
+    if (nb_membres < 1 || reference.ObtenirH().size() < 3)
+    {
+        cout << "Erreur : ensemble de " << nb_membres << " membres sur " << reference.ObtenirH().size()
+             << " cellules invalide" << endl;
+        return false;
+    }
+
+    _N = (int)reference.ObtenirH().size();
+    _K = nb_membres;
+    _dx = reference.ObtenirDx();
+    _L = _N * _dx;
+    _CFL = CFL;
+
+    // Bathymétrie commune
+    _zb = reference.ObtenirZb();
+    _z_interface.assign(_N + 1, 0.0);
+    for (int f = 1; f < _N; f++)
+        _z_interface[f] = max(_zb[f-1], _zb[f]);
+
+    // Tous les membres partent de l'état de la référence
+    _h.resize((size_t)_N * _K);
+    _hu.resize((size_t)_N * _K);
+    for (int m = 0; m < _K; m++)
+        DefinirMembre(m, reference);
+
+    _h_nouveau.assign((size_t)_N * _K, 0.0);
+    _hu_nouveau.assign((size_t)_N * _K, 0.0);
+    _face_hG.assign((size_t)(_N + 1) * _K, 0.0);
+    _face_hD.assign((size_t)(_N + 1) * _K, 0.0);
+    _flux_h.assign((size_t)(_N + 1) * _K, 0.0);
+    _flux_hu.assign((size_t)(_N + 1) * _K, 0.0);
+
+    _t.assign(_K, 0.0);
+    _dt.assign(_K, 0.0);
+    _coeff.assign(_K, 0.0);
+    _v_max.assign(_K, 0.0);
+    _v_max_valide = false;
+
+    _fichier.open(nom_fichier);
+    if (_fichier.is_open())
+        _fichier << "# membre t dt masse energie H_max x_crete v_max" << endl;
+
+    cout << "Ensemble initialisé :" << endl;
+    cout << "  - Nombre de membres : " << _K << endl;
+    cout << "  - Nombre de cellules : " << _N << endl;
+    cout << "  - Pas d'espace dx : " << _dx << " m" << endl;
+    return true;
+}
+
+
+bool SaintVenantEnsemble::ChoisirFlux(const string& nom)
+{
+    struct EntreeFlux
+    {
+        const char* nom;
+        FonctionSchema fonction;
+    };
+    static const EntreeFlux flux[] = {
+        { FluxPolitiqueRusanov::Nom(), &SaintVenantEnsemble::CalculerFluxEtMiseAJour<FluxPolitiqueRusanov> },
+        { FluxPolitiqueHLL::Nom(),     &SaintVenantEnsemble::CalculerFluxEtMiseAJour<FluxPolitiqueHLL> },
+    };
+
+    string nom_effectif = NomFluxEffectif(nom);
+    for (const EntreeFlux& entree : flux)
+    {
+        if (nom_effectif == entree.nom)
+        {
+            _schema = entree.fonction;
+            _nom_flux = nom_effectif;
+            return true;
+        }
+    }
+
+    cout << "Erreur : flux inconnu '" << nom << "' (rusanov, hll)" << endl;
+    return false;
+}
+
+
+// ========================================
+// Etat initial des membres
+// ========================================
+
+bool SaintVenantEnsemble::DefinirMembre(int membre, const SaintVenant1D& etat)
+{
+    if (membre < 0 || membre >= _K || (int)etat.ObtenirH().size() != _N)
+    {
+        cout << "Erreur : membre " << membre << " ou grille de " << etat.ObtenirH().size()
+             << " cellules incompatible avec l'ensemble" << endl;
+        return false;
+    }
+
+    const vector<double>& h = etat.ObtenirH();
+    const vector<double>& hu = etat.ObtenirHu();
+    for (int i = 0; i < _N; i++)
+    {
+        _h[(size_t)i * _K + membre] = h[i];
+        _hu[(size_t)i * _K + membre] = hu[i];
+    }
+    _v_max_valide = false;
+    return true;
+}
+
+
+void SaintVenantEnsemble::ConditionInitialeSoliton(int membre, double A, double x_depart)
+{
+    // Même profil que SaintVenant1D::ConditionInitialeSoliton
+    _v_max_valide = false;
+    double h0 = 2;
+    double c = sqrt(_g * (h0 + A));
+    double k = sqrt((3.0 * A) / (4.0 * pow(h0, 3)));
+
+    for (int i = 0; i < _N; i++)
+    {
+        double x = (i + 0.5) * _dx;
+        double sech = 1.0 / cosh(k * (x - x_depart));
+        double eta = A * sech * sech;
+        double H = h0 + eta;
+        double h_reel = std::max(0.0, H - _zb[i]);
+
+        size_t j = (size_t)i * _K + membre;
+        if (h_reel < critere_hauteur_deau)
+        {
+            _h[j] = 0.0;
+            _hu[j] = 0.0;
+        }
+        else
+        {
+            _h[j] = h_reel;
+            _hu[j] = _h[j] * (c * (eta / H));
+        }
+    }
+}
+
+
+// ========================================
+// Noyaux sur les membres
+// ========================================
+// Chaque boucle interne porte sur les K membres d'une cellule ou d'une interface :
+// accès contigus, sans dépendance entre itérations ni branchement (sélections), donc
+// vectorisée par le compilateur. Chaque noyau est compilé pour AVX-512, AVX2 et le
+// jeu de base, la version est choisie au chargement selon le processeur. Le fichier
+// est compilé sans contraction FMA ni errno sur sqrt (voir CMakeLists.txt) : les
+// arrondis sont ceux de SaintVenant1D.
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define SV_VERSIONS_MEMBRES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SV_VERSIONS_MEMBRES
+#endif
+
+// Reconstruction hydrostatique des interfaces [f_debut, f_fin)
+SV_VERSIONS_MEMBRES
+static void ReconstruireMembres(int K, int f_debut, int f_fin, const double* __restrict h,
+                                const double* __restrict zb, const double* __restrict z_interface,
+                                double* __restrict face_hG, double* __restrict face_hD)
+{
+    for (int f = f_debut; f < f_fin; f++)
+    {
+        const double z_gauche = zb[f-1], z_droite = zb[f], z_inter = z_interface[f];
+        const double* h_gauche = h + (size_t)(f - 1) * K;
+        const double* h_droite = h + (size_t)f * K;
+        double* hG = face_hG + (size_t)f * K;
+        double* hD = face_hD + (size_t)f * K;
+        for (int m = 0; m < K; m++)
+        {
+            hG[m] = std::max(0.0, h_gauche[m] + z_gauche - z_inter);
+            hD[m] = std::max(0.0, h_droite[m] + z_droite - z_inter);
+        }
+    }
+}
+
+
+// Mise à jour des cellules [i_debut, i_fin) (même terme source que SourceHydrostatique::Source)
+SV_VERSIONS_MEMBRES
+static void MettreAJourMembres(int K, int i_debut, int i_fin, const double* __restrict h, const double* __restrict hu,
+                               const double* __restrict face_hG, const double* __restrict face_hD,
+                               const double* __restrict flux_h, const double* __restrict flux_hu,
+                               const double* __restrict coeff, double g,
+                               double* __restrict h_nouveau, double* __restrict hu_nouveau)
+{
+    for (int i = i_debut; i < i_fin; i++)
+    {
+        size_t c = (size_t)i * K, d = (size_t)(i + 1) * K;
+        for (int m = 0; m < K; m++)
+        {
+            double h_c = h[c + m];
+            double TermeSource_G = 0.5 * g * (std::pow(face_hD[c + m], 2) - std::pow(h_c, 2));
+            double TermeSource_D = 0.5 * g * (std::pow(face_hG[d + m], 2) - std::pow(h_c, 2));
+            double Source_i = TermeSource_G + TermeSource_D;
+
+            h_nouveau[c + m] = h_c - coeff[m] * (flux_h[d + m] - flux_h[c + m]);
+            hu_nouveau[c + m] = hu[c + m] - coeff[m] * (flux_hu[d + m] - flux_hu[c + m]) + coeff[m] * Source_i;
+        }
+    }
+}
+
+
+// Vitesse max (|u| + c) de chaque membre sur les cellules [0, N), avec ou sans
+// nettoyage préalable des cellules sèches (h < critere_h : h = hu = 0)
+SV_VERSIONS_MEMBRES
+static void VitesseMaximaleMembres(int K, int N, double* __restrict h, double* __restrict hu, bool nettoyer,
+                                   double critere_h, double g, double* __restrict v_max)
+{
+    for (int m = 0; m < K; m++)
+        v_max[m] = 0.0;
+
+    for (int i = 0; i < N; i++)
+    {
+        double* h_i = h + (size_t)i * K;
+        double* hu_i = hu + (size_t)i * K;
+        for (int m = 0; m < K; m++)
+        {
+            double h_m = h_i[m], hu_m = hu_i[m];
+            if (nettoyer)
+            {
+                bool sec = h_m < critere_h;
+                h_m = sec ? 0.0 : h_m;
+                hu_m = sec ? 0.0 : hu_m;
+                h_i[m] = h_m;
+                hu_i[m] = hu_m;
+            }
+
+            // Mêmes résultats que hu / h si h > critere_h, 0 sinon ; c = 0 si h <= 1e-10
+            double u = (h_m > critere_h) ? hu_m / (h_m > critere_h ? h_m : 1.0) : 0.0;
+            double c = (h_m > 1e-10) ? std::sqrt(g * (h_m > 1e-10 ? h_m : 0.0)) : 0.0;
+            double v = std::fabs(u) + c;
+            v_max[m] = (v_max[m] < v) ? v : v_max[m];
+        }
+    }
+}
+
+
+// ========================================
+// Pas de temps
+// ========================================
+
+void SaintVenantEnsemble::VitesseMaximale()
+{
+    VitesseMaximaleMembres(_K, _N, _h.data(), _hu.data(), false, critere_hauteur_deau, _g, _v_max.data());
+}
+
+
+void SaintVenantEnsemble::CalculerPasDeTemps(double t_final)
+{
+    // Vitesses max fournies par le pas précédent quand l'état n'a pas changé depuis
+    if (!_v_max_valide)
+        VitesseMaximale();
+
+    for (int m = 0; m < _K; m++)
+    {
+        double dt = (_v_max[m] > critere_vitesse) ? _CFL * _dx / _v_max[m] : 0.01;
+        if (t_final > 0.0)
+            dt = max(0.0, min(dt, t_final - _t[m]));
+        _dt[m] = dt;
+        _coeff[m] = dt / _dx;
+    }
+}
+
+
+// Interfaces 1 .. N-1 puis cellules intérieures 1 .. N-2, pour tous les membres
+template <class Flux>
+void SaintVenantEnsemble::CalculerFluxEtMiseAJour()
+{
+    const int K = _K;
+
+    // 1. Reconstruction hydrostatique (fond de l'interface commun aux membres)
+    ReconstruireMembres(K, 1, _N, _h.data(), _zb.data(), _z_interface.data(), _face_hG.data(), _face_hD.data());
+
+    // 2. Flux : les interfaces 1 .. N-1 de tous les membres forment un seul lot
+    // (le débit à gauche de l'interface f est celui de la cellule f-1, soit K valeurs plus tôt)
+    Flux::Lot((_N - 1) * K, &_face_hG[K], &_hu[0], &_face_hD[K], &_hu[K],
+              &_flux_h[K], &_flux_hu[K], _g, critere_hauteur_deau);
+
+    // 3. Mise à jour
+    MettreAJourMembres(K, 1, _N - 1, _h.data(), _hu.data(), _face_hG.data(), _face_hD.data(),
+                       _flux_h.data(), _flux_hu.data(), _coeff.data(), _g, _h_nouveau.data(), _hu_nouveau.data());
+}
+
+
+void SaintVenantEnsemble::AppliquerConditionsLimites()
+{
+    // Sortie libre, comme SaintVenant1D::AppliquerConditionsLimites
+    double* h = _h_nouveau.data();
+    double* hu = _hu_nouveau.data();
+    size_t bord_droit = (size_t)(_N - 1) * _K, voisin_droit = (size_t)(_N - 2) * _K;
+    for (int m = 0; m < _K; m++)
+    {
+        h[m] = h[_K + m];
+        hu[m] = hu[_K + m];
+        double H_voisin = h[voisin_droit + m] + _zb[_N-2];
+        h[bord_droit + m] = max(0.0, H_voisin - _zb[_N-1]);
+        hu[bord_droit + m] = hu[voisin_droit + m];
+    }
+}
+
+
+void SaintVenantEnsemble::NettoyerCellules()
+{
+    // Cellules sèches et vitesse max de l'état nettoyé, dans le même balayage
+    VitesseMaximaleMembres(_K, _N, _h_nouveau.data(), _hu_nouveau.data(), true, critere_hauteur_deau, _g, _v_max.data());
+}
+
+
+void SaintVenantEnsemble::Avancer(double t_final)
+{
+    CalculerPasDeTemps(t_final);
+
+    (this->*_schema)();
+    AppliquerConditionsLimites();
+    NettoyerCellules();
+
+    _h.swap(_h_nouveau);
+    _hu.swap(_hu_nouveau);
+    _v_max_valide = true;
+
+    for (int m = 0; m < _K; m++)
+        _t[m] += _dt[m];
+}
+
+
+int SaintVenantEnsemble::AvancerJusqua(double t_final)
+{
+    int nb_pas = 0;
+    while (true)
+    {
+        bool termine = true;
+        for (int m = 0; m < _K; m++)
+            termine = termine && _t[m] >= t_final;
+        if (termine)
+            return nb_pas;
+
+        Avancer(t_final);
+        nb_pas++;
+    }
+}
+
+
+// ========================================
+// Diagnostics
+// ========================================
+
+// Blocs et sommes compensées de SaintVenant1D::SommeParBlocs (mêmes arrondis)
+static const int TAILLE_BLOC_SOMME = 4096;
+
+vector<SaintVenantEnsemble::DiagnosticMembre> SaintVenantEnsemble::CalculerDiagnostics() const
+{
+    vector<DiagnosticMembre> diagnostics(_K);
+    vector<SommeCompensee> masse(_K), energie(_K);
+    vector<SommeCompensee> masse_bloc(_K), energie_bloc(_K);
+    vector<double> H_max(_K, -99999.0), H_crete(_K, -99999.0);
+    vector<int> i_crete(_K, 0);
+
+    for (int debut = 0; debut < _N; debut += TAILLE_BLOC_SOMME)
+    {
+        fill(masse_bloc.begin(), masse_bloc.end(), SommeCompensee());
+        fill(energie_bloc.begin(), energie_bloc.end(), SommeCompensee());
+
+        int fin = min(_N, debut + TAILLE_BLOC_SOMME);
+        for (int i = debut; i < fin; i++)
+        {
+            const double* h = &_h[(size_t)i * _K];
+            const double* hu = &_hu[(size_t)i * _K];
+            for (int m = 0; m < _K; m++)
+            {
+                masse_bloc[m].Ajouter(h[m]);
+
+                double Ep = 0.5 * _g * h[m] * h[m];
+                double Ec = 0.0;
+                if (h[m] > 1e-10)
+                {
+                    double u = hu[m] / h[m];
+                    Ec = 0.5 * h[m] * u * u;
+                }
+                energie_bloc[m].Ajouter(Ep + Ec);
+
+                double H = h[m] + _zb[i];
+                if (h[m] > 1e-6 && H > H_max[m])
+                    H_max[m] = H;
+                if (h[m] > 1e-4 && H > H_crete[m])
+                {
+                    H_crete[m] = H;
+                    i_crete[m] = i;
+                }
+            }
+        }
+
+        for (int m = 0; m < _K; m++)
+        {
+            masse[m].Ajouter(masse_bloc[m]);
+            energie[m].Ajouter(energie_bloc[m]);
+        }
+    }
+
+    for (int m = 0; m < _K; m++)
+    {
+        diagnostics[m].t = _t[m];
+        diagnostics[m].dt = _dt[m];
+        diagnostics[m].masse = masse[m].Valeur() * _dx;
+        diagnostics[m].energie = energie[m].Valeur() * _dx;
+        diagnostics[m].H_max = H_max[m];
+        diagnostics[m].x_crete = (i_crete[m] + 0.5) * _dx;
+        diagnostics[m].v_max = _v_max[m];
+    }
+    return diagnostics;
+}
+
+
+void SaintVenantEnsemble::EcrireDiagnostics()
+{
+    vector<DiagnosticMembre> diagnostics = CalculerDiagnostics();
+    for (int m = 0; m < _K; m++)
+    {
+        const DiagnosticMembre& d = diagnostics[m];
+        _fichier << m << " " << d.t << " " << d.dt << " " << d.masse << " " << d.energie << " "
+                 << d.H_max << " " << d.x_crete << " " << d.v_max << "\n";
+    }
+    _fichier << endl;
+}
+
+
+void SaintVenantEnsemble::Sauvegarder(int membre, ostream& sortie) const
+{
+    for (int i = 0; i < _N; i++)
+    {
+        double h = _h[(size_t)i * _K + membre];
+        double hu = _hu[(size_t)i * _K + membre];
+        double u = (h > critere_hauteur_deau) ? hu / h : 0.0;
+
+        // On écrit : t x h u zb H
+        sortie << _t[membre] << " " << (i + 0.5) * _dx << " " << h << " " << u << " " << _zb[i] << " " << h + _zb[i] << endl;
+    }
+    sortie << endl;
+}
+
+
+vector<double> SaintVenantEnsemble::ObtenirH(int membre) const
+{
+    vector<double> h(_N);
+    for (int i = 0; i < _N; i++)
+        h[i] = _h[(size_t)i * _K + membre];
+    return h;
+}
+
+
+vector<double> SaintVenantEnsemble::ObtenirHu(int membre) const
+{
+    vector<double> hu(_N);
+    for (int i = 0; i < _N; i++)
+        hu[i] = _hu[(size_t)i * _K + membre];
+    return hu;
+}
@@ -0,0 +1,129 @@
+#ifndef _ENSEMBLE_H
+#define _ENSEMBLE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+class SaintVenant1D;
+
+// ========================================
+// Ensemble de scénarios Saint-Venant 1D sur une même bathymétrie
+// ========================================
+// K membres (variantes de condition initiale) avancent ensemble avec le schéma
+// d'ordre 1 de SaintVenant1D (reconstruction hydrostatique). Les champs sont
+// entrelacés par cellule : la valeur du membre m dans la cellule i est en
+// i * K + m. Pour une interface donnée, les K états gauches (et droits) sont
+// donc contigus, et toutes les interfaces de tous les membres forment un seul
+// lot pour les noyaux vectorisés de FluxVectorise.h (une voie = un membre).
+// Le fond est lu une fois par cellule pour tous les membres.
+//
+// Chaque membre a son propre pas de temps (sa condition CFL) et son propre temps.
+// Un membre donné évolue exactement (bit à bit) comme un SaintVenant1D seul partant
+// du même état, avec le même flux.
+class SaintVenantEnsemble
+{
+public:
+    // Diagnostics d'un membre (mêmes définitions que SaintVenant1D)
+    struct DiagnosticMembre
+    {
+        double t;
+        double dt;
+        double masse;
+        double energie;
+        double H_max;     // Altitude max de la surface libre
+        double x_crete;   // Position de la crête
+        double v_max;     // max |u| + c
+    };
+
+private:
+    // Paramètres du domaine
+    int _N;
+    int _K;              // Nombre de membres
+    double _L;
+    double _dx;
+    double critere_hauteur_deau = 1e-4;
+    double critere_vitesse = 1e-10;
+    double _CFL;
+
+    // Bathymétrie commune et fond de chaque interface (max des deux cellules)
+    std::vector<double> _zb;
+    std::vector<double> _z_interface;
+
+    // Champs entrelacés (N * K)
+    std::vector<double> _h;
+    std::vector<double> _hu;
+    std::vector<double> _h_nouveau;
+    std::vector<double> _hu_nouveau;
+
+    // Interfaces entrelacées ((N + 1) * K)
+    std::vector<double> _face_hG;
+    std::vector<double> _face_hD;
+    std::vector<double> _flux_h;
+    std::vector<double> _flux_hu;
+
+    // Temps de chaque membre
+    std::vector<double> _t;
+    std::vector<double> _dt;
+    std::vector<double> _coeff;   // dt / dx
+    std::vector<double> _v_max;
+    bool _v_max_valide;
+
+    static constexpr double _g = 9.81;
+
+    std::ofstream _fichier;
+
+    // Schéma : une instanciation par politique de flux (voir Schemas.h)
+    typedef void (SaintVenantEnsemble::*FonctionSchema)();
+    FonctionSchema _schema;
+    std::string _nom_flux;
+
+    template <class Flux>
+    void CalculerFluxEtMiseAJour();
+    void AppliquerConditionsLimites();
+    void NettoyerCellules();
+    void VitesseMaximale();
+    void CalculerPasDeTemps(double t_final);
+
+public:
+    SaintVenantEnsemble();
+    ~SaintVenantEnsemble();
+
+    // Initialiser à partir d'un solveur dont le fond est défini : grille et bathymétrie
+    // sont reprises, tous les membres partent de son état. Les diagnostics sont écrits
+    // dans nom_fichier (voir EcrireDiagnostics).
+    bool Initialiser(const SaintVenant1D& reference, int nb_membres, double CFL, std::string nom_fichier);
+
+    // Flux numérique : rusanov, hll (défaut) ; "hllc" est un alias de hll (voir Schemas.h)
+    bool ChoisirFlux(const std::string& nom);
+    const std::string& ObtenirNomFlux() const { return _nom_flux; }
+
+    // Etat initial d'un membre
+    bool DefinirMembre(int membre, const SaintVenant1D& etat);     // Recopie h, hu (même grille)
+    void ConditionInitialeSoliton(int membre, double A, double x_depart);
+
+    // Avancer tous les membres d'un pas (chacun avec son propre dt)
+    // t_final > 0 : le pas de chaque membre est réduit pour ne pas dépasser t_final,
+    // les membres arrivés ne bougent plus
+    void Avancer(double t_final = 0.0);
+    // Avancer jusqu'à ce que tous les membres soient à t_final ; retourne le nombre de pas
+    int AvancerJusqua(double t_final);
+
+    // Diagnostics de tous les membres
+    std::vector<DiagnosticMembre> CalculerDiagnostics() const;
+    // Une ligne par membre : membre t dt masse energie H_max x_crete v_max
+    void EcrireDiagnostics();
+    // Solution d'un membre, au format de SaintVenant1D::Sauvegarder (t x h u zb H)
+    void Sauvegarder(int membre, std::ostream& sortie) const;
+
+    // Accesseurs
+    int ObtenirNombreMembres() const { return _K; }
+    int ObtenirN() const { return _N; }
+    double ObtenirDx() const { return _dx; }
+    double ObtenirTemps(int membre) const { return _t[membre]; }
+    double ObtenirDt(int membre) const { return _dt[membre]; }
+    std::vector<double> ObtenirH(int membre) const;
+    std::vector<double> ObtenirHu(int membre) const;
+};
+
+#endif // _ENSEMBLE_H
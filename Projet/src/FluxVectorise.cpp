@@ -0,0 +1,348 @@
+#include "FluxVectorise.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SV_X86 1
+#endif
+
+using namespace std;
+
+// Remarques communes à toutes les versions :
+// - les trois cas HLL (S_L >= 0, S_R <= 0, subsonique) sont tous calculés puis
+//   sélectionnés par masque, sans branchement ;
+// - la division hu/h se fait avec un dénominateur remplacé par 1 dans les cellules
+//   sèches, le résultat y est ensuite masqué à 0 ;
+// - min/max reproduisent exactement std::min(a, b) = (b < a) ? b : a
+//   et std::max(a, b) = (a < b) ? b : a ;
+// - ce fichier est compilé sans contraction FMA (voir CMakeLists.txt) pour garder
+//   les mêmes arrondis que les fonctions membres de SaintVenant1D ;
+// - la version scalaire est celle de FluxVectorise.h (FluxHLLInterface, FluxRusanovInterface).
+
+
+// ========================================
+// Version scalaire (toujours disponible)
+// ========================================
+static void FluxHLLScalaire(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                            double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    for (int k = 0; k < n; k++)
+        FluxHLLInterface(hL[k], huL[k], hR[k], huR[k], flux_h[k], flux_hu[k], g, critere_h);
+}
+
+
+static void FluxRusanovScalaire(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                                double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    for (int k = 0; k < n; k++)
+        FluxRusanovInterface(hL[k], huL[k], hR[k], huR[k], flux_h[k], flux_hu[k], g, critere_h);
+}
+
+
+#ifdef SV_X86
+
+// ========================================
+// Version AVX2 (4 interfaces par instruction)
+// ========================================
+__attribute__((target("avx2")))
+static void FluxHLLAVX2(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                        double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d un = _mm256_set1_pd(1.0);
+    const __m256d vg = _mm256_set1_pd(g);
+    const __m256d demi_g = _mm256_set1_pd(0.5 * g);
+    const __m256d seuil_u = _mm256_set1_pd(1e-8);
+    const __m256d seuil_h = _mm256_set1_pd(critere_h);
+
+    int k = 0;
+    for (; k + 4 <= n; k += 4)
+    {
+        __m256d hl = _mm256_loadu_pd(hL + k), hul = _mm256_loadu_pd(huL + k);
+        __m256d hr = _mm256_loadu_pd(hR + k), hur = _mm256_loadu_pd(huR + k);
+
+        // Vitesses et célérités
+        __m256d qL = _mm256_div_pd(hul, _mm256_blendv_pd(un, hl, _mm256_cmp_pd(hl, zero, _CMP_GT_OQ)));
+        __m256d qR = _mm256_div_pd(hur, _mm256_blendv_pd(un, hr, _mm256_cmp_pd(hr, zero, _CMP_GT_OQ)));
+        __m256d uL = _mm256_and_pd(_mm256_cmp_pd(hl, seuil_u, _CMP_GT_OQ), qL);
+        __m256d uR = _mm256_and_pd(_mm256_cmp_pd(hr, seuil_u, _CMP_GT_OQ), qR);
+        __m256d cL = _mm256_sqrt_pd(_mm256_mul_pd(vg, hl));
+        __m256d cR = _mm256_sqrt_pd(_mm256_mul_pd(vg, hr));
+
+        __m256d S_L = _mm256_min_pd(_mm256_sub_pd(uR, cR), _mm256_sub_pd(uL, cL));
+        __m256d S_R = _mm256_max_pd(_mm256_add_pd(uR, cR), _mm256_add_pd(uL, cL));
+
+        // Flux physiques
+        __m256d FL_h = hul, FR_h = hur;
+        __m256d FL_hu = _mm256_and_pd(_mm256_cmp_pd(hl, seuil_h, _CMP_GT_OQ),
+            _mm256_add_pd(_mm256_mul_pd(hul, qL), _mm256_mul_pd(_mm256_mul_pd(demi_g, hl), hl)));
+        __m256d FR_hu = _mm256_and_pd(_mm256_cmp_pd(hr, seuil_h, _CMP_GT_OQ),
+            _mm256_add_pd(_mm256_mul_pd(hur, qR), _mm256_mul_pd(_mm256_mul_pd(demi_g, hr), hr)));
+
+        // Flux HLL dans l'éventail
+        __m256d denom = _mm256_sub_pd(S_R, S_L);
+        __m256d SLSR = _mm256_mul_pd(S_L, S_R);
+        __m256d fh = _mm256_div_pd(_mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(S_R, FL_h), _mm256_mul_pd(S_L, FR_h)),
+                                                 _mm256_mul_pd(SLSR, _mm256_sub_pd(hr, hl))), denom);
+        __m256d fhu = _mm256_div_pd(_mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(S_R, FL_hu), _mm256_mul_pd(S_L, FR_hu)),
+                                                  _mm256_mul_pd(SLSR, _mm256_sub_pd(hur, hul))), denom);
+
+        // Sélection du cas
+        __m256d casB = _mm256_cmp_pd(S_R, zero, _CMP_LE_OQ);
+        __m256d casA = _mm256_cmp_pd(S_L, zero, _CMP_GE_OQ);
+        fh  = _mm256_blendv_pd(_mm256_blendv_pd(fh,  FR_h,  casB), FL_h,  casA);
+        fhu = _mm256_blendv_pd(_mm256_blendv_pd(fhu, FR_hu, casB), FL_hu, casA);
+
+        _mm256_storeu_pd(flux_h + k, fh);
+        _mm256_storeu_pd(flux_hu + k, fhu);
+    }
+
+    // Reste du lot
+    FluxHLLScalaire(n - k, hL + k, huL + k, hR + k, huR + k, flux_h + k, flux_hu + k, g, critere_h);
+}
+
+
+__attribute__((target("avx2")))
+static void FluxRusanovAVX2(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                            double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d un = _mm256_set1_pd(1.0);
+    const __m256d demi = _mm256_set1_pd(0.5);
+    const __m256d vg = _mm256_set1_pd(g);
+    const __m256d demi_g = _mm256_set1_pd(0.5 * g);
+    const __m256d seuil_h = _mm256_set1_pd(critere_h);
+    const __m256d signe = _mm256_set1_pd(-0.0);
+
+    int k = 0;
+    for (; k + 4 <= n; k += 4)
+    {
+        __m256d hl = _mm256_loadu_pd(hL + k), hul = _mm256_loadu_pd(huL + k);
+        __m256d hr = _mm256_loadu_pd(hR + k), hur = _mm256_loadu_pd(huR + k);
+
+        __m256d mouilleL = _mm256_cmp_pd(hl, seuil_h, _CMP_GT_OQ);
+        __m256d mouilleR = _mm256_cmp_pd(hr, seuil_h, _CMP_GT_OQ);
+
+        __m256d qL = _mm256_div_pd(hul, _mm256_blendv_pd(un, hl, _mm256_cmp_pd(hl, zero, _CMP_GT_OQ)));
+        __m256d qR = _mm256_div_pd(hur, _mm256_blendv_pd(un, hr, _mm256_cmp_pd(hr, zero, _CMP_GT_OQ)));
+        __m256d uL = _mm256_and_pd(mouilleL, qL);
+        __m256d uR = _mm256_and_pd(mouilleR, qR);
+        __m256d cL = _mm256_and_pd(mouilleL, _mm256_sqrt_pd(_mm256_mul_pd(vg, hl)));
+        __m256d cR = _mm256_and_pd(mouilleR, _mm256_sqrt_pd(_mm256_mul_pd(vg, hr)));
+
+        __m256d FL_hu = _mm256_and_pd(mouilleL,
+            _mm256_add_pd(_mm256_mul_pd(hul, qL), _mm256_mul_pd(_mm256_mul_pd(demi_g, hl), hl)));
+        __m256d FR_hu = _mm256_and_pd(mouilleR,
+            _mm256_add_pd(_mm256_mul_pd(hur, qR), _mm256_mul_pd(_mm256_mul_pd(demi_g, hr), hr)));
+
+        __m256d lambdaL = _mm256_add_pd(_mm256_andnot_pd(signe, uL), cL);
+        __m256d lambdaR = _mm256_add_pd(_mm256_andnot_pd(signe, uR), cR);
+        __m256d demi_lambda = _mm256_mul_pd(demi, _mm256_max_pd(lambdaR, lambdaL));
+
+        __m256d fh = _mm256_sub_pd(_mm256_mul_pd(demi, _mm256_add_pd(hul, hur)),
+                                   _mm256_mul_pd(demi_lambda, _mm256_sub_pd(hr, hl)));
+        __m256d fhu = _mm256_sub_pd(_mm256_mul_pd(demi, _mm256_add_pd(FL_hu, FR_hu)),
+                                    _mm256_mul_pd(demi_lambda, _mm256_sub_pd(hur, hul)));
+
+        _mm256_storeu_pd(flux_h + k, fh);
+        _mm256_storeu_pd(flux_hu + k, fhu);
+    }
+
+    FluxRusanovScalaire(n - k, hL + k, huL + k, hR + k, huR + k, flux_h + k, flux_hu + k, g, critere_h);
+}
+
+
+// ========================================
+// Version AVX-512 (8 interfaces par instruction)
+// ========================================
+// GCC 12 signale à tort le vecteur _mm512_undefined_pd() interne à _mm512_sqrt_pd et
+// _mm512_max_pd (avx512fintrin.h) comme non initialisé
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+__attribute__((target("avx512f")))
+static void FluxHLLAVX512(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                          double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d un = _mm512_set1_pd(1.0);
+    const __m512d vg = _mm512_set1_pd(g);
+    const __m512d demi_g = _mm512_set1_pd(0.5 * g);
+    const __m512d seuil_u = _mm512_set1_pd(1e-8);
+    const __m512d seuil_h = _mm512_set1_pd(critere_h);
+
+    int k = 0;
+    for (; k + 8 <= n; k += 8)
+    {
+        __m512d hl = _mm512_loadu_pd(hL + k), hul = _mm512_loadu_pd(huL + k);
+        __m512d hr = _mm512_loadu_pd(hR + k), hur = _mm512_loadu_pd(huR + k);
+
+        // Vitesses et célérités
+        __m512d qL = _mm512_div_pd(hul, _mm512_mask_blend_pd(_mm512_cmp_pd_mask(hl, zero, _CMP_GT_OQ), un, hl));
+        __m512d qR = _mm512_div_pd(hur, _mm512_mask_blend_pd(_mm512_cmp_pd_mask(hr, zero, _CMP_GT_OQ), un, hr));
+        __m512d uL = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(hl, seuil_u, _CMP_GT_OQ), qL);
+        __m512d uR = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(hr, seuil_u, _CMP_GT_OQ), qR);
+        __m512d cL = _mm512_sqrt_pd(_mm512_mul_pd(vg, hl));
+        __m512d cR = _mm512_sqrt_pd(_mm512_mul_pd(vg, hr));
+
+        __m512d S_L = _mm512_min_pd(_mm512_sub_pd(uR, cR), _mm512_sub_pd(uL, cL));
+        __m512d S_R = _mm512_max_pd(_mm512_add_pd(uR, cR), _mm512_add_pd(uL, cL));
+
+        // Flux physiques
+        __m512d FL_h = hul, FR_h = hur;
+        __m512d FL_hu = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(hl, seuil_h, _CMP_GT_OQ),
+            _mm512_add_pd(_mm512_mul_pd(hul, qL), _mm512_mul_pd(_mm512_mul_pd(demi_g, hl), hl)));
+        __m512d FR_hu = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(hr, seuil_h, _CMP_GT_OQ),
+            _mm512_add_pd(_mm512_mul_pd(hur, qR), _mm512_mul_pd(_mm512_mul_pd(demi_g, hr), hr)));
+
+        // Flux HLL dans l'éventail
+        __m512d denom = _mm512_sub_pd(S_R, S_L);
+        __m512d SLSR = _mm512_mul_pd(S_L, S_R);
+        __m512d fh = _mm512_div_pd(_mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(S_R, FL_h), _mm512_mul_pd(S_L, FR_h)),
+                                                 _mm512_mul_pd(SLSR, _mm512_sub_pd(hr, hl))), denom);
+        __m512d fhu = _mm512_div_pd(_mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(S_R, FL_hu), _mm512_mul_pd(S_L, FR_hu)),
+                                                  _mm512_mul_pd(SLSR, _mm512_sub_pd(hur, hul))), denom);
+
+        // Sélection du cas
+        __mmask8 casB = _mm512_cmp_pd_mask(S_R, zero, _CMP_LE_OQ);
+        __mmask8 casA = _mm512_cmp_pd_mask(S_L, zero, _CMP_GE_OQ);
+        fh  = _mm512_mask_blend_pd(casA, _mm512_mask_blend_pd(casB, fh,  FR_h),  FL_h);
+        fhu = _mm512_mask_blend_pd(casA, _mm512_mask_blend_pd(casB, fhu, FR_hu), FL_hu);
+
+        _mm512_storeu_pd(flux_h + k, fh);
+        _mm512_storeu_pd(flux_hu + k, fhu);
+    }
+
+    FluxHLLScalaire(n - k, hL + k, huL + k, hR + k, huR + k, flux_h + k, flux_hu + k, g, critere_h);
+}
+
+
+__attribute__((target("avx512f")))
+static void FluxRusanovAVX512(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                              double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d un = _mm512_set1_pd(1.0);
+    const __m512d demi = _mm512_set1_pd(0.5);
+    const __m512d vg = _mm512_set1_pd(g);
+    const __m512d demi_g = _mm512_set1_pd(0.5 * g);
+    const __m512d seuil_h = _mm512_set1_pd(critere_h);
+
+    int k = 0;
+    for (; k + 8 <= n; k += 8)
+    {
+        __m512d hl = _mm512_loadu_pd(hL + k), hul = _mm512_loadu_pd(huL + k);
+        __m512d hr = _mm512_loadu_pd(hR + k), hur = _mm512_loadu_pd(huR + k);
+
+        __mmask8 mouilleL = _mm512_cmp_pd_mask(hl, seuil_h, _CMP_GT_OQ);
+        __mmask8 mouilleR = _mm512_cmp_pd_mask(hr, seuil_h, _CMP_GT_OQ);
+
+        __m512d qL = _mm512_div_pd(hul, _mm512_mask_blend_pd(_mm512_cmp_pd_mask(hl, zero, _CMP_GT_OQ), un, hl));
+        __m512d qR = _mm512_div_pd(hur, _mm512_mask_blend_pd(_mm512_cmp_pd_mask(hr, zero, _CMP_GT_OQ), un, hr));
+        __m512d uL = _mm512_maskz_mov_pd(mouilleL, qL);
+        __m512d uR = _mm512_maskz_mov_pd(mouilleR, qR);
+        __m512d cL = _mm512_maskz_mov_pd(mouilleL, _mm512_sqrt_pd(_mm512_mul_pd(vg, hl)));
+        __m512d cR = _mm512_maskz_mov_pd(mouilleR, _mm512_sqrt_pd(_mm512_mul_pd(vg, hr)));
+
+        __m512d FL_hu = _mm512_maskz_mov_pd(mouilleL,
+            _mm512_add_pd(_mm512_mul_pd(hul, qL), _mm512_mul_pd(_mm512_mul_pd(demi_g, hl), hl)));
+        __m512d FR_hu = _mm512_maskz_mov_pd(mouilleR,
+            _mm512_add_pd(_mm512_mul_pd(hur, qR), _mm512_mul_pd(_mm512_mul_pd(demi_g, hr), hr)));
+
+        __m512d lambdaL = _mm512_add_pd(_mm512_abs_pd(uL), cL);
+        __m512d lambdaR = _mm512_add_pd(_mm512_abs_pd(uR), cR);
+        __m512d demi_lambda = _mm512_mul_pd(demi, _mm512_max_pd(lambdaR, lambdaL));
+
+        __m512d fh = _mm512_sub_pd(_mm512_mul_pd(demi, _mm512_add_pd(hul, hur)),
+                                   _mm512_mul_pd(demi_lambda, _mm512_sub_pd(hr, hl)));
+        __m512d fhu = _mm512_sub_pd(_mm512_mul_pd(demi, _mm512_add_pd(FL_hu, FR_hu)),
+                                    _mm512_mul_pd(demi_lambda, _mm512_sub_pd(hur, hul)));
+
+        _mm512_storeu_pd(flux_h + k, fh);
+        _mm512_storeu_pd(flux_hu + k, fhu);
+    }
+
+    FluxRusanovScalaire(n - k, hL + k, huL + k, hR + k, huR + k, flux_h + k, flux_hu + k, g, critere_h);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // SV_X86
+
+
+// ========================================
+// Choix de la version à l'exécution
+// ========================================
+struct JeuNoyaux
+{
+    const char* nom;
+    NoyauFlux hll;
+    NoyauFlux rusanov;
+};
+
+static JeuNoyaux ChoisirMeilleurJeu()
+{
+#ifdef SV_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return { "avx512", FluxHLLAVX512, FluxRusanovAVX512 };
+    if (__builtin_cpu_supports("avx2"))
+        return { "avx2", FluxHLLAVX2, FluxRusanovAVX2 };
+#endif
+    return { "scalaire", FluxHLLScalaire, FluxRusanovScalaire };
+}
+
+// Initialisé une seule fois, au premier appel
+static JeuNoyaux& JeuCourant()
+{
+    static JeuNoyaux jeu = ChoisirMeilleurJeu();
+    return jeu;
+}
+
+
+void FluxHLLLot(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    JeuCourant().hll(n, hL, huL, hR, huR, flux_h, flux_hu, g, critere_h);
+}
+
+
+void FluxRusanovLot(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                    double* flux_h, double* flux_hu, double g, double critere_h)
+{
+    JeuCourant().rusanov(n, hL, huL, hR, huR, flux_h, flux_hu, g, critere_h);
+}
+
+
+const char* NomJeuInstructions()
+{
+    return JeuCourant().nom;
+}
+
+
+bool DefinirJeuInstructions(const char* nom)
+{
+    if (strcmp(nom, "scalaire") == 0)
+    {
+        JeuCourant() = { "scalaire", FluxHLLScalaire, FluxRusanovScalaire };
+        return true;
+    }
+#ifdef SV_X86
+    __builtin_cpu_init();
+    if (strcmp(nom, "avx2") == 0 && __builtin_cpu_supports("avx2"))
+    {
+        JeuCourant() = { "avx2", FluxHLLAVX2, FluxRusanovAVX2 };
+        return true;
+    }
+    if (strcmp(nom, "avx512") == 0 && __builtin_cpu_supports("avx512f"))
+    {
+        JeuCourant() = { "avx512", FluxHLLAVX512, FluxRusanovAVX512 };
+        return true;
+    }
+#endif
+    return false;
+}
@@ -0,0 +1,112 @@
+#ifndef _FLUX_VECTORISE_H
+#define _FLUX_VECTORISE_H
+
+#include <cmath>
+
+// ========================================
+// Flux numériques calculés par lots d'interfaces
+// ========================================
+// Chaque noyau traite n interfaces contiguës : l'interface k a pour état
+// gauche (hL[k], huL[k]) et pour état droit (hR[k], huR[k]).
+// Les résultats sont identiques bit à bit à SaintVenant1D::FluxHLL et
+// SaintVenant1D::FluxRusanov, quel que soit le jeu d'instructions utilisé.
+
+// Signature commune des noyaux
+// g : gravité, critere_h : hauteur en dessous de laquelle la cellule est sèche
+typedef void (*NoyauFlux)(int n,
+                          const double* hL, const double* huL,
+                          const double* hR, const double* huR,
+                          double* flux_h, double* flux_hu,
+                          double g, double critere_h);
+
+// ========================================
+// Flux d'une seule interface (version scalaire sans branchement)
+// ========================================
+// Mêmes opérations, dans le même ordre, que les noyaux vectorisés.
+// hu/h est calculé avec un dénominateur remplacé par 1 dans les cellules sèches,
+// puis le résultat y est mis à 0 ; min/max reproduisent std::min et std::max.
+
+inline void FluxHLLInterface(double hl, double hul, double hr, double hur,
+                             double& flux_h, double& flux_hu, double g, double critere_h)
+{
+    const double demi_g = 0.5 * g;
+
+    // Vitesses et célérités
+    double qL = hul / (hl > 0.0 ? hl : 1.0);
+    double qR = hur / (hr > 0.0 ? hr : 1.0);
+    double uL = (hl > 1e-8) ? qL : 0.0;
+    double uR = (hr > 1e-8) ? qR : 0.0;
+    double cL = std::sqrt(g * hl);
+    double cR = std::sqrt(g * hr);
+
+    double a = uL - cL, b = uR - cR;
+    double S_L = (b < a) ? b : a;
+    a = uL + cL; b = uR + cR;
+    double S_R = (a < b) ? b : a;
+
+    // Flux physiques
+    double FL_h = hul;
+    double FR_h = hur;
+    double FL_hu = (hl > critere_h) ? hul * qL + demi_g * hl * hl : 0.0;
+    double FR_hu = (hr > critere_h) ? hur * qR + demi_g * hr * hr : 0.0;
+
+    // Flux HLL dans l'éventail
+    double denom = S_R - S_L;
+    double fh  = (S_R * FL_h  - S_L * FR_h  + S_L * S_R * (hr - hl)) / denom;
+    double fhu = (S_R * FL_hu - S_L * FR_hu + S_L * S_R * (hur - hul)) / denom;
+
+    // Sélection du cas : S_L >= 0 (supersonique à gauche), S_R <= 0 (à droite), sinon subsonique
+    fh  = (S_R <= 0.0) ? FR_h  : fh;
+    fhu = (S_R <= 0.0) ? FR_hu : fhu;
+    flux_h  = (S_L >= 0.0) ? FL_h  : fh;
+    flux_hu = (S_L >= 0.0) ? FL_hu : fhu;
+}
+
+
+inline void FluxRusanovInterface(double hl, double hul, double hr, double hur,
+                                 double& flux_h, double& flux_hu, double g, double critere_h)
+{
+    const double demi_g = 0.5 * g;
+
+    bool mouilleL = hl > critere_h;
+    bool mouilleR = hr > critere_h;
+
+    double qL = hul / (hl > 0.0 ? hl : 1.0);
+    double qR = hur / (hr > 0.0 ? hr : 1.0);
+    double uL = mouilleL ? qL : 0.0;
+    double uR = mouilleR ? qR : 0.0;
+    double cL = mouilleL ? std::sqrt(g * hl) : 0.0;
+    double cR = mouilleR ? std::sqrt(g * hr) : 0.0;
+
+    double FL_hu = mouilleL ? hul * qL + demi_g * hl * hl : 0.0;
+    double FR_hu = mouilleR ? hur * qR + demi_g * hr * hr : 0.0;
+
+    double lambdaL = std::fabs(uL) + cL;
+    double lambdaR = std::fabs(uR) + cR;
+    double lambda = (lambdaL < lambdaR) ? lambdaR : lambdaL;
+
+    flux_h  = 0.5 * (hul + hur) - 0.5 * lambda * (hr - hl);
+    flux_hu = 0.5 * (FL_hu + FR_hu) - 0.5 * lambda * (hur - hul);
+}
+
+
+// ========================================
+// Flux par lots (version choisie à l'exécution)
+// ========================================
+
+// Flux HLL sur un lot d'interfaces (version choisie à l'exécution)
+void FluxHLLLot(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                double* flux_h, double* flux_hu, double g, double critere_h);
+
+// Flux de Rusanov sur un lot d'interfaces (version choisie à l'exécution)
+void FluxRusanovLot(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                    double* flux_h, double* flux_hu, double g, double critere_h);
+
+// Jeu d'instructions utilisé par les noyaux : "scalaire", "avx2" ou "avx512"
+const char* NomJeuInstructions();
+
+// Forcer un jeu d'instructions (pour comparer les versions)
+// Retourne false si le processeur ne le supporte pas (le choix n'est alors pas modifié)
+bool DefinirJeuInstructions(const char* nom);
+
+#endif // _FLUX_VECTORISE_H
@@ -0,0 +1,149 @@
+// ========================================
+// Frottement de Manning : traitement semi-implicite et explicite
+// ========================================
+// Soliton qui monte sur une plage (pente de 30 m à 75 m) avec un frottement de
+// Manning, plus fort sur le haut de plage (n_plage) qu'au large (n_large). Le terme
+// est raide dans les films minces du rivage : le traitement explicite doit réduire
+// le pas de temps pour rester stable, le semi-implicite garde le pas CFL. Affiche le
+// nombre de pas, le pas moyen et minimal, le temps de calcul et le coût par pas, le
+// runup, la variation de masse et l'écart L1 sur h au traitement semi-implicite.
+// Le bilan met côte à côte, pour chaque traitement, le rapport du nombre de pas et le
+// surcoût par pas : celui du frottement lui-même (fait dans la mise à jour des cellules)
+// par rapport au calcul sans frottement, et celui du passage O(N) de
+// PasFrottementExplicite à chaque pas du traitement explicite.
+//
+// Usage : frottement [N] [t_final] [n_large] [n_plage]
+// (à compiler en Release pour des temps représentatifs)
+
+#include "SaintVenant.h"
+#include "Observateurs.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+enum Frottement { SANS, IMPLICITE, EXPLICITE };
+
+struct Resultat
+{
+    long nb_pas;
+    double dt_moyen;
+    double dt_min;
+    double temps;       // secondes
+    double x_runup;     // position maximale du rivage
+    double H_runup;     // cote de la surface au runup
+    double d_masse;     // masse finale - masse initiale
+    vector<double> h;
+    double dx;
+};
+
+
+static Resultat Calculer(int N, double t_final, double n_large, double n_plage, Frottement frottement)
+{
+    SaintVenant1D solveur;
+    streambuf* sortie = cout.rdbuf(nullptr);
+    solveur.Initialiser(N, 75.0, 0.9, "");
+    solveur.DefinirFondPente(30, 2.5);
+    solveur.ConditionInitialeSoliton(0.3, 12);
+    cout.rdbuf(sortie);
+
+    if (frottement != SANS)
+    {
+        vector<double> n(N);
+        for (int i = 0; i < N; i++)
+            n[i] = ((i + 0.5) * solveur.ObtenirDx() < 55.0) ? n_large : n_plage;
+        solveur.DefinirFrottementParCellule(n);
+        solveur.ChoisirFrottementImplicite(frottement == IMPLICITE);
+    }
+    solveur.ActiverObservateurs(vector<double>(), "", 1, 1e-3);
+
+    double masse_initiale = solveur.CalculerMasseTotale();
+    Resultat r;
+    r.nb_pas = 0;
+    r.dt_min = 1e300;
+
+    auto debut = chrono::steady_clock::now();
+    while (solveur.ObtenirTemps() < t_final)
+    {
+        solveur.Avancer(t_final);
+        r.nb_pas++;
+        // Le dernier pas est raccourci pour finir à t_final : pas compté dans dt_min
+        if (solveur.ObtenirTemps() < t_final)
+            r.dt_min = min(r.dt_min, solveur.ObtenirDt());
+    }
+    auto fin = chrono::steady_clock::now();
+
+    r.temps = chrono::duration<double>(fin - debut).count();
+    r.dt_moyen = solveur.ObtenirTemps() / max(r.nb_pas, 1L);
+    r.x_runup = solveur.ObtenirObservateurs()->ObtenirXRunup();
+    r.H_runup = solveur.ObtenirObservateurs()->ObtenirHRunup();
+    r.d_masse = solveur.CalculerMasseTotale() - masse_initiale;
+    r.h = solveur.ObtenirH();
+    r.dx = solveur.ObtenirDx();
+    return r;
+}
+
+
+int main(int argc, char** argv)
+{
+    int N = (argc > 1) ? atoi(argv[1]) : 3000;
+    double t_final = (argc > 2) ? atof(argv[2]) : 15.0;
+    double n_large = (argc > 3) ? atof(argv[3]) : 0.02;
+    double n_plage = (argc > 4) ? atof(argv[4]) : 0.035;
+
+    cout << "Frottement de Manning sur la plage : N = " << N << ", t = " << t_final << " s, n = "
+         << n_large << " (large) / " << n_plage << " (plage)" << endl;
+    cout << setw(12) << "frottement" << setw(10) << "pas" << setw(14) << "dt moyen" << setw(14) << "dt min"
+         << setw(12) << "temps (s)" << setw(12) << "us/pas" << setw(12) << "runup x" << setw(12) << "runup H"
+         << setw(16) << "masse (var.)" << setw(16) << "ecart L1 h" << endl;
+
+    const char* noms[3] = { "sans", "implicite", "explicite" };
+    Resultat resultats[3];
+    for (int k = 0; k < 3; k++)
+        resultats[k] = Calculer(N, t_final, n_large, n_plage, (Frottement)k);
+
+    for (int k = 0; k < 3; k++)
+    {
+        const Resultat& r = resultats[k];
+        double ecart = 0.0;
+        if (k != IMPLICITE)
+            for (size_t i = 0; i < r.h.size(); i++)
+                ecart += fabs(r.h[i] - resultats[IMPLICITE].h[i]) * r.dx;
+
+        cout << setw(12) << noms[k] << setw(10) << r.nb_pas
+             << setw(14) << scientific << setprecision(3) << r.dt_moyen << setw(14) << r.dt_min
+             << setw(12) << fixed << setprecision(4) << r.temps
+             << setw(12) << setprecision(1) << 1e6 * r.temps / r.nb_pas
+             << setw(12) << setprecision(3) << r.x_runup << setw(12) << setprecision(4) << r.H_runup
+             << setw(16) << scientific << setprecision(3) << r.d_masse;
+        if (k == IMPLICITE)
+            cout << setw(16) << "-" << endl;
+        else
+            cout << setw(16) << ecart << endl;
+    }
+
+    // Coût par pas en microsecondes
+    double par_pas[3];
+    for (int k = 0; k < 3; k++)
+        par_pas[k] = 1e6 * resultats[k].temps / resultats[k].nb_pas;
+
+    const Resultat& implicite = resultats[IMPLICITE];
+    const Resultat& explicite = resultats[EXPLICITE];
+    double rapport_pas = (double)explicite.nb_pas / implicite.nb_pas;
+    cout << fixed << setprecision(2);
+    // Gain sur le nombre de pas et surcoût par pas côte à côte
+    cout << "Semi-implicite : " << rapport_pas << " fois moins de pas que l'explicite, surcoût du frottement "
+         << setprecision(1) << par_pas[IMPLICITE] - par_pas[SANS] << " us/pas (" << setprecision(2)
+         << par_pas[IMPLICITE] / par_pas[SANS] << " fois le pas sans frottement)" << endl;
+    cout << "Explicite : " << rapport_pas << " fois plus de pas (pas de temps limité par le frottement), surcoût "
+         << setprecision(1) << par_pas[EXPLICITE] - par_pas[IMPLICITE] << " us/pas sur le semi-implicite ("
+         << setprecision(2) << par_pas[EXPLICITE] / par_pas[IMPLICITE] << " fois, PasFrottementExplicite)" << endl;
+    cout << "Explicite, temps total : " << explicite.temps / implicite.temps
+         << " fois celui du semi-implicite" << endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "Instrumentation.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+
+static const char* NOMS_PHASES[NB_PHASES] = {
+    "avancer", "pas_de_temps", "flux", "mise_a_jour", "limites", "nettoyage", "diagnostics", "sauvegarde",
+};
+
+static const char* NOMS_COMPTEURS[NB_COMPTEURS] = {
+    "hll_supersonique_gauche", "hll_supersonique_droite", "hll_subsonique", "interfaces_seches",
+    "cellules_seches", "ecretages", "pas",
+};
+
+
+Instrumentation::Instrumentation()
+{
+    Reinitialiser();
+}
+
+
+void Instrumentation::Reinitialiser()
+{
+    _origine = chrono::steady_clock::now();
+    for (int p = 0; p < NB_PHASES; p++)
+    {
+        _total_ns[p] = 0;
+        _appels[p] = 0;
+    }
+    for (int c = 0; c < NB_COMPTEURS; c++)
+        _compteurs[c] = 0;
+    for (int k = 0; k < NB_CLASSES; k++)
+        _histogramme_dt[k] = 0;
+    _evenements.clear();
+    _evenements_perdus = 0;
+}
+
+
+const char* Instrumentation::NomPhase(int phase)
+{
+    return NOMS_PHASES[phase];
+}
+
+
+const char* Instrumentation::NomCompteur(int compteur)
+{
+    return NOMS_COMPTEURS[compteur];
+}
+
+
+void Instrumentation::AjouterEvenement(const Evenement& evenement)
+{
+    if (_evenements.size() < MAX_EVENEMENTS)
+        _evenements.push_back(evenement);
+    else
+        _evenements_perdus++;
+}
+
+
+void Instrumentation::AjouterPhase(int phase, int64_t debut_ns, int64_t fin_ns)
+{
+    _total_ns[phase] += fin_ns - debut_ns;
+    _appels[phase]++;
+    AjouterEvenement({ phase, debut_ns, fin_ns - debut_ns, 0.0 });
+}
+
+
+void Instrumentation::EnregistrerPasDeTemps(double dt)
+{
+    int exposant;
+    frexp(dt, &exposant);  // dt dans [2^(exposant-1), 2^exposant)
+    int k = min(max(exposant - EXPOSANT_MIN, 0), NB_CLASSES - 1);
+    _histogramme_dt[k]++;
+    _compteurs[COMPTEUR_PAS]++;
+    AjouterEvenement({ -1, Maintenant(), 0, dt });
+}
+
+
+void Instrumentation::ClasserInterfaces(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                                        double g, double critere_h)
+{
+    long gauche = 0, droite = 0, subsonique = 0, seches = 0;
+    for (int k = 0; k < n; k++)
+    {
+        double uL = (hL[k] > 1e-8) ? huL[k] / hL[k] : 0.0;
+        double uR = (hR[k] > 1e-8) ? huR[k] / hR[k] : 0.0;
+        double cL = sqrt(g * hL[k]);
+        double cR = sqrt(g * hR[k]);
+        double S_L = min(uL - cL, uR - cR);
+        double S_R = max(uL + cL, uR + cR);
+
+        seches += (hL[k] <= critere_h && hR[k] <= critere_h);
+        if (S_L >= 0.0)
+            gauche++;
+        else if (S_R <= 0.0)
+            droite++;
+        else
+            subsonique++;
+    }
+    Compter(COMPTEUR_HLL_GAUCHE, gauche);
+    Compter(COMPTEUR_HLL_DROITE, droite);
+    Compter(COMPTEUR_HLL_SUBSONIQUE, subsonique);
+    Compter(COMPTEUR_INTERFACES_SECHES, seches);
+}
+
+
+bool Instrumentation::EcrireCSV(const string& nom_fichier) const
+{
+    ofstream csv(nom_fichier);
+    if (!csv.is_open())
+    {
+        cout << "Erreur : impossible d'ecrire '" << nom_fichier << "'" << endl;
+        return false;
+    }
+
+    csv << "categorie,nom,nombre,total_s\n";
+    csv << setprecision(9);
+    for (int p = 0; p < NB_PHASES; p++)
+        csv << "phase," << NOMS_PHASES[p] << "," << _appels[p] << "," << _total_ns[p] * 1e-9 << "\n";
+    for (int c = 0; c < NB_COMPTEURS; c++)
+        csv << "compteur," << NOMS_COMPTEURS[c] << "," << _compteurs[c].load() << ",\n";
+    for (int k = 0; k < NB_CLASSES; k++)
+    {
+        // Classe [2^(e-1), 2^e), nommée par sa borne inférieure
+        if (_histogramme_dt[k] > 0)
+            csv << "dt," << ldexp(1.0, k + EXPOSANT_MIN - 1) << "," << _histogramme_dt[k] << ",\n";
+    }
+    return true;
+}
+
+
+bool Instrumentation::EcrireTraceChrome(const string& nom_fichier) const
+{
+    ofstream json(nom_fichier);
+    if (!json.is_open())
+    {
+        cout << "Erreur : impossible d'ecrire '" << nom_fichier << "'" << endl;
+        return false;
+    }
+
+    // Temps en microsecondes ; "X" : phase complète, "C" : courbe
+    json << "{\"traceEvents\":[\n";
+    json << fixed << setprecision(3);
+    for (size_t k = 0; k < _evenements.size(); k++)
+    {
+        const Evenement& e = _evenements[k];
+        if (e.phase >= 0)
+            json << "{\"name\":\"" << NOMS_PHASES[e.phase] << "\",\"cat\":\"saintvenant\",\"ph\":\"X\",\"ts\":"
+                 << e.debut_ns * 1e-3 << ",\"dur\":" << e.duree_ns * 1e-3 << ",\"pid\":0,\"tid\":0}";
+        else
+            json << "{\"name\":\"dt\",\"ph\":\"C\",\"ts\":" << e.debut_ns * 1e-3 << ",\"pid\":0,\"args\":{\"dt\":"
+                 << scientific << e.dt << fixed << "}}";
+        json << ",\n";
+    }
+
+    // Compteurs en fin de trace, et événements non enregistrés
+    json << "{\"name\":\"compteurs\",\"ph\":\"i\",\"s\":\"g\",\"ts\":" << Maintenant() * 1e-3 << ",\"pid\":0,\"tid\":0,\"args\":{";
+    for (int c = 0; c < NB_COMPTEURS; c++)
+        json << "\"" << NOMS_COMPTEURS[c] << "\":" << _compteurs[c].load() << ",";
+    json << "\"evenements_perdus\":" << _evenements_perdus << "}}\n";
+    json << "],\"displayTimeUnit\":\"ms\"}\n";
+    return true;
+}
+
+
+void Instrumentation::Afficher(ostream& sortie) const
+{
+    double total = _total_ns[PHASE_AVANCER] > 0 ? (double)_total_ns[PHASE_AVANCER] : 1.0;
+    sortie << "Instrumentation :" << endl;
+    sortie << "  " << left << setw(16) << "phase" << right << setw(10) << "appels" << setw(12) << "total (s)"
+           << setw(14) << "moyenne (us)" << setw(10) << "% pas" << endl;
+    for (int p = 0; p < NB_PHASES; p++)
+    {
+        if (_appels[p] == 0)
+            continue;
+        sortie << "  " << left << setw(16) << NOMS_PHASES[p] << right << setw(10) << _appels[p]
+               << setw(12) << fixed << setprecision(4) << _total_ns[p] * 1e-9
+               << setw(14) << setprecision(2) << _total_ns[p] * 1e-3 / _appels[p];
+        if (p != PHASE_SAUVEGARDE)
+            sortie << setw(10) << setprecision(1) << 100.0 * _total_ns[p] / total;
+        sortie << endl;
+    }
+    for (int c = 0; c < NB_COMPTEURS; c++)
+        sortie << "  " << left << setw(26) << NOMS_COMPTEURS[c] << right << setw(14) << _compteurs[c].load() << endl;
+    for (int k = 0; k < NB_CLASSES; k++)
+        if (_histogramme_dt[k] > 0)
+            sortie << "  dt dans [" << scientific << setprecision(3) << ldexp(1.0, k + EXPOSANT_MIN - 1) << ", "
+                   << ldexp(1.0, k + EXPOSANT_MIN) << ") : " << _histogramme_dt[k] << endl;
+    sortie << defaultfloat;
+}
@@ -0,0 +1,142 @@
+#ifndef _INSTRUMENTATION_H
+#define _INSTRUMENTATION_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// ========================================
+// Instrumentation du pas de temps
+// ========================================
+// Compilée dans SaintVenant1D seulement si SV_INSTRUMENTATION est défini
+// (cmake -DINSTRUMENTATION=ON). Sans cette définition, les macros SV_PHASE,
+// SV_COMPTER et SV_INSTRUMENTER ci-dessous ne produisent aucun code.
+//
+//   - minuteurs de phases : temps écoulé (horloge du thread appelant, les phases
+//     parallèles sont mesurées autour de tout le balayage), nombre d'appels, et un
+//     événement par appel pour la trace Chrome (limité à MAX_EVENEMENTS) ;
+//   - compteurs : régime des interfaces pour HLL (supersonique à gauche S_L >= 0,
+//     à droite S_R <= 0, subsonique), interfaces sèches des deux côtés, cellules
+//     sèches après nettoyage et écrêtages (cellule mise à zéro alors qu'elle ne
+//     l'était pas), nombre de pas ;
+//   - histogramme des pas de temps par puissances de 2.
+// Export : CSV (une ligne par phase, compteur et classe de dt) ou trace Chrome
+// (chrome://tracing, ui.perfetto.dev), avec dt en courbe.
+
+enum PhaseInstrumentation
+{
+    PHASE_AVANCER,         // Pas complet (toutes les phases ci-dessous)
+    PHASE_PAS_DE_TEMPS,    // Condition CFL (réduction de la vitesse max si nécessaire)
+    PHASE_FLUX,            // Reconstruction et flux des interfaces
+    PHASE_MISE_A_JOUR,     // Termes sources et mise à jour des cellules (même boucle)
+    PHASE_LIMITES,         // Conditions aux limites
+    PHASE_NETTOYAGE,       // Cellules sèches et vitesse max du nouvel état
+    PHASE_DIAGNOSTICS,     // Passage de diagnostics (nettoyage compris en ligne)
+    PHASE_SAUVEGARDE,      // Ecriture de l'état
+    NB_PHASES
+};
+
+enum CompteurInstrumentation
+{
+    COMPTEUR_HLL_GAUCHE,        // S_L >= 0 : flux de l'état gauche
+    COMPTEUR_HLL_DROITE,        // S_R <= 0 : flux de l'état droit
+    COMPTEUR_HLL_SUBSONIQUE,    // S_L < 0 < S_R : formule HLL
+    COMPTEUR_INTERFACES_SECHES, // Les deux côtés secs
+    COMPTEUR_CELLULES_SECHES,   // Cellules sèches après chaque nettoyage (cumulées, deux par pas en ordre 2)
+    COMPTEUR_ECRETAGES,         // Cellules remises à zéro par le nettoyage
+    COMPTEUR_PAS,
+    NB_COMPTEURS
+};
+
+class Instrumentation
+{
+private:
+    struct Evenement
+    {
+        int phase;          // -1 : valeur de dt
+        int64_t debut_ns;
+        int64_t duree_ns;
+        double dt;
+    };
+
+    // Classes de l'histogramme : dt dans [2^(e-1), 2^e) pour e = EXPOSANT_MIN .. EXPOSANT_MIN + NB_CLASSES - 1
+    static const int EXPOSANT_MIN = -40;
+    static const int NB_CLASSES = 48;
+    static const size_t MAX_EVENEMENTS = 1 << 20;
+
+    std::chrono::steady_clock::time_point _origine;
+    int64_t _total_ns[NB_PHASES];
+    long _appels[NB_PHASES];
+    std::atomic<long> _compteurs[NB_COMPTEURS];
+    long _histogramme_dt[NB_CLASSES];
+    std::vector<Evenement> _evenements;
+    long _evenements_perdus;
+
+    void AjouterEvenement(const Evenement& evenement);
+
+public:
+    Instrumentation();
+
+    // Remet minuteurs, compteurs et histogramme à zéro
+    void Reinitialiser();
+
+    // Nanosecondes depuis le dernier Reinitialiser
+    int64_t Maintenant() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _origine).count();
+    }
+
+    void AjouterPhase(int phase, int64_t debut_ns, int64_t fin_ns);
+
+    // Utilisable depuis plusieurs threads (un appel par morceau de domaine)
+    void Compter(int compteur, long n) { _compteurs[compteur].fetch_add(n, std::memory_order_relaxed); }
+
+    // Un pas de temps de plus : histogramme, courbe de la trace et compteur de pas
+    void EnregistrerPasDeTemps(double dt);
+
+    // Régime HLL (vitesses d'ondes de Davis, comme FluxHLLInterface) de n interfaces
+    void ClasserInterfaces(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                           double g, double critere_h);
+
+    // Exports ; retournent false si le fichier ne peut pas être écrit
+    bool EcrireCSV(const std::string& nom_fichier) const;
+    bool EcrireTraceChrome(const std::string& nom_fichier) const;
+    void Afficher(std::ostream& sortie) const;
+
+    static const char* NomPhase(int phase);
+    static const char* NomCompteur(int compteur);
+};
+
+
+// Minuteur d'une phase : de la construction à la fin du bloc
+class ChronoPhase
+{
+private:
+    Instrumentation& _instrumentation;
+    int _phase;
+    int64_t _debut;
+
+public:
+    ChronoPhase(Instrumentation& instrumentation, int phase)
+        : _instrumentation(instrumentation), _phase(phase), _debut(instrumentation.Maintenant()) {}
+    ~ChronoPhase() { _instrumentation.AjouterPhase(_phase, _debut, _instrumentation.Maintenant()); }
+};
+
+
+#define SV_CONCATENER_(a, b) a##b
+#define SV_CONCATENER(a, b) SV_CONCATENER_(a, b)
+
+#ifdef SV_INSTRUMENTATION
+#define SV_PHASE(instrumentation, phase) ChronoPhase SV_CONCATENER(chrono_phase_, __LINE__)(instrumentation, phase)
+#define SV_COMPTER(instrumentation, compteur, n) (instrumentation).Compter(compteur, n)
+#define SV_INSTRUMENTER(instruction) instruction
+#else
+#define SV_PHASE(instrumentation, phase)
+#define SV_COMPTER(instrumentation, compteur, n)
+#define SV_INSTRUMENTER(instruction)
+#endif
+
+#endif // _INSTRUMENTATION_H
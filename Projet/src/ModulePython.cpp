@@ -0,0 +1,540 @@
+// ========================================
+// Module Python saintvenant (cmake -DPYTHON=ON)
+// ========================================
+// Pilote un SaintVenant1D depuis Python, sans passer par solution.txt :
+//
+//     import numpy as np, saintvenant
+//     sv = saintvenant.SaintVenant1D()
+//     sv.Initialiser(1100, 75.0, 0.9)           # fichier de sortie facultatif
+//     sv.DefinirFondPentePuisPlat(35, 50, 2)
+//     sv.ConditionInitialeSoliton(0.2, 20)
+//     while sv.t < 10:
+//         sv.Avancer(200, t_final=10)           # 200 pas, calcul sans le GIL
+//         h = np.asarray(sv.h)                  # vue sur l'état du solveur, sans copie
+//         print(sv.t, h.max())
+//         del h                                 # avant le pas suivant (voir plus bas)
+//
+// h, hu et zb sont des memoryview en lecture seule (format 'd') directement sur les
+// tableaux du solveur ; np.asarray en fait des tableaux numpy sans copie. Avancer
+// échange les tampons de l'état : une vue de h ou hu gardée après un pas montrerait
+// un état périmé. Avancer est donc refusé (BufferError) tant qu'une vue de h ou hu
+// existe : la libérer (del, ou with sv.h as h:) et la redemander après le pas, ou
+// garder une copie (np.array(sv.h)). La vue de zb reste valide pendant les pas.
+// Initialiser, qui réalloue l'état, est refusé tant qu'une vue existe.
+//
+// Les méthodes qui lisent ou modifient l'état (fond, condition initiale, Avancer,
+// Sauvegarder, diagnostics, h, hu, zb) lèvent RuntimeError avant Initialiser.
+//
+// Pendant Avancer, le GIL est rendu : les autres threads Python continuent, mais
+// toute autre méthode de ce solveur lève RuntimeError jusqu'à la fin du calcul.
+// Les erreurs signalées par le solveur (schéma inconnu, profil illisible...) lèvent
+// ValueError, après le message habituel sur la sortie standard.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "SaintVenant.h"
+#include <cmath>
+#include <new>
+#include <algorithm>
+
+using namespace std;
+
+// Pas calculés entre deux vérifications des signaux (Ctrl-C) pendant Avancer
+static const long PAS_ENTRE_SIGNAUX = 64;
+
+enum Champ { CHAMP_H, CHAMP_HU, CHAMP_ZB };
+
+struct ObjetSolveur
+{
+    PyObject_HEAD
+    SaintVenant1D* solveur;
+    Py_ssize_t nb_vues;        // Buffers exportés et pas encore rendus
+    Py_ssize_t nb_vues_etat;   // Dont ceux de h et hu (périmés après un pas)
+    bool occupe;          // Avancer en cours (GIL rendu)
+};
+
+struct ObjetVue
+{
+    PyObject_HEAD
+    ObjetSolveur* proprietaire;
+    Champ champ;
+    Py_ssize_t taille;     // N, au moment de la création de la vue
+    Py_ssize_t pas;        // sizeof(double), pour strides
+};
+
+static PyTypeObject TypeSolveur = { PyVarObject_HEAD_INIT(nullptr, 0) };
+static PyTypeObject TypeVue = { PyVarObject_HEAD_INIT(nullptr, 0) };
+
+
+// Lève RuntimeError si un Avancer est en cours sur ce solveur
+static bool VerifierLibre(ObjetSolveur* self)
+{
+    if (self->occupe)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "calcul en cours (Avancer) sur ce solveur");
+        return false;
+    }
+    return true;
+}
+
+
+// Libre, et RuntimeError si Initialiser n'a pas encore été appelé (état vide)
+static bool VerifierInitialise(ObjetSolveur* self)
+{
+    if (!VerifierLibre(self))
+        return false;
+    if (self->solveur->ObtenirH().empty())
+    {
+        PyErr_SetString(PyExc_RuntimeError, "solveur non initialise (appeler Initialiser d'abord)");
+        return false;
+    }
+    return true;
+}
+
+
+// ========================================
+// Vues en lecture seule sur h, hu et zb (protocole buffer)
+// ========================================
+static int Vue_getbuffer(ObjetVue* self, Py_buffer* vue, int flags)
+{
+    if (flags & PyBUF_WRITABLE)
+    {
+        PyErr_SetString(PyExc_BufferError, "vue en lecture seule de l'etat du solveur");
+        return -1;
+    }
+    SaintVenant1D& solveur = *self->proprietaire->solveur;
+    const vector<double>& tableau = (self->champ == CHAMP_H) ? solveur.ObtenirH()
+                                  : (self->champ == CHAMP_HU) ? solveur.ObtenirHu() : solveur.ObtenirZb();
+    if ((Py_ssize_t)tableau.size() != self->taille)
+    {
+        PyErr_SetString(PyExc_BufferError, "vue perimee (solveur reinitialise), la redemander");
+        return -1;
+    }
+
+    vue->buf = (void*)tableau.data();
+    vue->obj = (PyObject*)self;
+    Py_INCREF(self);
+    vue->len = self->taille * (Py_ssize_t)sizeof(double);
+    vue->readonly = 1;
+    vue->itemsize = sizeof(double);
+    vue->format = (flags & PyBUF_FORMAT) ? (char*)"d" : nullptr;
+    vue->ndim = 1;
+    vue->shape = (flags & PyBUF_ND) ? &self->taille : nullptr;
+    vue->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &self->pas : nullptr;
+    vue->suboffsets = nullptr;
+    vue->internal = nullptr;
+    self->proprietaire->nb_vues++;
+    if (self->champ != CHAMP_ZB)
+        self->proprietaire->nb_vues_etat++;
+    return 0;
+}
+
+
+static void Vue_releasebuffer(ObjetVue* self, Py_buffer*)
+{
+    self->proprietaire->nb_vues--;
+    if (self->champ != CHAMP_ZB)
+        self->proprietaire->nb_vues_etat--;
+}
+
+
+static void Vue_dealloc(ObjetVue* self)
+{
+    Py_XDECREF(self->proprietaire);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+
+static PyBufferProcs BufferVue = { (getbufferproc)Vue_getbuffer, (releasebufferproc)Vue_releasebuffer };
+
+
+// memoryview sur un champ ; l'objet vue garde le solveur en vie
+static PyObject* CreerVue(ObjetSolveur* self, Champ champ)
+{
+    if (!VerifierInitialise(self))
+        return nullptr;
+    ObjetVue* vue = PyObject_New(ObjetVue, &TypeVue);
+    if (vue == nullptr)
+        return nullptr;
+    Py_INCREF(self);
+    vue->proprietaire = self;
+    vue->champ = champ;
+    vue->taille = (Py_ssize_t)self->solveur->ObtenirH().size();
+    vue->pas = sizeof(double);
+    PyObject* memoire = PyMemoryView_FromObject((PyObject*)vue);
+    Py_DECREF(vue);
+    return memoire;
+}
+
+
+// ========================================
+// Solveur
+// ========================================
+static PyObject* Solveur_new(PyTypeObject* type, PyObject*, PyObject*)
+{
+    ObjetSolveur* self = (ObjetSolveur*)type->tp_alloc(type, 0);
+    if (self == nullptr)
+        return nullptr;
+    self->solveur = new (nothrow) SaintVenant1D();
+    if (self->solveur == nullptr)
+    {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    self->nb_vues = 0;
+    self->nb_vues_etat = 0;
+    self->occupe = false;
+    return (PyObject*)self;
+}
+
+
+static void Solveur_dealloc(ObjetSolveur* self)
+{
+    delete self->solveur;
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+
+static PyObject* Solveur_Initialiser(ObjetSolveur* self, PyObject* args, PyObject* kwds)
+{
+    static const char* mots[] = { "N", "L", "CFL", "fichier", nullptr };
+    int N;
+    double L, CFL;
+    const char* fichier = "";
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "idd|s", (char**)mots, &N, &L, &CFL, &fichier))
+        return nullptr;
+    if (!VerifierLibre(self))
+        return nullptr;
+    if (self->nb_vues > 0)
+    {
+        PyErr_SetString(PyExc_BufferError, "des vues sur l'etat existent encore (les liberer avant Initialiser)");
+        return nullptr;
+    }
+    if (N < 3 || !(L > 0.0) || !(CFL > 0.0))
+    {
+        PyErr_SetString(PyExc_ValueError, "N >= 3, L > 0 et CFL > 0 attendus");
+        return nullptr;
+    }
+    self->solveur->Initialiser(N, L, CFL, fichier);
+    Py_RETURN_NONE;
+}
+
+
+// Appelle une méthode du solveur qui retourne false en cas d'erreur
+template <class Fonction>
+static PyObject* AppelerVerifie(ObjetSolveur* self, Fonction f, const char* message)
+{
+    if (!VerifierLibre(self))
+        return nullptr;
+    if (!f(*self->solveur))
+    {
+        PyErr_SetString(PyExc_ValueError, message);
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_ChoisirSchema(ObjetSolveur* self, PyObject* args)
+{
+    const char* config;
+    if (!PyArg_ParseTuple(args, "s", &config))
+        return nullptr;
+    return AppelerVerifie(self, [&](SaintVenant1D& s) { return s.ChoisirSchema(config); }, "schema inconnu ou source pente a l'ordre 2");
+}
+
+
+static PyObject* Solveur_ChoisirOrdre(ObjetSolveur* self, PyObject* args)
+{
+    int ordre;
+    const char* limiteur = "minmod";
+    if (!PyArg_ParseTuple(args, "i|s", &ordre, &limiteur))
+        return nullptr;
+    return AppelerVerifie(self, [&](SaintVenant1D& s) { return s.ChoisirOrdre(ordre, limiteur); },
+                          "ordre ou limiteur inconnu, ou source pente a l'ordre 2");
+}
+
+
+static PyObject* Solveur_DefinirNombreThreads(ObjetSolveur* self, PyObject* args)
+{
+    int nb_threads;
+    if (!PyArg_ParseTuple(args, "i", &nb_threads) || !VerifierLibre(self))
+        return nullptr;
+    self->solveur->DefinirNombreThreads(nb_threads);
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_DefinirFondPlat(ObjetSolveur* self, PyObject*)
+{
+    if (!VerifierInitialise(self))
+        return nullptr;
+    self->solveur->DefinirFondPlat();
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_DefinirFondPente(ObjetSolveur* self, PyObject* args)
+{
+    double x_debut, z_fin;
+    if (!PyArg_ParseTuple(args, "dd", &x_debut, &z_fin) || !VerifierInitialise(self))
+        return nullptr;
+    self->solveur->DefinirFondPente(x_debut, z_fin);
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_DefinirFondMarche(ObjetSolveur* self, PyObject* args)
+{
+    double x_marche, z_haut;
+    if (!PyArg_ParseTuple(args, "dd", &x_marche, &z_haut) || !VerifierInitialise(self))
+        return nullptr;
+    self->solveur->DefinirFondMarche(x_marche, z_haut);
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_DefinirFondPentePuisPlat(ObjetSolveur* self, PyObject* args)
+{
+    double x_debut, x_fin, z_fin;
+    if (!PyArg_ParseTuple(args, "ddd", &x_debut, &x_fin, &z_fin) || !VerifierInitialise(self))
+        return nullptr;
+    self->solveur->DefinirFondPentePuisPlat(x_debut, x_fin, z_fin);
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_DefinirFondDoublePente(ObjetSolveur* self, PyObject* args)
+{
+    double x_debut, x_cassure, z_cassure, z_fin;
+    if (!PyArg_ParseTuple(args, "dddd", &x_debut, &x_cassure, &z_cassure, &z_fin) || !VerifierInitialise(self))
+        return nullptr;
+    self->solveur->DefinirFondDoublePente(x_debut, x_cassure, z_cassure, z_fin);
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_ChargerFond(ObjetSolveur* self, PyObject* args)
+{
+    const char* nom_fichier;
+    double x_debut = 0.0;
+    if (!PyArg_ParseTuple(args, "s|d", &nom_fichier, &x_debut) || !VerifierInitialise(self))
+        return nullptr;
+    return AppelerVerifie(self, [&](SaintVenant1D& s) { return s.ChargerFond(nom_fichier, x_debut); },
+                          "profil de bathymetrie illisible");
+}
+
+
+static PyObject* Solveur_ConditionInitialeSoliton(ObjetSolveur* self, PyObject* args)
+{
+    double A, x_depart;
+    if (!PyArg_ParseTuple(args, "dd", &A, &x_depart) || !VerifierInitialise(self))
+        return nullptr;
+    self->solveur->ConditionInitialeSoliton(A, x_depart);
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_ConditionInitialeDamBreak(ObjetSolveur* self, PyObject*)
+{
+    if (!VerifierInitialise(self))
+        return nullptr;
+    self->solveur->ConditionInitialeDamBreak();
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_ConditionInitialeGaussienne(ObjetSolveur* self, PyObject* args)
+{
+    double amplitude, position_x, largeur, vitesse_init;
+    if (!PyArg_ParseTuple(args, "dddd", &amplitude, &position_x, &largeur, &vitesse_init) || !VerifierInitialise(self))
+        return nullptr;
+    self->solveur->ConditionInitialeGaussienne(amplitude, position_x, largeur, vitesse_init);
+    Py_RETURN_NONE;
+}
+
+
+// Avancer(n_pas=1, t_final=None) : n_pas pas, ou moins si t_final est atteint (le
+// dernier pas est alors raccourci pour finir exactement à t_final). Retourne le
+// nombre de pas faits.
+static PyObject* Solveur_Avancer(ObjetSolveur* self, PyObject* args, PyObject* kwds)
+{
+    static const char* mots[] = { "n_pas", "t_final", nullptr };
+    long n_pas = 1;
+    PyObject* objet_t_final = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|lO", (char**)mots, &n_pas, &objet_t_final))
+        return nullptr;
+    double t_final = HUGE_VAL;
+    if (objet_t_final != Py_None)
+    {
+        t_final = PyFloat_AsDouble(objet_t_final);
+        if (t_final == -1.0 && PyErr_Occurred())
+            return nullptr;
+    }
+    if (!VerifierInitialise(self))
+        return nullptr;
+    if (self->nb_vues_etat > 0)
+    {
+        PyErr_SetString(PyExc_BufferError,
+                        "des vues sur h ou hu existent encore : elles seraient perimees apres le pas "
+                        "(les liberer, ou garder une copie avec np.array)");
+        return nullptr;
+    }
+
+    SaintVenant1D* solveur = self->solveur;
+    long fait = 0;
+    self->occupe = true;
+    while (fait < n_pas && solveur->ObtenirTemps() < t_final)
+    {
+        long fin = min(n_pas, fait + PAS_ENTRE_SIGNAUX);
+        Py_BEGIN_ALLOW_THREADS
+        for (; fait < fin && solveur->ObtenirTemps() < t_final; fait++)
+            solveur->Avancer(t_final);
+        Py_END_ALLOW_THREADS
+        if (PyErr_CheckSignals() < 0)
+        {
+            self->occupe = false;
+            return nullptr;
+        }
+    }
+    self->occupe = false;
+    return PyLong_FromLong(fait);
+}
+
+
+static PyObject* Solveur_Sauvegarder(ObjetSolveur* self, PyObject*)
+{
+    if (!VerifierInitialise(self))
+        return nullptr;
+    self->solveur->Sauvegarder();
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_DefinirIntervalleSorties(ObjetSolveur* self, PyObject* args)
+{
+    double intervalle;
+    if (!PyArg_ParseTuple(args, "d", &intervalle) || !VerifierLibre(self))
+        return nullptr;
+    self->solveur->DefinirIntervalleSorties(intervalle);
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* Solveur_CalculerDiagnostics(ObjetSolveur* self, PyObject*)
+{
+    if (!VerifierInitialise(self))
+        return nullptr;
+    Diagnostics d = self->solveur->CalculerDiagnostics();
+    return Py_BuildValue("{s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d}",
+                         "t", d.t, "masse", d.masse, "energie", d.energie, "surface_max", d.surface_max,
+                         "hauteur_max", d.hauteur_max, "x_crete", d.x_crete,
+                         "longueur_mouillee", d.longueur_mouillee, "froude_max", d.froude_max,
+                         "froude_front", d.froude_front,
+                         "x_rivage", d.x_rivage);
+}
+
+
+static PyObject* Solveur_get_h(ObjetSolveur* self, void*) { return CreerVue(self, CHAMP_H); }
+static PyObject* Solveur_get_hu(ObjetSolveur* self, void*) { return CreerVue(self, CHAMP_HU); }
+static PyObject* Solveur_get_zb(ObjetSolveur* self, void*) { return CreerVue(self, CHAMP_ZB); }
+static PyObject* Solveur_get_t(ObjetSolveur* self, void*) { return PyFloat_FromDouble(self->solveur->ObtenirTemps()); }
+static PyObject* Solveur_get_dt(ObjetSolveur* self, void*) { return PyFloat_FromDouble(self->solveur->ObtenirDt()); }
+static PyObject* Solveur_get_dx(ObjetSolveur* self, void*) { return PyFloat_FromDouble(self->solveur->ObtenirDx()); }
+static PyObject* Solveur_get_N(ObjetSolveur* self, void*)
+{
+    return PyLong_FromSize_t(self->solveur->ObtenirH().size());
+}
+
+
+static PyMethodDef MethodesSolveur[] = {
+    { "Initialiser", (PyCFunction)(void(*)(void))Solveur_Initialiser, METH_VARARGS | METH_KEYWORDS,
+      "Initialiser(N, L, CFL, fichier='') : domaine [0, L] de N cellules, sortie de Sauvegarder facultative" },
+    { "ChoisirSchema", (PyCFunction)Solveur_ChoisirSchema, METH_VARARGS,
+      "ChoisirSchema('flux/source') : flux rusanov, hll (hllc : alias de hll) ; source hydrostatique, pente" },
+    { "ChoisirOrdre", (PyCFunction)Solveur_ChoisirOrdre, METH_VARARGS,
+      "ChoisirOrdre(ordre, limiteur='minmod') : 1 ou 2 (minmod, vanleer, mc ; source hydrostatique seulement)" },
+    { "DefinirNombreThreads", (PyCFunction)Solveur_DefinirNombreThreads, METH_VARARGS,
+      "DefinirNombreThreads(n) : threads du calcul (résultats identiques bit à bit)" },
+    { "DefinirFondPlat", (PyCFunction)Solveur_DefinirFondPlat, METH_NOARGS, "Fond plat" },
+    { "DefinirFondPente", (PyCFunction)Solveur_DefinirFondPente, METH_VARARGS,
+      "DefinirFondPente(x_debut, z_fin)" },
+    { "DefinirFondMarche", (PyCFunction)Solveur_DefinirFondMarche, METH_VARARGS,
+      "DefinirFondMarche(x_marche, z_haut)" },
+    { "DefinirFondPentePuisPlat", (PyCFunction)Solveur_DefinirFondPentePuisPlat, METH_VARARGS,
+      "DefinirFondPentePuisPlat(x_debut, x_fin, z_fin)" },
+    { "DefinirFondDoublePente", (PyCFunction)Solveur_DefinirFondDoublePente, METH_VARARGS,
+      "DefinirFondDoublePente(x_debut, x_cassure, z_cassure, z_fin)" },
+    { "ChargerFond", (PyCFunction)Solveur_ChargerFond, METH_VARARGS,
+      "ChargerFond(nom_fichier, x_debut=0) : profil mesuré (voir Bathymetrie.h)" },
+    { "ConditionInitialeSoliton", (PyCFunction)Solveur_ConditionInitialeSoliton, METH_VARARGS,
+      "ConditionInitialeSoliton(A, x_depart)" },
+    { "ConditionInitialeDamBreak", (PyCFunction)Solveur_ConditionInitialeDamBreak, METH_NOARGS,
+      "Rupture de barrage" },
+    { "ConditionInitialeGaussienne", (PyCFunction)Solveur_ConditionInitialeGaussienne, METH_VARARGS,
+      "ConditionInitialeGaussienne(amplitude, position_x, largeur, vitesse_init)" },
+    { "Avancer", (PyCFunction)(void(*)(void))Solveur_Avancer, METH_VARARGS | METH_KEYWORDS,
+      "Avancer(n_pas=1, t_final=None) -> pas faits. Sans le GIL ; s'arrête exactement à t_final. "
+      "BufferError si des vues de h ou hu existent (à libérer, puis redemander)." },
+    { "Sauvegarder", (PyCFunction)Solveur_Sauvegarder, METH_NOARGS,
+      "Ecrit l'état dans le fichier d'Initialiser" },
+    { "DefinirIntervalleSorties", (PyCFunction)Solveur_DefinirIntervalleSorties, METH_VARARGS,
+      "DefinirIntervalleSorties(intervalle) : Sauvegarder aux temps exacts t0 + k intervalle" },
+    { "CalculerDiagnostics", (PyCFunction)Solveur_CalculerDiagnostics, METH_NOARGS,
+      "Masse, énergie, crête, zone mouillée, Froude max et rivage (dict)" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+
+static PyGetSetDef ProprietesSolveur[] = {
+    { "h", (getter)Solveur_get_h, nullptr, "Hauteur d'eau (memoryview en lecture seule, sans copie)", nullptr },
+    { "hu", (getter)Solveur_get_hu, nullptr, "Débit (memoryview en lecture seule, sans copie)", nullptr },
+    { "zb", (getter)Solveur_get_zb, nullptr, "Fond (memoryview en lecture seule, sans copie)", nullptr },
+    { "t", (getter)Solveur_get_t, nullptr, "Temps actuel (s)", nullptr },
+    { "dt", (getter)Solveur_get_dt, nullptr, "Dernier pas de temps (s)", nullptr },
+    { "dx", (getter)Solveur_get_dx, nullptr, "Pas d'espace (m)", nullptr },
+    { "N", (getter)Solveur_get_N, nullptr, "Nombre de cellules", nullptr },
+    { nullptr, nullptr, nullptr, nullptr, nullptr }
+};
+
+
+static PyModuleDef Module = {
+    PyModuleDef_HEAD_INIT, "saintvenant",
+    "Solveur de Saint-Venant 1D (volumes finis) ; voir src/ModulePython.cpp", -1,
+    nullptr, nullptr, nullptr, nullptr, nullptr
+};
+
+
+PyMODINIT_FUNC PyInit_saintvenant()
+{
+    TypeVue.tp_name = "saintvenant.Vue";
+    TypeVue.tp_basicsize = sizeof(ObjetVue);
+    TypeVue.tp_flags = Py_TPFLAGS_DEFAULT;
+    TypeVue.tp_dealloc = (destructor)Vue_dealloc;
+    TypeVue.tp_as_buffer = &BufferVue;
+    TypeVue.tp_doc = "Exportateur du buffer d'un champ du solveur (utilisé via memoryview)";
+
+    TypeSolveur.tp_name = "saintvenant.SaintVenant1D";
+    TypeSolveur.tp_basicsize = sizeof(ObjetSolveur);
+    TypeSolveur.tp_flags = Py_TPFLAGS_DEFAULT;
+    TypeSolveur.tp_new = Solveur_new;
+    TypeSolveur.tp_dealloc = (destructor)Solveur_dealloc;
+    TypeSolveur.tp_methods = MethodesSolveur;
+    TypeSolveur.tp_getset = ProprietesSolveur;
+    TypeSolveur.tp_doc = "Solveur de Saint-Venant 1D (méthodes et paramètres de SaintVenant1D)";
+
+    if (PyType_Ready(&TypeVue) < 0 || PyType_Ready(&TypeSolveur) < 0)
+        return nullptr;
+
+    PyObject* module = PyModule_Create(&Module);
+    if (module == nullptr)
+        return nullptr;
+    Py_INCREF(&TypeSolveur);
+    if (PyModule_AddObject(module, "SaintVenant1D", (PyObject*)&TypeSolveur) < 0)
+    {
+        Py_DECREF(&TypeSolveur);
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,183 @@
+#include "Observateurs.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+
+Observateurs::Observateurs()
+    : _N(0), _dx(0.0), _critere_h(0.0), _seuil_arrivee(0.0), _tous_les_pas(1), _pas(0),
+      _x_runup(-1.0), _H_runup(0.0), _t_runup(0.0), _x_rivage(-1.0)
+{
+}
+
+
+bool Observateurs::Initialiser(int N, double dx, const vector<double>& zb, double critere_h,
+                               const vector<double>& x_jauges, const string& fichier_jauges,
+                               int tous_les_pas, double seuil_arrivee,
+                               double t, const double* h, const double* hu)
+{
+    _N = N;
+    _dx = dx;
+    _critere_h = critere_h;
+    _seuil_arrivee = seuil_arrivee;
+    _tous_les_pas = max(1, tous_les_pas);
+    _pas = 0;
+
+    // Jauges : interpolation entre les centres (i + 0.5) dx et (i + 1.5) dx
+    _x_jauges = x_jauges;
+    _i_jauges.resize(x_jauges.size());
+    _poids_jauges.resize(x_jauges.size());
+    for (size_t k = 0; k < x_jauges.size(); k++)
+    {
+        double x = x_jauges[k];
+        if (!(x >= 0.0 && x <= N * dx))
+        {
+            cout << "Erreur : jauge en x = " << x << " hors du domaine [0, " << N * dx << "]" << endl;
+            return false;
+        }
+        double position = x / dx - 0.5;
+        int i = min(max((int)floor(position), 0), N - 2);
+        _i_jauges[k] = i;
+        _poids_jauges[k] = min(max(position - i, 0.0), 1.0);
+    }
+    if (_fichier_jauges.is_open())
+        _fichier_jauges.close();
+    if (!fichier_jauges.empty() && !x_jauges.empty())
+    {
+        _fichier_jauges.open(fichier_jauges);
+        if (!_fichier_jauges.is_open())
+        {
+            cout << "Erreur : impossible d'ouvrir '" << fichier_jauges << "'" << endl;
+            return false;
+        }
+        _fichier_jauges.precision(8);
+        _fichier_jauges << "t";
+        for (double x : x_jauges)
+            _fichier_jauges << ",H_" << x << ",u_" << x;
+        _fichier_jauges << ",x_rivage\n";
+    }
+
+    // Enveloppes vides, puis état initial
+    _H_initial.resize(N);
+    _sec_initial.resize(N);
+    for (int i = 0; i < N; i++)
+    {
+        _H_initial[i] = h[i] + zb[i];
+        _sec_initial[i] = !(h[i] > critere_h);
+    }
+    _H_max.assign(N, -HUGE_VAL);
+    _H_min.assign(N, HUGE_VAL);
+    _u_max.assign(N, -HUGE_VAL);
+    _u_min.assign(N, HUGE_VAL);
+    _t_arrivee.assign(N, -1.0);
+    _x_runup = -1.0;
+    _H_runup = 0.0;
+    _t_runup = t;
+
+    Observer(t, h, hu, zb.data());
+    return true;
+}
+
+
+// =======================================
+// Un balayage par pas : enveloppes, arrivée et rivage
+// =======================================
+void Observateurs::Observer(double t, const double* h, const double* hu, const double* zb)
+{
+    double* H_max = _H_max.data();
+    double* H_min = _H_min.data();
+    double* u_max = _u_max.data();
+    double* u_min = _u_min.data();
+    double* t_arrivee = _t_arrivee.data();
+
+    int i_rivage = -1;
+    bool precedente_mouillee = false;
+    for (int i = 0; i < _N; i++)
+    {
+        double h_i = h[i];
+        bool mouillee = h_i > _critere_h;
+        double H = h_i + zb[i];
+        double u = mouillee ? hu[i] / h_i : 0.0;
+
+        if (mouillee)
+        {
+            H_max[i] = max(H_max[i], H);
+            H_min[i] = min(H_min[i], H);
+            if (t_arrivee[i] < 0.0 && (_sec_initial[i] || fabs(H - _H_initial[i]) > _seuil_arrivee))
+                t_arrivee[i] = t;
+        }
+        u_max[i] = max(u_max[i], u);
+        u_min[i] = min(u_min[i], u);
+
+        if (!mouillee && precedente_mouillee)
+            i_rivage = i - 1;
+        precedente_mouillee = mouillee;
+    }
+
+    _x_rivage = (i_rivage >= 0) ? (i_rivage + 1) * _dx : -1.0;
+    if (_x_rivage > _x_runup)
+    {
+        _x_runup = _x_rivage;
+        _H_runup = h[i_rivage] + zb[i_rivage];
+        _t_runup = t;
+    }
+
+    if (_fichier_jauges.is_open() && _pas % _tous_les_pas == 0)
+        EcrireJauges(t, h, hu, zb);
+    _pas++;
+}
+
+
+void Observateurs::EcrireJauges(double t, const double* h, const double* hu, const double* zb)
+{
+    _fichier_jauges << t;
+    for (size_t k = 0; k < _i_jauges.size(); k++)
+    {
+        int i = _i_jauges[k];
+        double w = _poids_jauges[k];
+        double u_g = (h[i] > _critere_h) ? hu[i] / h[i] : 0.0;
+        double u_d = (h[i+1] > _critere_h) ? hu[i+1] / h[i+1] : 0.0;
+        double H = (1.0 - w) * (h[i] + zb[i]) + w * (h[i+1] + zb[i+1]);
+        double u = (1.0 - w) * u_g + w * u_d;
+        _fichier_jauges << ',' << H << ',' << u;
+    }
+    _fichier_jauges << ',' << _x_rivage << '\n';
+}
+
+
+bool Observateurs::EcrireEnveloppes(const string& nom_fichier, const double* zb) const
+{
+    ofstream fichier(nom_fichier);
+    if (!fichier.is_open())
+    {
+        cout << "Erreur : impossible d'ouvrir '" << nom_fichier << "'" << endl;
+        return false;
+    }
+
+    fichier.precision(10);
+    if (_x_runup >= 0.0)
+        fichier << "# runup : x = " << _x_runup << " m, H = " << _H_runup << " m, t = " << _t_runup << " s\n";
+    else
+        fichier << "# runup : pas de rivage\n";
+    fichier << "x,zb,H_max,H_min,u_max,u_min,t_arrivee\n";
+    for (int i = 0; i < _N; i++)
+    {
+        fichier << (i + 0.5) * _dx << ',' << zb[i] << ',';
+        // Cellule jamais mouillée : pas d'enveloppe de surface
+        if (_H_max[i] >= _H_min[i])
+            fichier << _H_max[i] << ',' << _H_min[i];
+        else
+            fichier << "nan,nan";
+        fichier << ',' << _u_max[i] << ',' << _u_min[i] << ',' << _t_arrivee[i] << '\n';
+    }
+
+    fichier.close();
+    if (!fichier)
+    {
+        cout << "Erreur : ecriture incomplete de '" << nom_fichier << "'" << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef _OBSERVATEURS_H
+#define _OBSERVATEURS_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+// ========================================
+// Analyses en cours de calcul
+// ========================================
+// Grandeurs calculées à la fin de chaque pas, sans écrire le champ complet :
+//
+// - jauges : surface libre H = h + zb et vitesse u à des abscisses quelconques,
+//   interpolées linéairement entre les centres des deux cellules voisines, écrites
+//   dans un CSV (t, H et u de chaque jauge, x_rivage) tous les tous_les_pas pas ;
+// - enveloppes par cellule : H max et min sur les instants où la cellule est
+//   mouillée (cellule jamais mouillée : nan dans le CSV, -inf et +inf dans
+//   ObtenirHMax et ObtenirHMin), u max et min (u = 0 si sèche) ;
+// - temps d'arrivée par cellule : premier instant où la cellule est mouillée et
+//   où |H - H initial| dépasse seuil_arrivee (ou, pour une cellule sèche au départ,
+//   où elle est inondée) ; -1 si l'onde n'est jamais arrivée ;
+// - runup : abscisse maximale atteinte par le rivage (bord droit de la dernière
+//   cellule mouillée suivie d'une cellule sèche, comme Diagnostics::x_rivage), avec
+//   la surface libre et l'instant correspondants.
+//
+// Un seul balayage O(N) par pas, sans allocation. Le fond est celui du solveur au
+// moment de chaque appel (pas de copie) : un fond changé après l'activation
+// (ChargerFond, DefinirFond..., ChargerReprise) est pris en compte. Les observations
+// repartent de l'état au moment de l'activation et ne sont pas enregistrées dans les
+// points de reprise.
+
+class Observateurs
+{
+private:
+    int _N;
+    double _dx;
+    double _critere_h;
+    double _seuil_arrivee;
+
+    // Jauges : cellule de gauche et poids de la cellule de droite
+    std::vector<double> _x_jauges;
+    std::vector<int> _i_jauges;
+    std::vector<double> _poids_jauges;
+    std::ofstream _fichier_jauges;
+    int _tous_les_pas;
+    long _pas;
+
+    // Enveloppes et arrivée
+    std::vector<double> _H_initial;
+    std::vector<char> _sec_initial;
+    std::vector<double> _H_max;
+    std::vector<double> _H_min;
+    std::vector<double> _u_max;
+    std::vector<double> _u_min;
+    std::vector<double> _t_arrivee;
+
+    // Runup
+    double _x_runup;
+    double _H_runup;
+    double _t_runup;
+    double _x_rivage;
+
+    void EcrireJauges(double t, const double* h, const double* hu, const double* zb);
+
+public:
+    Observateurs();
+
+    // Grille de N cellules de largeur dx sur le fond zb, état initial (t, h, hu).
+    // fichier_jauges vide : pas de jauges. Retourne false (avec un message) si une
+    // jauge est hors du domaine ou si le fichier ne peut pas être ouvert.
+    bool Initialiser(int N, double dx, const std::vector<double>& zb, double critere_h,
+                     const std::vector<double>& x_jauges, const std::string& fichier_jauges,
+                     int tous_les_pas, double seuil_arrivee,
+                     double t, const double* h, const double* hu);
+
+    // Met à jour les observations avec l'état (h, hu) au temps t, sur le fond zb
+    void Observer(double t, const double* h, const double* hu, const double* zb);
+
+    // CSV x, zb, H_max, H_min, u_max, u_min, t_arrivee (une ligne par cellule), précédé
+    // du runup en commentaire ; zb : fond actuel du solveur
+    bool EcrireEnveloppes(const std::string& nom_fichier, const double* zb) const;
+
+    // Accesseurs
+    const std::vector<double>& ObtenirHMax() const { return _H_max; }
+    const std::vector<double>& ObtenirHMin() const { return _H_min; }
+    const std::vector<double>& ObtenirUMax() const { return _u_max; }
+    const std::vector<double>& ObtenirUMin() const { return _u_min; }
+    const std::vector<double>& ObtenirTempsArrivee() const { return _t_arrivee; }
+    double ObtenirXRunup() const { return _x_runup; }   // -1 si jamais de rivage
+    double ObtenirHRunup() const { return _H_runup; }
+    double ObtenirTempsRunup() const { return _t_runup; }
+};
+
+#endif // _OBSERVATEURS_H
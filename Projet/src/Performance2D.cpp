@@ -0,0 +1,131 @@
+// ========================================
+// Saint-Venant 2D : coût par cellule et validation
+// ========================================
+// 1. Lac au repos autour d'une île, bords en murs : la surface doit rester plane
+//    et l'eau immobile (reconstruction hydrostatique dans les deux directions).
+// 2. Rupture de barrage circulaire entre murs : la masse est conservée, et le
+//    résultat ne dépend pas du nombre de threads.
+// 3. Rupture de barrage circulaire sur N x N cellules pour plusieurs tailles de
+//    tuiles : temps par mise à jour de cellule (balayages x et y compris).
+//
+// Usage : performance_2d [N] [nb_pas] [nb_threads]
+// (à compiler en Release pour des temps représentatifs)
+
+#include "SaintVenant2D.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+// Initialise sans les messages du solveur
+static void Preparer(SaintVenant2D& solveur, int Nx, int Ny, int taille_tuile)
+{
+    streambuf* sortie = cout.rdbuf(nullptr);
+    solveur.Initialiser(Nx, Ny, 100.0, 100.0 * Ny / Nx, 0.9, "", taille_tuile);
+    cout.rdbuf(sortie);
+}
+
+
+static void DamBreakCirculaire(SaintVenant2D& solveur)
+{
+    streambuf* sortie = cout.rdbuf(nullptr);
+    solveur.DefinirFondIle(70.0, 30.0, 15.0, 3.0);
+    solveur.ConditionInitialeDamBreakCirculaire(35.0, 50.0, 15.0, 4.0, 1.0);
+    cout.rdbuf(sortie);
+}
+
+
+int main(int argc, char** argv)
+{
+    int N = (argc > 1) ? atoi(argv[1]) : 4000;
+    int nb_pas = (argc > 2) ? atoi(argv[2]) : 5;
+    int nb_threads = (argc > 3) ? atoi(argv[3]) : 1;
+
+    // 1. Lac au repos
+    {
+        SaintVenant2D solveur;
+        Preparer(solveur, 200, 150, 32);
+        solveur.DefinirMurs(true);
+        streambuf* sortie = cout.rdbuf(nullptr);
+        solveur.DefinirFondIle(50.0, 40.0, 20.0, 3.0);
+        solveur.ConditionInitialeLacAuRepos(2.0);
+        cout.rdbuf(sortie);
+
+        for (int n = 0; n < 200; n++)
+            solveur.Avancer();
+
+        double ecart_surface = 0.0, debit_max = 0.0;
+        for (int j = 0; j < solveur.ObtenirNy(); j++)
+        {
+            for (int i = 0; i < solveur.ObtenirNx(); i++)
+            {
+                double h = solveur.ObtenirH(i, j);
+                if (h > 0.0)
+                    ecart_surface = max(ecart_surface, fabs(h + solveur.ObtenirZb(i, j) - 2.0));
+                debit_max = max(debit_max, max(fabs(solveur.ObtenirHu(i, j)), fabs(solveur.ObtenirHv(i, j))));
+            }
+        }
+        cout << "Lac au repos (ile emergee, 200 pas) : ecart surface = " << scientific << setprecision(3)
+             << ecart_surface << ", debit max = " << debit_max << endl;
+    }
+
+    // 2. Conservation de la masse et indépendance vis-à-vis du nombre de threads
+    {
+        SaintVenant2D seq, par;
+        Preparer(seq, 300, 300, 64);
+        Preparer(par, 300, 300, 64);
+        seq.DefinirMurs(true);
+        par.DefinirMurs(true);
+        par.DefinirNombreThreads(max(2, nb_threads));
+        DamBreakCirculaire(seq);
+        DamBreakCirculaire(par);
+
+        double masse_initiale = seq.CalculerMasseTotale();
+        for (int n = 0; n < 300; n++)
+        {
+            seq.Avancer();
+            par.Avancer();
+        }
+
+        double ecart_threads = 0.0;
+        for (int j = 0; j < seq.ObtenirNy(); j++)
+            for (int i = 0; i < seq.ObtenirNx(); i++)
+                ecart_threads = max(ecart_threads, fabs(seq.ObtenirH(i, j) - par.ObtenirH(i, j)));
+
+        cout << "Barrage circulaire entre murs (300 pas, t = " << fixed << setprecision(3) << seq.ObtenirTemps()
+             << " s) : masse (var. rel.) = " << scientific << setprecision(3)
+             << (seq.CalculerMasseTotale() - masse_initiale) / masse_initiale
+             << ", ecart 1 / " << par.ObtenirNombreThreads() << " threads = " << ecart_threads << endl;
+    }
+
+    // 3. Coût par cellule selon la taille des tuiles
+    cout << endl << "Barrage circulaire " << N << " x " << N << ", " << nb_pas << " pas, "
+         << nb_threads << " thread(s) :" << endl;
+    cout << setw(8) << "tuile" << setw(12) << "temps (s)" << setw(16) << "ns / cellule" << setw(18) << "cellules / s" << endl;
+
+    const int tailles[] = { 16, 32, 64, 128 };
+    for (int T : tailles)
+    {
+        SaintVenant2D solveur;
+        Preparer(solveur, N, N, T);
+        solveur.DefinirNombreThreads(nb_threads);
+        DamBreakCirculaire(solveur);
+        solveur.Avancer();  // Premier pas hors mesure (pages mémoire, vitesses initiales)
+
+        auto debut = chrono::steady_clock::now();
+        for (int n = 0; n < nb_pas; n++)
+            solveur.Avancer();
+        auto fin = chrono::steady_clock::now();
+
+        double temps = chrono::duration<double>(fin - debut).count();
+        double mises_a_jour = (double)N * N * nb_pas;
+        cout << setw(8) << T << setw(12) << fixed << setprecision(4) << temps
+             << setw(16) << setprecision(2) << 1e9 * temps / mises_a_jour
+             << setw(18) << scientific << setprecision(3) << mises_a_jour / temps << endl;
+    }
+    return 0;
+}
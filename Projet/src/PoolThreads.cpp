@@ -0,0 +1,96 @@
+#include "PoolThreads.h"
+
+using namespace std;
+
+PoolThreads::PoolThreads(int nb_threads)
+    : _nb_threads(nb_threads < 1 ? 1 : nb_threads), _tache(nullptr), _debut(0), _fin(0),
+      _generation(0), _restants(0), _arret(false)
+{
+    for (int id = 1; id < _nb_threads; id++)
+        _threads.emplace_back(&PoolThreads::Boucle, this, id);
+}
+
+
+PoolThreads::~PoolThreads()
+{
+    {
+        lock_guard<mutex> verrou(_mutex);
+        _arret = true;
+    }
+    _cv_travail.notify_all();
+    for (size_t k = 0; k < _threads.size(); k++)
+        _threads[k].join();
+}
+
+
+// Bornes du morceau id (calcul identique pour tous les threads)
+static void BornesMorceau(int debut, int fin, int id, int nb, int& d, int& f)
+{
+    long n = fin - debut;
+    d = debut + (int)(n * id / nb);
+    f = debut + (int)(n * (id + 1) / nb);
+}
+
+
+void PoolThreads::Boucle(int id)
+{
+    long generation_vue = 0;
+
+    while (true)
+    {
+        const function<void(int, int, int)>* tache;
+        int debut, fin;
+        {
+            unique_lock<mutex> verrou(_mutex);
+            _cv_travail.wait(verrou, [&] { return _arret || _generation != generation_vue; });
+            if (_arret)
+                return;
+            generation_vue = _generation;
+            tache = _tache;
+            debut = _debut;
+            fin = _fin;
+        }
+
+        int d, f;
+        BornesMorceau(debut, fin, id, _nb_threads, d, f);
+        if (d < f)
+            (*tache)(d, f, id);
+
+        {
+            lock_guard<mutex> verrou(_mutex);
+            _restants--;
+            if (_restants == 0)
+                _cv_fini.notify_one();
+        }
+    }
+}
+
+
+void PoolThreads::ExecuterParMorceaux(int debut, int fin, const function<void(int, int, int)>& tache)
+{
+    if (_nb_threads == 1)
+    {
+        if (debut < fin)
+            tache(debut, fin, 0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> verrou(_mutex);
+        _tache = &tache;
+        _debut = debut;
+        _fin = fin;
+        _restants = _nb_threads - 1;
+        _generation++;
+    }
+    _cv_travail.notify_all();
+
+    // Le thread appelant traite le morceau 0
+    int d, f;
+    BornesMorceau(debut, fin, 0, _nb_threads, d, f);
+    if (d < f)
+        tache(d, f, 0);
+
+    unique_lock<mutex> verrou(_mutex);
+    _cv_fini.wait(verrou, [&] { return _restants == 0; });
+}
@@ -0,0 +1,48 @@
+#ifndef _POOL_THREADS_H
+#define _POOL_THREADS_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// ========================================
+// Pool de threads persistant à découpage statique
+// ========================================
+// Les threads sont créés une seule fois et attendent du travail entre deux appels.
+// Un intervalle [debut, fin) est toujours découpé de la même façon pour un nombre
+// de threads donné : le morceau id couvre [debut + n*id/T, debut + n*(id+1)/T).
+class PoolThreads
+{
+private:
+    int _nb_threads;
+    std::vector<std::thread> _threads;
+
+    // Travail en cours (protégé par _mutex)
+    std::mutex _mutex;
+    std::condition_variable _cv_travail;  // Réveille les threads quand un travail arrive
+    std::condition_variable _cv_fini;     // Réveille l'appelant quand tous ont fini
+    const std::function<void(int, int, int)>* _tache;
+    int _debut, _fin;
+    long _generation;  // Incrémenté à chaque nouveau travail
+    int _restants;     // Threads auxiliaires qui n'ont pas encore fini
+    bool _arret;
+
+    // Boucle des threads auxiliaires (id = 1 .. T-1)
+    void Boucle(int id);
+
+public:
+    // Crée nb_threads - 1 threads auxiliaires, le thread appelant sert de thread 0
+    explicit PoolThreads(int nb_threads);
+
+    ~PoolThreads();
+
+    int NombreThreads() const { return _nb_threads; }
+
+    // Appelle tache(d, f, id) sur chaque morceau de [debut, fin) et retourne
+    // quand tous les morceaux sont traités
+    void ExecuterParMorceaux(int debut, int fin, const std::function<void(int, int, int)>& tache);
+};
+
+#endif // _POOL_THREADS_H
@@ -0,0 +1,234 @@
+// ========================================
+// Comparaison travail-précision : ordre 1 contre ordre 2
+// ========================================
+// Deux cas tests, résolus pour plusieurs N avec le schéma d'ordre 1 (CFL 0.9,
+// comme main.cpp) et le schéma d'ordre 2 (MUSCL + SSP-RK2, CFL 0.45) :
+// - rupture de barrage sur fond plat : erreur L1 sur h par rapport à la
+//   solution exacte de Stoker ;
+// - soliton sur fond plat : erreur sur la hauteur de la crête par rapport à une
+//   solution de référence d'ordre 2 sur une grille très fine.
+// Affiche le temps de calcul et l'erreur, puis le plus petit N de l'ordre 2
+// qui atteint l'erreur de l'ordre 1 au plus grand N.
+//
+// Usage : precision_ordre2 [N_max] [limiteur]
+// (à compiler en Release pour des temps représentatifs)
+
+#include "SaintVenant.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+static const double g = 9.81;
+
+
+// ========================================
+// Solution exacte de la rupture de barrage sur fond mouillé (Stoker)
+// ========================================
+class DamBreakExact
+{
+private:
+    double _hL, _hR, _x0;
+    double _cL, _hm, _um, _cm, _S;
+
+public:
+    DamBreakExact(double hL, double hR, double x0) : _hL(hL), _hR(hR), _x0(x0)
+    {
+        _cL = sqrt(g * hL);
+
+        // Hauteur intermédiaire : la détente et le choc donnent la même vitesse
+        double a = hR, b = hL;
+        for (int k = 0; k < 200; k++)
+        {
+            double hm = 0.5 * (a + b);
+            double u_detente = 2.0 * (_cL - sqrt(g * hm));
+            double u_choc = (hm - hR) * sqrt(0.5 * g * (hm + hR) / (hm * hR));
+            if (u_detente > u_choc) a = hm; else b = hm;
+        }
+        _hm = 0.5 * (a + b);
+        _cm = sqrt(g * _hm);
+        _um = 2.0 * (_cL - _cm);
+        _S = _hm * _um / (_hm - hR);  // Vitesse du choc
+    }
+
+    double Hauteur(double x, double t) const
+    {
+        double xi = (x - _x0) / t;
+        if (xi < -_cL) return _hL;
+        if (xi < _um - _cm) return pow(2.0 * _cL - xi, 2) / (9.0 * g);  // Détente
+        if (xi < _S) return _hm;
+        return _hR;
+    }
+};
+
+
+// Les messages d'initialisation du solveur ne font pas partie du rapport
+struct Silence
+{
+    streambuf* _sortie;
+    Silence() : _sortie(cout.rdbuf(nullptr)) {}
+    ~Silence() { cout.rdbuf(_sortie); }
+};
+
+
+struct Resultat
+{
+    double erreur;
+    double temps;  // secondes
+};
+
+
+static void Configurer(SaintVenant1D& solveur, int ordre, const string& limiteur)
+{
+    if (ordre == 2)
+        solveur.ChoisirOrdre(2, limiteur);
+}
+
+
+static Resultat DamBreak(int N, int ordre, const string& limiteur)
+{
+    const double L = 50.0, t_final = 1.5;
+    SaintVenant1D solveur;
+    {
+        Silence silence;
+        solveur.Initialiser(N, L, ordre == 2 ? 0.45 : 0.9, "");
+        Configurer(solveur, ordre, limiteur);
+        solveur.DefinirFondPlat();
+        solveur.ConditionInitialeDamBreak();
+    }
+
+    auto debut = chrono::steady_clock::now();
+    while (solveur.ObtenirTemps() < t_final)
+        solveur.Avancer();
+    auto fin = chrono::steady_clock::now();
+
+    // Erreur L1 par rapport à la solution exacte, au temps atteint
+    DamBreakExact exact(10.0, 5.0, 0.5 * L);
+    const vector<double>& h = solveur.ObtenirH();
+    double dx = solveur.ObtenirDx(), t = solveur.ObtenirTemps();
+    double erreur = 0.0;
+    for (int i = 0; i < N; i++)
+        erreur += fabs(h[i] - exact.Hauteur((i + 0.5) * dx, t)) * dx;
+
+    return { erreur, chrono::duration<double>(fin - debut).count() };
+}
+
+
+// Hauteur de la crête du soliton à t_final
+static double CreteSoliton(int N, int ordre, const string& limiteur, double& temps)
+{
+    const double L = 75.0, t_final = 2.0;
+    SaintVenant1D solveur;
+    {
+        Silence silence;
+        solveur.Initialiser(N, L, ordre == 2 ? 0.45 : 0.9, "");
+        Configurer(solveur, ordre, limiteur);
+        solveur.DefinirFondPlat();
+        solveur.ConditionInitialeSoliton(0.2, 20.0);
+    }
+
+    // Arrêt exact à t_final : les crêtes sont comparées au même instant pour tous les N
+    auto debut = chrono::steady_clock::now();
+    while (solveur.ObtenirTemps() < t_final)
+        solveur.Avancer(t_final);
+    auto fin = chrono::steady_clock::now();
+    temps = chrono::duration<double>(fin - debut).count();
+
+    return solveur.ObtenirSurfaceMax();
+}
+
+
+static void AfficherTableau(const string& titre, const vector<int>& tailles,
+                            const vector<Resultat>& ordre1, const vector<Resultat>& ordre2)
+{
+    cout << titre << endl;
+    cout << setw(8) << "N" << setw(16) << "erreur ordre 1" << setw(12) << "temps (s)"
+         << setw(16) << "erreur ordre 2" << setw(12) << "temps (s)" << endl;
+    for (size_t k = 0; k < tailles.size(); k++)
+    {
+        cout << setw(8) << tailles[k]
+             << setw(16) << scientific << setprecision(3) << ordre1[k].erreur
+             << setw(12) << fixed << setprecision(4) << ordre1[k].temps
+             << setw(16) << scientific << setprecision(3) << ordre2[k].erreur
+             << setw(12) << fixed << setprecision(4) << ordre2[k].temps << endl;
+    }
+
+    // Plus petit N d'ordre 2 qui fait aussi bien que l'ordre 1 au plus grand N
+    double cible = ordre1.back().erreur;
+    for (size_t k = 0; k < tailles.size(); k++)
+    {
+        if (ordre2[k].erreur <= cible)
+        {
+            cout << "  -> Erreur ordre 1 a N = " << tailles.back() << " (" << scientific << setprecision(3) << cible
+                 << ") atteinte a l'ordre 2 des N = " << tailles[k]
+                 << fixed << setprecision(1) << " : " << (double)tailles.back() / tailles[k] << "x moins de cellules" << endl;
+            break;
+        }
+        if (k + 1 == tailles.size())
+            cout << "  -> L'ordre 2 n'atteint pas l'erreur de l'ordre 1 sur ces grilles" << endl;
+    }
+
+    // Ce que coûterait l'ordre 1 pour l'erreur de l'ordre 2 au plus grand N :
+    // extrapolation avec l'ordre de convergence observé sur les deux plus grands N
+    // (le coût de l'ordre 1 croît en N^2 : N cellules et N pas de temps)
+    size_t n = tailles.size();
+    if (n >= 2 && ordre1[n-1].erreur < ordre1[n-2].erreur)
+    {
+        double p1 = log(ordre1[n-2].erreur / ordre1[n-1].erreur) / log((double)tailles[n-1] / tailles[n-2]);
+        double rapport_N = pow(ordre1[n-1].erreur / ordre2[n-1].erreur, 1.0 / p1);
+        if (rapport_N > 1.0)
+        {
+            double temps_ordre1 = ordre1[n-1].temps * rapport_N * rapport_N;
+            cout << "  -> Ordre 1 observe : " << fixed << setprecision(2) << p1
+                 << " ; pour l'erreur de l'ordre 2 a N = " << tailles[n-1] << " (" << scientific << setprecision(3)
+                 << ordre2[n-1].erreur << "), l'ordre 1 demanderait N ~ " << fixed << setprecision(0)
+                 << tailles[n-1] * rapport_N << " (" << setprecision(1) << rapport_N << "x plus de cellules, ~"
+                 << temps_ordre1 / ordre2[n-1].temps << "x plus de temps)" << endl;
+        }
+    }
+    cout << endl;
+}
+
+
+int main(int argc, char** argv)
+{
+    int N_max = (argc > 1) ? atoi(argv[1]) : 3200;
+    string limiteur = (argc > 2) ? argv[2] : "mc";
+
+    vector<int> tailles;
+    for (int N = 100; N <= N_max; N *= 2)
+        tailles.push_back(N);
+
+    cout << "Comparaison travail-precision, ordre 2 avec limiteur " << limiteur << endl << endl;
+
+    // 1. Rupture de barrage
+    vector<Resultat> db1, db2;
+    for (int N : tailles)
+    {
+        db1.push_back(DamBreak(N, 1, limiteur));
+        db2.push_back(DamBreak(N, 2, limiteur));
+    }
+    AfficherTableau("Rupture de barrage (erreur L1 sur h, solution de Stoker, t = 1.5 s)", tailles, db1, db2);
+
+    // 2. Soliton : référence d'ordre 2 sur une grille 8 fois plus fine que la plus fine testée
+    double temps_ref;
+    double crete_ref = CreteSoliton(8 * tailles.back(), 2, limiteur, temps_ref);
+    vector<Resultat> so1, so2;
+    for (int N : tailles)
+    {
+        Resultat r1, r2;
+        r1.erreur = fabs(CreteSoliton(N, 1, limiteur, r1.temps) - crete_ref);
+        r2.erreur = fabs(CreteSoliton(N, 2, limiteur, r2.temps) - crete_ref);
+        so1.push_back(r1);
+        so2.push_back(r2);
+    }
+    AfficherTableau("Soliton (erreur sur la hauteur de crete a t = 2 s, reference N = "
+                    + to_string(8 * tailles.back()) + ")", tailles, so1, so2);
+
+    return 0;
+}
@@ -0,0 +1,467 @@
+#include "Reprise.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+static const char SIGNATURE[8] = { 'S', 'V', 'R', 'E', 'P', 'R', 'I', 'S' };
+static const uint32_t VERSION_REPRISE = 3;
+static const uint32_t MARQUEUR_BOUTISME = 0x01020304;
+
+
+// ========================================
+// Somme de contrôle (FNV-1a sur des mots de 64 bits)
+// ========================================
+// Mise à jour par morceaux : le résultat dépend du découpage, identique à l'écriture
+// et à la lecture (groupes de champs complétés à 8 octets, puis chaque tableau).
+struct SommeControle
+{
+    uint64_t valeur = 1469598103934665603ULL;
+
+    void Ajouter(const void* donnees, size_t taille)
+    {
+        const unsigned char* octets = (const unsigned char*)donnees;
+        size_t nb_mots = taille / 8;
+        for (size_t k = 0; k < nb_mots; k++)
+        {
+            uint64_t mot;
+            memcpy(&mot, octets + 8 * k, 8);
+            valeur = (valeur ^ mot) * 1099511628211ULL;
+        }
+        for (size_t k = 8 * nb_mots; k < taille; k++)
+            valeur = (valeur ^ octets[k]) * 1099511628211ULL;
+    }
+};
+
+
+// Fichier écrit par morceaux, avec la somme de contrôle de tout ce qui est écrit.
+// Les petits champs sont regroupés dans un tampon ; les tableaux sont écrits directement.
+class FichierReprise
+{
+private:
+    FILE* _fichier;
+    SommeControle _somme;
+    vector<char> _tampon;
+    bool _ok;
+
+    void Vider()
+    {
+        // Tampon complété à un multiple de 8 octets (voir SommeControle)
+        while (_tampon.size() % 8 != 0)
+            _tampon.push_back(0);
+        Brut(_tampon.data(), _tampon.size());
+        _tampon.clear();
+    }
+
+    void Brut(const void* donnees, size_t taille)
+    {
+        if (taille == 0)
+            return;
+        _somme.Ajouter(donnees, taille);
+        _ok = _ok && fwrite(donnees, 1, taille, _fichier) == taille;
+    }
+
+public:
+    explicit FichierReprise(FILE* fichier) : _fichier(fichier), _ok(true) {}
+
+    template <class T>
+    void Valeur(const T& valeur)
+    {
+        const char* octets = (const char*)&valeur;
+        _tampon.insert(_tampon.end(), octets, octets + sizeof(T));
+    }
+
+    void Chaine(const string& texte)
+    {
+        Valeur((uint32_t)texte.size());
+        _tampon.insert(_tampon.end(), texte.begin(), texte.end());
+    }
+
+    template <class T>
+    void Tableau(const vector<T>& tableau)
+    {
+        Vider();
+        Brut(tableau.data(), tableau.size() * sizeof(T));
+    }
+
+    bool Terminer()
+    {
+        Vider();
+        uint64_t somme = _somme.valeur;
+        _ok = _ok && fwrite(&somme, 1, sizeof(somme), _fichier) == sizeof(somme);
+        return _ok;
+    }
+};
+
+
+// Lecture symétrique de FichierReprise
+class LecteurReprise
+{
+private:
+    FILE* _fichier;
+    SommeControle _somme;
+    vector<char> _tampon;   // Champs lus depuis le dernier tableau
+    bool _ok;
+
+    void Brut(void* donnees, size_t taille)
+    {
+        if (taille == 0 || !_ok)
+            return;
+        _ok = fread(donnees, 1, taille, _fichier) == taille;
+        if (_ok)
+            _somme.Ajouter(donnees, taille);
+    }
+
+    // Saute le bourrage du groupe de champs courant et l'ajoute à la somme
+    void Aligner()
+    {
+        size_t bourrage = (8 - _tampon.size() % 8) % 8;
+        char zeros[8] = { 0 };
+        if (_ok && bourrage > 0)
+            _ok = fread(zeros, 1, bourrage, _fichier) == bourrage;
+        _tampon.insert(_tampon.end(), zeros, zeros + bourrage);
+        _somme.Ajouter(_tampon.data(), _tampon.size());
+        _tampon.clear();
+    }
+
+    void Champ(void* donnees, size_t taille)
+    {
+        if (!_ok)
+            return;
+        _ok = fread(donnees, 1, taille, _fichier) == taille;
+        const char* octets = (const char*)donnees;
+        _tampon.insert(_tampon.end(), octets, octets + taille);
+    }
+
+public:
+    explicit LecteurReprise(FILE* fichier) : _fichier(fichier), _ok(true) {}
+
+    bool Ok() const { return _ok; }
+
+    // Octets du fichier pas encore lus (0 si la taille est inconnue)
+    size_t Restant() const
+    {
+        struct stat infos;
+        long position = ftell(_fichier);
+        if (position < 0 || fstat(fileno(_fichier), &infos) != 0 || infos.st_size < position)
+            return 0;
+        return (size_t)(infos.st_size - position);
+    }
+
+    template <class T>
+    void Valeur(T& valeur) { Champ(&valeur, sizeof(T)); }
+
+    void Chaine(string& texte)
+    {
+        uint32_t taille = 0;
+        Valeur(taille);
+        if (!_ok || taille > 4096)
+        {
+            _ok = false;
+            return;
+        }
+        texte.resize(taille);
+        Champ(&texte[0], taille);
+    }
+
+    // Un tableau plus grand que la fin du fichier n'est pas alloué (taille corrompue)
+    template <class T>
+    void Tableau(vector<T>& tableau, size_t taille)
+    {
+        Aligner();
+        if (_ok && taille > Restant() / sizeof(T))
+            _ok = false;
+        if (!_ok)
+            return;
+        tableau.resize(taille);
+        Brut(tableau.data(), taille * sizeof(T));
+    }
+
+    // Vrai si la somme de contrôle en fin de fichier correspond et qu'il ne reste rien
+    bool Verifier()
+    {
+        Aligner();
+        uint64_t somme = 0;
+        if (!_ok || fread(&somme, 1, sizeof(somme), _fichier) != sizeof(somme))
+            return false;
+        char reste;
+        return somme == _somme.valeur && fread(&reste, 1, 1, _fichier) == 0;
+    }
+};
+
+
+// ========================================
+// Ecriture et lecture
+// ========================================
+// Synchronise le répertoire du fichier : le renommage est lui-même sur le disque
+static bool SynchroniserRepertoire(const string& nom_fichier)
+{
+    size_t separateur = nom_fichier.find_last_of('/');
+    string repertoire = (separateur == string::npos) ? "." : nom_fichier.substr(0, max<size_t>(separateur, 1));
+    int descripteur = open(repertoire.c_str(), O_RDONLY | O_DIRECTORY);
+    if (descripteur < 0)
+        return false;
+    bool ok = fsync(descripteur) == 0;
+    return (close(descripteur) == 0) && ok;
+}
+
+
+bool EcrireReprise(const string& nom_fichier, const EtatReprise& etat)
+{
+    string temporaire = nom_fichier + ".tmp";
+    FILE* fichier = fopen(temporaire.c_str(), "wb");
+    if (fichier == nullptr)
+    {
+        cout << "Erreur : impossible d'ecrire le point de reprise '" << temporaire << "'" << endl;
+        return false;
+    }
+
+    FichierReprise sortie(fichier);
+    for (char c : SIGNATURE)
+        sortie.Valeur(c);
+    sortie.Valeur(VERSION_REPRISE);
+    sortie.Valeur(MARQUEUR_BOUTISME);
+
+    sortie.Valeur((int32_t)etat.N);
+    sortie.Valeur(etat.L);
+    sortie.Valeur(etat.dx);
+    sortie.Valeur(etat.CFL);
+    sortie.Valeur(etat.t);
+    sortie.Valeur(etat.dt);
+    sortie.Valeur(etat.h_fond);
+    sortie.Valeur(etat.critere_hauteur_deau);
+    sortie.Valeur(etat.critere_vitesse);
+    sortie.Valeur(etat.v_max);
+    sortie.Valeur((uint8_t)etat.v_max_valide);
+    sortie.Chaine(etat.schema);
+    sortie.Valeur((int32_t)etat.ordre);
+    sortie.Chaine(etat.limiteur);
+    sortie.Valeur((uint8_t)etat.zones_actives);
+    sortie.Valeur((int32_t)etat.taille_bloc);
+    sortie.Valeur(etat.tolerance_repos);
+    sortie.Valeur((uint8_t)etat.pas_local);
+    sortie.Valeur((int32_t)etat.nb_niveaux_temps);
+    sortie.Valeur((uint8_t)etat.frottement_implicite);
+    sortie.Valeur(etat.intervalle_sorties);
+    sortie.Valeur(etat.t_debut_sorties);
+    sortie.Valeur((int64_t)etat.rang_sortie);
+
+    sortie.Tableau(etat.h);
+    sortie.Tableau(etat.hu);
+    sortie.Tableau(etat.zb);
+    sortie.Tableau(etat.d_zb);
+    sortie.Valeur((int32_t)etat.bloc_actif.size());
+    sortie.Tableau(etat.bloc_actif);
+    sortie.Tableau(etat.v_max_bloc);
+    sortie.Valeur((int32_t)etat.manning.size());
+    sortie.Tableau(etat.manning);
+
+    // Sur le disque avant le renommage : le fichier renommé est complet
+    bool ok = sortie.Terminer() && fflush(fichier) == 0 && fsync(fileno(fichier)) == 0;
+    ok = (fclose(fichier) == 0) && ok;
+    if (!ok || rename(temporaire.c_str(), nom_fichier.c_str()) != 0)
+    {
+        cout << "Erreur : ecriture du point de reprise '" << nom_fichier << "' interrompue" << endl;
+        remove(temporaire.c_str());
+        return false;
+    }
+    // Puis le renommage : sans cela, une coupure peut laisser l'ancien point de reprise
+    if (!SynchroniserRepertoire(nom_fichier))
+    {
+        cout << "Erreur : renommage du point de reprise '" << nom_fichier << "' non synchronise" << endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool LireReprise(const string& nom_fichier, EtatReprise& etat)
+{
+    FILE* fichier = fopen(nom_fichier.c_str(), "rb");
+    if (fichier == nullptr)
+    {
+        cout << "Erreur : impossible d'ouvrir le point de reprise '" << nom_fichier << "'" << endl;
+        return false;
+    }
+
+    LecteurReprise entree(fichier);
+    char signature[8] = { 0 };
+    for (char& c : signature)
+        entree.Valeur(c);
+    uint32_t version = 0, marqueur = 0;
+    entree.Valeur(version);
+    entree.Valeur(marqueur);
+    if (!entree.Ok() || memcmp(signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+    {
+        cout << "Erreur : '" << nom_fichier << "' n'est pas un point de reprise" << endl;
+        fclose(fichier);
+        return false;
+    }
+    if (marqueur != MARQUEUR_BOUTISME)
+    {
+        cout << "Erreur : point de reprise '" << nom_fichier << "' ecrit sur une machine d'un autre boutisme" << endl;
+        fclose(fichier);
+        return false;
+    }
+    if (version != VERSION_REPRISE)
+    {
+        cout << "Erreur : point de reprise '" << nom_fichier << "' en version " << version
+             << " (version lue : " << VERSION_REPRISE << ")" << endl;
+        fclose(fichier);
+        return false;
+    }
+
+    int32_t N = 0, ordre = 0, taille_bloc = 0, nb_niveaux = 0, nb_blocs = 0, nb_manning = 0;
+    uint8_t v_max_valide = 0, zones_actives = 0, pas_local = 0, frottement_implicite = 0;
+    int64_t rang_sortie = 0;
+    entree.Valeur(N);
+    entree.Valeur(etat.L);
+    entree.Valeur(etat.dx);
+    entree.Valeur(etat.CFL);
+    entree.Valeur(etat.t);
+    entree.Valeur(etat.dt);
+    entree.Valeur(etat.h_fond);
+    entree.Valeur(etat.critere_hauteur_deau);
+    entree.Valeur(etat.critere_vitesse);
+    entree.Valeur(etat.v_max);
+    entree.Valeur(v_max_valide);
+    entree.Chaine(etat.schema);
+    entree.Valeur(ordre);
+    entree.Chaine(etat.limiteur);
+    entree.Valeur(zones_actives);
+    entree.Valeur(taille_bloc);
+    entree.Valeur(etat.tolerance_repos);
+    entree.Valeur(pas_local);
+    entree.Valeur(nb_niveaux);
+    entree.Valeur(frottement_implicite);
+    entree.Valeur(etat.intervalle_sorties);
+    entree.Valeur(etat.t_debut_sorties);
+    entree.Valeur(rang_sortie);
+    // Les quatre tableaux de N valeurs doivent tenir dans la fin du fichier : un N
+    // corrompu est refusé ici, avant toute allocation
+    if (!entree.Ok() || N < 3 || (size_t)N > entree.Restant() / (4 * sizeof(double)))
+    {
+        cout << "Erreur : en-tete du point de reprise '" << nom_fichier << "' invalide" << endl;
+        fclose(fichier);
+        return false;
+    }
+
+    etat.N = N;
+    etat.v_max_valide = v_max_valide != 0;
+    etat.ordre = ordre;
+    etat.zones_actives = zones_actives != 0;
+    etat.taille_bloc = taille_bloc;
+    etat.pas_local = pas_local != 0;
+    etat.nb_niveaux_temps = nb_niveaux;
+    etat.frottement_implicite = frottement_implicite != 0;
+    etat.rang_sortie = rang_sortie;
+
+    entree.Tableau(etat.h, N);
+    entree.Tableau(etat.hu, N);
+    entree.Tableau(etat.zb, N);
+    entree.Tableau(etat.d_zb, N);
+    entree.Valeur(nb_blocs);
+    if (nb_blocs < 0 || nb_blocs > N)
+        nb_blocs = 0;
+    entree.Tableau(etat.bloc_actif, nb_blocs);
+    entree.Tableau(etat.v_max_bloc, nb_blocs);
+    entree.Valeur(nb_manning);
+    if (nb_manning != N)
+        nb_manning = 0;
+    entree.Tableau(etat.manning, nb_manning);
+
+    bool ok = entree.Verifier();
+    fclose(fichier);
+    if (!ok)
+    {
+        cout << "Erreur : point de reprise '" << nom_fichier << "' tronque ou corrompu" << endl;
+        return false;
+    }
+    return true;
+}
+
+
+// ========================================
+// Ecrivain en arrière-plan
+// ========================================
+EcrivainReprise::EcrivainReprise(const string& nom_fichier)
+    : _nom_fichier(nom_fichier), _a_ecrire(false), _arret(false), _nb_ecrites(0), _nb_echecs(0)
+{
+    _thread = thread(&EcrivainReprise::Boucle, this);
+}
+
+
+EcrivainReprise::~EcrivainReprise()
+{
+    {
+        lock_guard<mutex> verrou(_mutex);
+        _arret = true;
+    }
+    _cv.notify_all();
+    _thread.join();
+}
+
+
+void EcrivainReprise::Boucle()
+{
+    unique_lock<mutex> verrou(_mutex);
+    while (true)
+    {
+        _cv.wait(verrou, [this] { return _a_ecrire || _arret; });
+        if (!_a_ecrire)
+            return;
+
+        // _etat n'est pas modifié par le calcul tant que _a_ecrire est vrai
+        verrou.unlock();
+        bool ok = EcrireReprise(_nom_fichier, _etat);
+        verrou.lock();
+
+        (ok ? _nb_ecrites : _nb_echecs)++;
+        _a_ecrire = false;
+        _cv.notify_all();
+    }
+}
+
+
+EtatReprise* EcrivainReprise::Preparer()
+{
+    lock_guard<mutex> verrou(_mutex);
+    return _a_ecrire ? nullptr : &_etat;
+}
+
+
+void EcrivainReprise::Lancer()
+{
+    {
+        lock_guard<mutex> verrou(_mutex);
+        _a_ecrire = true;
+    }
+    _cv.notify_all();
+}
+
+
+void EcrivainReprise::Attendre()
+{
+    unique_lock<mutex> verrou(_mutex);
+    _cv.wait(verrou, [this] { return !_a_ecrire; });
+}
+
+
+long EcrivainReprise::ObtenirNombreEcrites()
+{
+    lock_guard<mutex> verrou(_mutex);
+    return _nb_ecrites;
+}
+
+
+long EcrivainReprise::ObtenirNombreEchecs()
+{
+    lock_guard<mutex> verrou(_mutex);
+    return _nb_echecs;
+}
@@ -0,0 +1,111 @@
+#ifndef _REPRISE_H
+#define _REPRISE_H
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// ========================================
+// Points de reprise binaires de SaintVenant1D
+// ========================================
+// Format (version 3), nombres dans l'ordre d'octets de la machine :
+//   "SVREPRIS" (8 octets), uint32 version, uint32 marqueur 0x01020304 (ordre des octets)
+//   paramètres et scalaires de EtatReprise, dans l'ordre de déclaration
+//   (chaînes : uint32 longueur puis caractères ; booléens : 1 octet)
+//   tableaux h, hu, zb, d_zb (N doubles chacun)
+//   zones actives : nombre de blocs (int32), bloc_actif (1 octet par bloc), v_max_bloc
+//   frottement : nombre de coefficients (int32, 0 ou N), n de Manning par cellule
+//   uint64 somme de contrôle de tout ce qui précède
+// Les doubles sont copiés tels quels : l'état relu est identique bit à bit.
+// Le fichier est écrit sous nom.tmp, synchronisé sur le disque puis renommé, et le
+// répertoire est synchronisé après le renommage : un point de reprise est toujours
+// complet, l'ancien reste en place si l'écriture échoue. Seule la version 3 est lue.
+
+struct EtatReprise
+{
+    // Domaine et pas de temps
+    int N = 0;
+    double L = 0.0;
+    double dx = 0.0;
+    double CFL = 0.0;
+    double t = 0.0;
+    double dt = 0.0;
+    double h_fond = 0.0;
+    double critere_hauteur_deau = 0.0;
+    double critere_vitesse = 0.0;
+    double v_max = 0.0;          // Vitesse max calculée par le dernier pas
+    bool v_max_valide = false;
+
+    // Schéma
+    std::string schema;          // "flux/source"
+    int ordre = 1;
+    std::string limiteur;
+    bool zones_actives = false;
+    int taille_bloc = 0;
+    double tolerance_repos = 0.0;
+    bool pas_local = false;
+    int nb_niveaux_temps = 0;
+    bool frottement_implicite = true;
+
+    // Echéancier des sorties (voir SaintVenant1D::DefinirIntervalleSorties)
+    double intervalle_sorties = 0.0;   // 0 : pas de sorties à temps imposés
+    double t_debut_sorties = 0.0;
+    long long rang_sortie = 0;         // Echéances déjà atteintes
+
+    // Etat
+    std::vector<double> h, hu, zb, d_zb;
+    std::vector<char> bloc_actif;     // Zones actives seulement
+    std::vector<double> v_max_bloc;
+    std::vector<double> manning;      // Frottement seulement
+};
+
+// Retournent false (avec un message) si le fichier ne peut pas être écrit, ou s'il
+// est illisible, d'une autre version, d'une machine d'un autre boutisme ou corrompu
+bool EcrireReprise(const std::string& nom_fichier, const EtatReprise& etat);
+bool LireReprise(const std::string& nom_fichier, EtatReprise& etat);
+
+
+// ========================================
+// Ecriture des points de reprise en arrière-plan
+// ========================================
+// Le pas de temps copie l'état dans le tampon de l'écrivain (Preparer) puis rend la
+// main (Lancer) ; le fichier est écrit et synchronisé par un thread dédié. Si
+// l'écriture précédente n'est pas finie, Preparer retourne nullptr et l'appelant
+// réessaie au pas suivant : le calcul n'attend jamais le disque.
+class EcrivainReprise
+{
+private:
+    std::string _nom_fichier;
+    EtatReprise _etat;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _a_ecrire;   // _etat appartient au thread d'écriture
+    bool _arret;
+    long _nb_ecrites;
+    long _nb_echecs;
+
+    void Boucle();
+
+public:
+    explicit EcrivainReprise(const std::string& nom_fichier);
+
+    // Termine l'écriture en cours
+    ~EcrivainReprise();
+
+    const std::string& NomFichier() const { return _nom_fichier; }
+
+    // Tampon à remplir, ou nullptr si une écriture est en cours
+    EtatReprise* Preparer();
+    // Ecrit le tampon rempli
+    void Lancer();
+    // Attend la fin de l'écriture en cours
+    void Attendre();
+
+    long ObtenirNombreEcrites();
+    long ObtenirNombreEchecs();
+};
+
+#endif // _REPRISE_H
@@ -1,23 +1,49 @@
 #include "SaintVenant.h"
+#include "Schemas.h"
+#include "PoolThreads.h"
+#include "Reprise.h"
+#include "Bathymetrie.h"
+#include "Observateurs.h"
+#include "SortieTexte.h"
+#include "SortieBinaire.h"
+#include "SortieCompressee.h"
+#include "EcrivainSauvegardes.h"
+#include "DiffusionPartagee.h"
 #include <cmath>
 #include <iostream>
+#include <cstring>
+#include <cstdint>
 
 using namespace std;
 
-SaintVenant1D::SaintVenant1D() : _t(0.0)
+SaintVenant1D::SaintVenant1D() : _N(0), _t(0.0), _h_fond(0.0), _v_max(0.0), _v_max_valide(false),
+    _precision_sortie(6), _nb_tampons_sauvegarde(0), _sauvegardes_bloquantes(true),
+    _intervalle_sorties(0.0), _t_debut_sorties(0.0), _rang_sortie(0),
+    _t_limite_appel(HUGE_VAL), _t_limite(HUGE_VAL), _pas_raccourci(false),
+    _ordre(1), _nom_limiteur("minmod"), _etape_ordre2(nullptr),
+    _zones_actives(false), _taille_bloc(256), _tolerance_repos(1e-10), _cellules_calculees(0),
+    _pas_local(false), _nb_niveaux_temps(4), _gain_pas_local(1.0),
+    _v_max_threads(1, 0.0), _diagnostics_en_ligne(false),
+    _reprise_tous_les_pas(0), _reprise_toutes_les_secondes(0.0), _pas_depuis_reprise(0),
+    _diffusion_tous_les_pas(1), _pas_depuis_diffusion(0), _frottement_implicite(true)
 {
+    ChoisirSchema("hll/hydrostatique");
 }
 
 
 SaintVenant1D::~SaintVenant1D()
 {
-    if (_fichier.is_open())
-        _fichier.close();
+    // Instantanés en attente écrits avant la fermeture des sorties
+    _ecrivain_sauvegardes.reset();
 }
 
 
 void SaintVenant1D::Initialiser(int N, double L, double CFL, string nom_fichier)
 {
+    // Sauvegardes en attente écrites avant tout changement : le thread d'écriture lit
+    // _N, _dx et les sorties ouvertes
+    _ecrivain_sauvegardes.reset();
+
     _N = N;
     _L = L;
     _dx = L / N;  // Taille d'une cellule
@@ -29,9 +55,54 @@ void SaintVenant1D::Initialiser(int N, double L, double CFL, string nom_fichier)
     _hu.resize(N);
     _zb.resize(N); 
     _d_zb.resize(N);  
+    MettreAJourGeometrieFond();
+
+    // Tampons du pas de temps : une interface de plus que de cellules
+    _h_nouveau.resize(N);
+    _hu_nouveau.resize(N);
+    _face_hG.resize(N + 1);
+    _face_hD.resize(N + 1);
+    _flux_h.resize(N + 1);
+    _flux_hu.resize(N + 1);
+    if (_ordre == 2)
+        ChoisirOrdre(2, _nom_limiteur);
+    if (_zones_actives)
+        ActiverZonesActives(true, _taille_bloc, _tolerance_repos);
+    if (_pas_local)
+        ActiverPasDeTempsLocal(true, _nb_niveaux_temps);
+    _v_max_valide = false;
+    SV_INSTRUMENTER(_instrumentation.Reinitialiser());
+    _observateurs.reset();
+    _diffusion.reset();
+    _manning.clear();
+    _t_debut_sorties = 0.0;
+    _rang_sortie = 0;
     
-    // Ouvrir le fichier
-    _fichier.open(nom_fichier);
+    // Ouvrir le fichier (les sauvegardes en attente sont déjà écrites dans l'ancien)
+    _sortie_texte.reset();
+    _sortie_binaire.reset();
+    _sortie_compressee.reset();
+    if (EstSortieBinaire(nom_fichier))
+    {
+        _sortie_binaire.reset(new SortieBinaire());
+        if (!_sortie_binaire->Ouvrir(nom_fichier))
+            _sortie_binaire.reset();
+    }
+    else if (EstSortieCompressee(nom_fichier))
+    {
+        _sortie_compressee.reset(new SortieCompressee());
+        if (!_sortie_compressee->Ouvrir(nom_fichier))
+            _sortie_compressee.reset();
+    }
+    else if (!nom_fichier.empty())
+    {
+        _sortie_texte.reset(new SortieTexte());
+        _sortie_texte->DefinirPrecision(_precision_sortie);
+        if (!_sortie_texte->Ouvrir(nom_fichier))
+            _sortie_texte.reset();
+    }
+    if (_nb_tampons_sauvegarde > 0)
+        ActiverSauvegardesAsynchrones(true, _nb_tampons_sauvegarde, _sauvegardes_bloquantes);
     
     cout << "Simulation initialisée :" << endl;
     cout << "  - Nombre de cellules : " << N << endl;
@@ -40,6 +111,31 @@ void SaintVenant1D::Initialiser(int N, double L, double CFL, string nom_fichier)
 }
 
 
+void SaintVenant1D::DefinirNombreThreads(int nb_threads)
+{
+    if (nb_threads > 1)
+        _pool.reset(new PoolThreads(nb_threads));
+    else
+        _pool.reset();
+    _v_max_threads.assign(ObtenirNombreThreads(), 0.0);
+}
+
+
+int SaintVenant1D::ObtenirNombreThreads() const
+{
+    return _pool ? _pool->NombreThreads() : 1;
+}
+
+
+void SaintVenant1D::Parcourir(int debut, int fin, const function<void(int, int, int)>& tache)
+{
+    if (_pool)
+        _pool->ExecuterParMorceaux(debut, fin, tache);
+    else if (debut < fin)
+        tache(debut, fin, 0);
+}
+
+
 
 
     // ========================================
@@ -50,6 +146,7 @@ void SaintVenant1D::Initialiser(int N, double L, double CFL, string nom_fichier)
 
 
 void SaintVenant1D::ConditionInitialeDamBreak() {
+    _v_max_valide = false;
     for (int i = 0; i < _N; i++) {
         if (i < _N / 2) _h[i] = 10.0; // Gauche haute
         else            _h[i] = 5.0; // Droite basse
@@ -60,6 +157,7 @@ void SaintVenant1D::ConditionInitialeDamBreak() {
 
 void SaintVenant1D::ConditionInitialeSoliton(double A, double x_depart)
 {
+    _v_max_valide = false;
     double h0 = 2; // Profondeur au repos 
     _h_fond = h0;
     
@@ -112,6 +210,7 @@ void SaintVenant1D::ConditionInitialeSoliton(double A, double x_depart)
 
 void SaintVenant1D::ConditionInitialeGaussienne(double amplitude, double position_x, double largeur, double vitesse_init)
 {
+    _v_max_valide = false;
     double niveau_moyen = 0.2; 
     _h_fond = niveau_moyen;
     
@@ -175,6 +274,7 @@ void SaintVenant1D::DefinirFondPlat()
     }
     _h_fond = 1.0; // Valeur par défaut pour référence
     cout << "Bathymetrie : Fond plat (z=0)." << endl;
+    MettreAJourGeometrieFond();
 }
 
 
@@ -199,6 +299,7 @@ void SaintVenant1D::DefinirFondPente(double x_debut, double z_fin)
         }
     }
     cout << "Bathymetrie : Pente démarrant a x=" << x_debut << "m." << endl;
+    MettreAJourGeometrieFond();
 }
 
 
@@ -218,6 +319,7 @@ void SaintVenant1D::DefinirFondMarche(double x_marche, double z_haut)
         }
     }
     cout << "Bathymetrie : Marche d'escalier a x=" << x_marche << "m (Hauteur=" << z_haut << "m)." << endl;
+    MettreAJourGeometrieFond();
 }
 
 
@@ -256,6 +358,7 @@ void SaintVenant1D::DefinirFondPentePuisPlat(double x_debut, double x_fin, doubl
             _d_zb[i] = pente;
         }
     }
+    MettreAJourGeometrieFond();
 }
 
 
@@ -299,6 +402,51 @@ void SaintVenant1D::DefinirFondDoublePente(double x_debut, double x_cassure, dou
             _d_zb[i] = pente_2;
         }
     }
+    MettreAJourGeometrieFond();
+}
+
+
+bool SaintVenant1D::ChargerFond(const string& nom_fichier, double x_debut)
+{
+    ProfilFond profil;
+    if (!profil.Charger(nom_fichier))
+        return false;
+
+    profil.Reechantillonner(_N, _dx, x_debut, _zb.data());
+
+    // Pente par différences centrées (décentrées aux bords)
+    for (int i = 0; i < _N; i++)
+    {
+        int gauche = max(i - 1, 0), droite = min(i + 1, _N - 1);
+        _d_zb[i] = (droite > gauche) ? (_zb[droite] - _zb[gauche]) / ((droite - gauche) * _dx) : 0.0;
+    }
+    MettreAJourGeometrieFond();
+
+    double z_min = _zb[0], z_max = _zb[0];
+    for (int i = 1; i < _N; i++)
+    {
+        z_min = min(z_min, _zb[i]);
+        z_max = max(z_max, _zb[i]);
+    }
+    cout << "Bathymetrie : profil " << profil.Format() << " '" << nom_fichier << "' (" << profil.NombrePoints()
+         << " points, de x=" << profil.X(0) << " a x=" << profil.X(profil.NombrePoints() - 1) << "m), grille a partir de x="
+         << x_debut << "m, z de " << z_min << " a " << z_max << "m." << endl;
+    return true;
+}
+
+
+// Tables du fond par interface, lues par la boucle du pas de temps
+void SaintVenant1D::MettreAJourGeometrieFond()
+{
+    _z_interface.resize(_N + 1);
+    _saut_zb.resize(_N + 1);
+    ConstruireGeometrieFond(_N, _zb.data(), _z_interface.data(), _saut_zb.data());
+}
+
+
+GeometrieFond SaintVenant1D::Fond() const
+{
+    return { _zb.data(), _z_interface.data(), _saut_zb.data() };
 }
 
 
@@ -426,11 +574,11 @@ void SaintVenant1D::FluxRusanov(double hL, double huL, double hR, double huR, do
 // Calculer la vitesse maximale dans le domaine
 // Sert pour la condition CFL
 // ========================================
-double SaintVenant1D::VitesseMaximale()
+double SaintVenant1D::VitesseMaximaleMorceau(int i_debut, int i_fin)
 {
     double v_max = 0.0;
     
-    for (int i = 0; i < _N; i++)
+    for (int i = i_debut; i < i_fin; i++)
     {
         double u = CalculerVitesse(_h[i], _hu[i]);
         double c = 0.0;
@@ -445,218 +593,1781 @@ double SaintVenant1D::VitesseMaximale()
 }
 
 
+double SaintVenant1D::VitesseMaximale()
+{
+    // Maximum partiel par thread puis maximum des maxima (le max est exact, donc
+    // indépendant du découpage)
+    fill(_v_max_threads.begin(), _v_max_threads.end(), 0.0);
+    Parcourir(0, _N, [this](int d, int f, int id) { _v_max_threads[id] = VitesseMaximaleMorceau(d, f); });
+
+    double v_max = 0.0;
+    for (size_t k = 0; k < _v_max_threads.size(); k++)
+        v_max = max(v_max, _v_max_threads[k]);
+    return v_max;
+}
+
+
 // ========================================
 // Calculer le pas de temps avec CFL
 // dt = CFL * dx / vitesse_max
 // ========================================
 void SaintVenant1D::CalculerPasDeTemps()
 {
-    double v_max = VitesseMaximale();
+    SV_PHASE(_instrumentation, PHASE_PAS_DE_TEMPS);
+
+    // La vitesse max est fournie par le pas précédent quand l'état n'a pas changé depuis
+    double v_max = _v_max_valide ? _v_max : VitesseMaximale();
     
     if (v_max > critere_vitesse)
         _dt = _CFL * _dx / v_max;
     else
         _dt = 0.01;  // Valeur par défaut si v_max = 0
+
+    // Frottement explicite : pas limité par la raideur du terme (voir DefinirFrottement)
+    if (!_manning.empty() && !_frottement_implicite)
+        _dt = min(_dt, PasFrottementExplicite());
+
+    // Dernier pas avant une échéance : raccourci pour l'atteindre exactement (le
+    // macro-pas du pas de temps local, multiple de dt, ne peut pas l'être)
+    _pas_raccourci = !_pas_local && _t < _t_limite && _t + _dt >= _t_limite;
+    if (_pas_raccourci)
+        _dt = _t_limite - _t;
 }
 
 
 // ========================================
-// Avancer d'un pas de temps
-// Schéma de Godunov avec flux de rosunov ou HLL
-// =======================================
-void SaintVenant1D::Avancer()
+// Frottement sur le fond (loi de Manning)
+// ========================================
+void SaintVenant1D::DefinirFrottement(double n_manning)
 {
-    CalculerPasDeTemps();
+    if (n_manning > 0.0)
+        _manning.assign(_N, n_manning);
+    else
+        _manning.clear();
+}
 
-    vector<double> h_nouveau(_N);
-    vector<double> hu_nouveau(_N);
-    double coeff = _dt / _dx;
-   
-    for (int i = 1; i < _N - 1; i++)
+
+bool SaintVenant1D::DefinirFrottementParCellule(const vector<double>& n_manning)
+{
+    if ((int)n_manning.size() != _N)
+    {
+        cout << "Erreur : " << n_manning.size() << " coefficients de Manning pour " << _N << " cellules" << endl;
+        return false;
+    }
+    for (size_t i = 0; i < n_manning.size(); i++)
     {
+        if (!(n_manning[i] >= 0.0))
+        {
+            cout << "Erreur : coefficient de Manning " << n_manning[i] << " invalide en cellule " << i << endl;
+            return false;
+        }
+    }
+    _manning = n_manning;
+    return true;
+}
 
-        // 1. Interface GAUCHE (entre i-1 et i)
-        // ------------------------------------
-        // On prend le "plus haut" fond à l'interface
-        double z_inter_G = max(_zb[i-1], _zb[i]);
-        
-        double h_G_L = max(0.0, _h[i-1] + _zb[i-1] - z_inter_G); // Gauche de l'interface
-        double h_G_R = max(0.0, _h[i]   + _zb[i]   - z_inter_G); // Droite de l'interface
-        
-        // Calcul du flux GAUCHE avec les hauteurs reconstruites
-        double flux_gauche_h, flux_gauche_hu;
-        FluxHLL(h_G_L, _hu[i-1], h_G_R, _hu[i], flux_gauche_h, flux_gauche_hu);
 
-        // 2. Interface DROITE (entre i et i+1)
-        // ------------------------------------
-        double z_inter_D = max(_zb[i], _zb[i+1]);
+// h^(4/3) = h cbrt(h) sans appel de fonction, pour que les boucles du frottement soient
+// vectorisées : estimation de cbrt(h) sur les bits du float (exposant divisé par 3),
+// puis trois itérations de Halley, y <- y (y³ + 2h) / (2y³ + h), qui triplent chacune
+// le nombre de chiffres exacts (arrondi près). h > 0 normal.
+static inline double PuissanceQuatreTiers(double h)
+{
+    float h_f = (float)h;
+    int32_t bits;
+    memcpy(&bits, &h_f, sizeof(bits));
+    bits = (int32_t)((float)bits * (1.0f / 3.0f)) + 709921077;
+    float y_f;
+    memcpy(&y_f, &bits, sizeof(y_f));
+    double y = y_f;
+    for (int k = 0; k < 3; k++)
+    {
+        double y3 = y * y * y;
+        y = y * (y3 + 2.0 * h) / (2.0 * y3 + h);
+    }
+    return h * y;
+}
+
 
-        double h_D_L = max(0.0, _h[i]   + _zb[i]   - z_inter_D); // Gauche de l'interface
-        double h_D_R = max(0.0, _h[i+1] + _zb[i+1] - z_inter_D); // Droite de l'interface
-        
-        // Calcul du flux DROITE avec les hauteurs reconstruites
-        double flux_droite_h, flux_droite_hu;
-        FluxHLL(h_D_L, _hu[i], h_D_R, _hu[i+1], flux_droite_h, flux_droite_hu);
+// dt g n² |u| / h^(4/3) avec |u| = |hu| / h, nul dans une cellule sèche (h <= critere_h).
+// Sans branchement (la boucle reste vectorisable) : la division est toujours faite, sur
+// max(h, critere_h), et n est remplacé par 0 dans les cellules sèches.
+static inline double RaideurFrottement(double h, double hu, double n, double dt_g, double critere_h)
+{
+    const bool mouillee = h > critere_h;
+    double h_calcul = mouillee ? h : critere_h;
+    double n_calcul = mouillee ? n : 0.0;
+    return dt_g * n_calcul * n_calcul * fabs(hu) / (h_calcul * PuissanceQuatreTiers(h_calcul));
+}
 
 
-        // 3. Calcul du TERME SOURCE (Equilibre Hydrostatique)
-        // ------------------------------------        
-        double TermeSource_G = 0.5 * _g * (pow(h_G_R, 2) - pow(_h[i], 2));
-        double TermeSource_D = 0.5 * _g * (pow(h_D_L, 2) - pow(_h[i], 2));
-        
-        // Somme des sources (c'est un terme de force, pas un flux)
-        double Source_WellBalanced = TermeSource_G + TermeSource_D;
+// Cellules [i_debut, i_fin) après le pas hyperbolique, sur la durée dt (schéma d'ordre 1 :
+// fait dans MettreAJourCellules). Les cellules sèches (h <= critere_hauteur_deau) ne sont
+// pas touchées : NettoyerCellules les vide. h ne varie pas sous l'effet du frottement : la
+// mise à jour semi-implicite est la solution exacte de d(hu)/dt = -g n² |hu| hu / h^(7/3)
+// sur la durée dt. Le facteur explicite n'est pas borné (Euler explicite tel quel, pour
+// comparaison) : le pas de PasFrottementExplicite est calculé sur l'état avant le pas
+// hyperbolique, et un film mince que ce pas rend plus raide peut avoir un facteur
+// négatif (hu change de signe).
+void SaintVenant1D::AppliquerFrottement(const double* h, double* hu, int i_debut, int i_fin, double dt) const
+{
+    const double* n = _manning.data();
+    const double dt_g = dt * _g, critere_h = critere_hauteur_deau;
+    if (_frottement_implicite)
+        for (int i = i_debut; i < i_fin; i++)
+            hu[i] /= 1.0 + RaideurFrottement(h[i], hu[i], n[i], dt_g, critere_h);
+    else
+        for (int i = i_debut; i < i_fin; i++)
+            hu[i] *= 1.0 - RaideurFrottement(h[i], hu[i], n[i], dt_g, critere_h);
+}
+
+
+// Pas pour lequel le facteur explicite 1 - dt g n² |u| / h^(4/3) vaut au moins
+// 1 - CFL dans toutes les cellules mouillées de l'état courant (avant le pas : le
+// facteur appliqué après le pas hyperbolique n'est pas garanti positif)
+double SaintVenant1D::PasFrottementExplicite() const
+{
+    // Taux maximal g n² |u| / h^(4/3) (nul dans les cellules sèches)
+    double taux_max = 0.0;
+    for (int i = 0; i < _N; i++)
+        taux_max = max(taux_max, RaideurFrottement(_h[i], _hu[i], _manning[i], _g, critere_hauteur_deau));
+    return (taux_max > 0.0) ? _CFL / taux_max : HUGE_VAL;
+}
+
+
+// ========================================
+// Etapes du pas de temps, sur une partie du domaine
+// ========================================
+
+// Reconstruction et flux des interfaces [f_debut, f_fin)
+template <class Flux, class Source>
+void SaintVenant1D::CalculerInterfaces(int f_debut, int f_fin)
+{
+    // 1. RECONSTRUCTION aux interfaces (entre f-1 et f)
+    // ------------------------------------
+    const GeometrieFond fond = Fond();
+    for (int f = f_debut; f < f_fin; f++)
+        Source::Reconstruire(_h.data(), fond, f, _face_hG[f], _face_hD[f]);
+
+    // 2. FLUX de toutes ces interfaces en un seul lot
+    // Le débit à gauche de l'interface f est _hu[f-1], à droite _hu[f]
+    // ------------------------------------
+    Flux::Lot(f_fin - f_debut, &_face_hG[f_debut], &_hu[f_debut - 1], &_face_hD[f_debut], &_hu[f_debut],
+              &_flux_h[f_debut], &_flux_hu[f_debut], _g, critere_hauteur_deau);
+
+#ifdef SV_INSTRUMENTATION
+    // Régime des ondes (HLL seulement : Rusanov n'a pas de cas)
+    if (strcmp(Flux::Nom(), "rusanov") != 0)
+        _instrumentation.ClasserInterfaces(f_fin - f_debut, &_face_hG[f_debut], &_hu[f_debut - 1], &_face_hD[f_debut],
+                                           &_hu[f_debut], _g, critere_hauteur_deau);
+#endif
+}
 
 
-        // 4. MISE A JOUR
-        // ------------------------------------
-        h_nouveau[i] = _h[i] - coeff * (flux_droite_h - flux_gauche_h);
-        hu_nouveau[i] = _hu[i] - coeff * (flux_droite_hu - flux_gauche_hu) + coeff * Source_WellBalanced;
+// Mise à jour des cellules [i_debut, i_fin) suivie du frottement de Manning sur la durée
+// dt_g / g (même calcul que AppliquerFrottement), en un seul passage vectorisable
+// (le traitement est un paramètre du modèle : pas de branchement dans la boucle)
+template <class Source, bool Implicite>
+static void MettreAJourFrottement(int i_debut, int i_fin, const double* __restrict h, const double* __restrict hu,
+                                  const GeometrieFond& fond, const double* __restrict face_hG,
+                                  const double* __restrict face_hD, const double* __restrict flux_h,
+                                  const double* __restrict flux_hu, const double* __restrict n, double coeff,
+                                  double g, double dt_g, double critere_h,
+                                  double* __restrict h_nouveau, double* __restrict hu_nouveau)
+{
+    for (int i = i_debut; i < i_fin; i++)
+    {
+        double Source_i = Source::Source(h, fond, face_hG, face_hD, i, g);
+
+        double h_n = h[i] - coeff * (flux_h[i+1] - flux_h[i]);
+        double hu_n = hu[i] - coeff * (flux_hu[i+1] - flux_hu[i]) + coeff * Source_i;
+        double raideur = RaideurFrottement(h_n, hu_n, n[i], dt_g, critere_h);
+        h_nouveau[i] = h_n;
+        // Semi-implicite : hu / (1 + raideur) ; explicite : hu (1 - raideur)
+        hu_nouveau[i] = Implicite ? hu_n / (1.0 + raideur) : hu_n * (1.0 - raideur);
     }
-    
-    //Conditions limite fenetre ouverte
-    // Bord Gauche
-    h_nouveau[0] = h_nouveau[1];
-    hu_nouveau[0] = hu_nouveau[1];
-    // Bord Droit (pente)
-    double H_voisin = h_nouveau[_N-2] + _zb[_N-2];
-    h_nouveau[_N-1] = max(0.0, H_voisin - _zb[_N-1]);
-    hu_nouveau[_N-1] = hu_nouveau[_N-2];
-    
-    for (int i = 0; i < _N; i++) 
+}
+
+
+// Mise à jour des cellules intérieures [i_debut, i_fin), avec le frottement (voir
+// AppliquerFrottement) dans le même balayage s'il est défini
+template <class Flux, class Source>
+void SaintVenant1D::MettreAJourCellules(int i_debut, int i_fin, double coeff)
+{
+    const double* h = _h.data();
+    const GeometrieFond fond = Fond();
+    const double* face_hG = _face_hG.data();
+    const double* face_hD = _face_hD.data();
+
+    if (_manning.empty())
     {
-        if (h_nouveau[i] < critere_hauteur_deau) 
+        for (int i = i_debut; i < i_fin; i++)
         {
-            h_nouveau[i] = 0.0;  // Hauteur nulle
-            hu_nouveau[i] = 0.0; // Vitesse nulle 
+            // Interface GAUCHE = f = i, interface DROITE = f = i+1
+            double Source_i = Source::Source(h, fond, face_hG, face_hD, i, _g);
+
+            _h_nouveau[i] = _h[i] - coeff * (_flux_h[i+1] - _flux_h[i]);
+            _hu_nouveau[i] = _hu[i] - coeff * (_flux_hu[i+1] - _flux_hu[i]) + coeff * Source_i;
         }
+        return;
     }
 
-    // //  Conditions aux limites : réflexion
-    // h_nouveau[0] = h_nouveau[1];
-    // hu_nouveau[0] = -hu_nouveau[1];
-    // h_nouveau[_N-1] = h_nouveau[_N-2];
-    // hu_nouveau[_N-1] = -hu_nouveau[_N-2];
-    
-    //  Copier la nouvelle solution
-    _h = h_nouveau;
-    _hu = hu_nouveau;
-    
-    //  Avancer le temps
-    _t += _dt;
+    auto mise_a_jour = _frottement_implicite ? MettreAJourFrottement<Source, true>
+                                             : MettreAJourFrottement<Source, false>;
+    mise_a_jour(i_debut, i_fin, h, _hu.data(), fond, face_hG, face_hD, _flux_h.data(), _flux_hu.data(),
+                _manning.data(), coeff, _g, _dt * _g, critere_hauteur_deau, _h_nouveau.data(), _hu_nouveau.data());
 }
 
 
-// ========================================
-// Sauvegarder la solution dans le fichier
-// Format : temps x h u
-// ========================================
-void SaintVenant1D::Sauvegarder()
+// Mise à jour des cellules [i_debut, i_fin), hors cellules de bord, et de leurs interfaces
+// Tout le domaine (0, N) : interfaces 1 .. N-1 puis cellules intérieures 1 .. N-2
+template <class Flux, class Source>
+void SaintVenant1D::CalculerFluxEtMiseAJour(int i_debut, int i_fin, double coeff)
 {
-    for (int i = 0; i < _N; i++)
+    int c_debut = max(1, i_debut), c_fin = min(_N - 1, i_fin);
+
     {
-        double x = (i + 0.5) * _dx;
-        double u = CalculerVitesse(_h[i], _hu[i]);
-        double zb = _zb[i];
-        double H = _h[i] + zb; // Surface libre (Niveau de l'eau)
-        
-        // On écrit : t x h u zb H
-        _fichier << _t << " " << x << " " << _h[i] << " " << u << " " << zb << " " << H << endl;
+        SV_PHASE(_instrumentation, PHASE_FLUX);
+        Parcourir(c_debut, c_fin + 1, [this](int d, int f, int) { CalculerInterfaces<Flux, Source>(d, f); });
     }
-    _fichier << endl;
+    SV_PHASE(_instrumentation, PHASE_MISE_A_JOUR);
+    Parcourir(c_debut, c_fin, [this, coeff](int d, int f, int) { MettreAJourCellules<Flux, Source>(d, f, coeff); });
 }
 
 
+bool SaintVenant1D::ChoisirSchema(const string& config)
+{
+    // Toutes les combinaisons compilées
+    struct EntreeSchema
+    {
+        const char* flux;
+        const char* source;
+        FonctionSchema fonction;
+        FonctionInterfacesLocales locale;
+    };
+    static const EntreeSchema schemas[] = {
+        { FluxPolitiqueRusanov::Nom(), SourceHydrostatique::Nom(),
+          &SaintVenant1D::CalculerFluxEtMiseAJour<FluxPolitiqueRusanov, SourceHydrostatique>,
+          &SaintVenant1D::CalculerInterfacesLocales<FluxPolitiqueRusanov, SourceHydrostatique> },
+        { FluxPolitiqueHLL::Nom(),     SourceHydrostatique::Nom(),
+          &SaintVenant1D::CalculerFluxEtMiseAJour<FluxPolitiqueHLL,     SourceHydrostatique>,
+          &SaintVenant1D::CalculerInterfacesLocales<FluxPolitiqueHLL,     SourceHydrostatique> },
+        { FluxPolitiqueRusanov::Nom(), SourcePenteCentree::Nom(),
+          &SaintVenant1D::CalculerFluxEtMiseAJour<FluxPolitiqueRusanov, SourcePenteCentree>,
+          &SaintVenant1D::CalculerInterfacesLocales<FluxPolitiqueRusanov, SourcePenteCentree> },
+        { FluxPolitiqueHLL::Nom(),     SourcePenteCentree::Nom(),
+          &SaintVenant1D::CalculerFluxEtMiseAJour<FluxPolitiqueHLL,     SourcePenteCentree>,
+          &SaintVenant1D::CalculerInterfacesLocales<FluxPolitiqueHLL,     SourcePenteCentree> },
+    };
+
+    // "flux/source" ou "flux" seul (source hydrostatique par défaut)
+    size_t separateur = config.find('/');
+    string flux = NomFluxEffectif(config.substr(0, separateur));
+    string source = (separateur == string::npos) ? SourceHydrostatique::Nom() : config.substr(separateur + 1);
+
+    for (const EntreeSchema& entree : schemas)
+    {
+        if (flux == entree.flux && source == entree.source)
+        {
+            if (_ordre == 2 && source != SourceHydrostatique::Nom())
+            {
+                cout << "Erreur : source '" << source << "' non disponible a l'ordre 2 (hydrostatique seulement)" << endl;
+                return false;
+            }
+            _schema = entree.fonction;
+            _interfaces_locales = entree.locale;
+            _nom_schema = flux + "/" + source;
+            _nom_flux = flux;
+            _nom_source = source;
+            if (_ordre == 2)
+                ChoisirEtapeOrdre2();
+            return true;
+        }
+    }
+
+    cout << "Erreur : schema inconnu '" << config << "' (flux : rusanov, hll ; source : hydrostatique, pente)" << endl;
+    return false;
+}
+
 
+void SaintVenant1D::AppliquerConditionsLimites(double* h, double* hu)
+{
+    SV_PHASE(_instrumentation, PHASE_LIMITES);
 
+    //Conditions limite fenetre ouverte
+    // Bord Gauche
+    h[0] = h[1];
+    hu[0] = hu[1];
+    // Bord Droit (pente)
+    double H_voisin = h[_N-2] + _zb[_N-2];
+    h[_N-1] = max(0.0, H_voisin - _zb[_N-1]);
+    hu[_N-1] = hu[_N-2];
 
+    // //  Conditions aux limites : réflexion
+    // h[0] = h[1];
+    // hu[0] = -hu[1];
+    // h[_N-1] = h[_N-2];
+    // hu[_N-1] = -hu[_N-2];
+}
 
-// ============================
-// Validation et information
-// ============================
 
+// Nettoyage des cellules sèches de [i_debut, i_fin) et vitesse max de l'état nettoyé
+// (même calcul que VitesseMaximale, fait dans le même balayage)
+double SaintVenant1D::NettoyerCellules(double* h, double* hu, int i_debut, int i_fin)
+{
+    double v_max = 0.0;
+#ifdef SV_INSTRUMENTATION
+    long nb_seches = 0, nb_ecretages = 0;
+#endif
+    for (int i = i_debut; i < i_fin; i++) 
+    {
+        if (h[i] < critere_hauteur_deau) 
+        {
+#ifdef SV_INSTRUMENTATION
+            nb_ecretages += (h[i] != 0.0 || hu[i] != 0.0);
+            nb_seches++;
+#endif
+            h[i] = 0.0;  // Hauteur nulle
+            hu[i] = 0.0; // Vitesse nulle 
+        }
 
+        double u = CalculerVitesse(h[i], hu[i]);
+        double c = 0.0;
+        if (h[i] > 1e-10) 
+            c = sqrt(_g * h[i]);
+        v_max = max(v_max, fabs(u) + c);
+    }
+    SV_COMPTER(_instrumentation, COMPTEUR_CELLULES_SECHES, nb_seches);
+    SV_COMPTER(_instrumentation, COMPTEUR_ECRETAGES, nb_ecretages);
+    return v_max;
+}
 
 
+// Une échéance t0 + k intervalle calculée en flottant peut manquer d'un arrondi le temps
+// visé (3 * 0.1 = 0.30000000000000004) : à cette fraction de l'intervalle près, les
+// deux sont confondus
+static const double TOLERANCE_ECHEANCE = 1e-9;
 
 
-double SaintVenant1D::CalculerMasseTotale()
+// ========================================
+// Avancer d'un pas de temps
+// Schéma de Godunov avec flux de rosunov ou HLL (voir ChoisirSchema)
+// Chaque flux d'interface est calculé une seule fois, puis les cellules
+// sont mises à jour à partir des tableaux d'interfaces.
+// Chaque étape est répartie entre les threads s'il y en a.
+// =======================================
+double SaintVenant1D::Avancer()
 {
-    double volume_total = 0.0;
-    
-    // On somme la hauteur d'eau de toutes les cellules
-    for (int i = 0; i < _N; i++)
+    SV_PHASE(_instrumentation, PHASE_AVANCER);
+
+    // Une échéance à un arrondi près de t_limite est atteinte en t_limite (voir FinDePas)
+    double echeance = ProchaineSortie();
+    _t_limite = (echeance < _t_limite_appel - TOLERANCE_ECHEANCE * _intervalle_sorties) ? echeance : _t_limite_appel;
+
+    if (_ordre == 2 || _pas_local || _zones_actives)
+    {
+        double v_max = (_ordre == 2) ? AvancerOrdre2() : _pas_local ? AvancerPasLocal() : AvancerZonesActives();
+        if (_diagnostics_en_ligne)
+            PasserDiagnostics(_h.data(), _hu.data(), false, _diagnostics);
+        FinDePas();
+        return v_max;
+    }
+
+    CalculerPasDeTemps();
+
+    double coeff = _dt / _dx;
+
+    // 1. Interfaces 1 .. N-1 puis cellules intérieures 1 .. N-2 (schéma choisi)
+    (this->*_schema)(0, _N, coeff);
+
+    // 2. Bords
+    AppliquerConditionsLimites(_h_nouveau.data(), _hu_nouveau.data());
+
+    // 3. Cellules sèches et vitesse max (réduction par thread), avec les diagnostics
+    // du nouvel état dans le même balayage s'ils sont demandés
+    double v_max = 0.0;
+    if (_diagnostics_en_ligne)
+    {
+        v_max = PasserDiagnostics(_h_nouveau.data(), _hu_nouveau.data(), true, _diagnostics);
+        _diagnostics.t = _t + _dt;
+    }
+    else
     {
-        volume_total += _h[i];
+        SV_PHASE(_instrumentation, PHASE_NETTOYAGE);
+        fill(_v_max_threads.begin(), _v_max_threads.end(), 0.0);
+        Parcourir(0, _N, [this](int d, int f, int id)
+        {
+            _v_max_threads[id] = NettoyerCellules(_h_nouveau.data(), _hu_nouveau.data(), d, f);
+        });
+        for (size_t k = 0; k < _v_max_threads.size(); k++)
+            v_max = max(v_max, _v_max_threads[k]);
     }
     
-    // Volume = Somme des hauteurs * largeur d'une cellule
-    return volume_total * _dx;
+    //  Echanger les tampons (pas de copie)
+    _h.swap(_h_nouveau);
+    _hu.swap(_hu_nouveau);
+    _v_max = v_max;
+    _v_max_valide = true;
+    
+    //  Avancer le temps
+    AvancerHorloge();
+    FinDePas();
+
+    return v_max;
 }
 
 
-double SaintVenant1D::ObtenirSurfaceMax()
+double SaintVenant1D::Avancer(double t_limite)
 {
-    // On cherche l'altitude maximale atteinte par l'eau (H = h + zb)
-    // On initialise très bas
-    double H_max = -99999.0; 
-    
-    for (int i = 0; i < _N; i++)
+    _t_limite_appel = t_limite;
+    double v_max = Avancer();
+    _t_limite_appel = HUGE_VAL;
+    return v_max;
+}
+
+
+// t += dt, ou exactement l'échéance si le pas a été raccourci pour l'atteindre
+void SaintVenant1D::AvancerHorloge()
+{
+    _t = _pas_raccourci ? _t_limite : _t + _dt;
+    _pas_raccourci = false;
+}
+
+
+// Sauvegardes planifiées, jauges et reprises, à la fin de chaque pas
+void SaintVenant1D::FinDePas()
+{
+    SV_INSTRUMENTER(_instrumentation.EnregistrerPasDeTemps(_dt));
+    if (_observateurs)
+        _observateurs->Observer(_t, _h.data(), _hu.data(), _zb.data());
+    // Le temps t_limite d'Avancer(t_limite), fin du calcul, est aussi une échéance : l'état
+    // final est sauvegardé même si t_limite n'est pas sur l'échéancier (ou le manque d'un
+    // arrondi)
+    double marge = TOLERANCE_ECHEANCE * _intervalle_sorties;
+    if (_intervalle_sorties > 0.0 && (_t + marge >= ProchaineSortie() || _t >= _t_limite_appel))
     {
-        // On ne regarde que s'il y a un peu d'eau (pour éviter les bugs sur sol sec)
-        if (_h[i] > 1e-6) 
-        {
-            double H_actuel = _h[i] + _zb[i];
-            if (H_actuel > H_max) 
-            {
-                H_max = H_actuel;
-            }
-        }
+        Sauvegarder();
+        // Un macro-pas (pas de temps local) peut franchir plusieurs échéances
+        while (ProchaineSortie() <= _t + marge)
+            _rang_sortie++;
     }
-    return H_max;
+    if (_diffusion && ++_pas_depuis_diffusion >= _diffusion_tous_les_pas)
+    {
+        _diffusion->Publier(_t, _h.data(), _hu.data());
+        _pas_depuis_diffusion = 0;
+    }
+    if (_ecrivain_reprise)
+        ReprisePeriodique();
 }
 
 
-double SaintVenant1D::ObtenirPositionCrete()
+double SaintVenant1D::ProchaineSortie() const
 {
-    double H_max = -99999.0;
-    int i_max = 0;
-    
-    // On cherche l'altitude MAXIMALE de la surface (H)
-    for (int i = 0; i < _N; i++)
+    if (_intervalle_sorties <= 0.0)
+        return HUGE_VAL;
+    return _t_debut_sorties + (_rang_sortie + 1) * _intervalle_sorties;
+}
+
+
+void SaintVenant1D::DefinirIntervalleSorties(double intervalle)
+{
+    _intervalle_sorties = max(0.0, intervalle);
+    _t_debut_sorties = _t;
+    _rang_sortie = 0;
+}
+
+
+// ========================================
+// Suivi des zones actives
+// ========================================
+void SaintVenant1D::ActiverZonesActives(bool actif, int taille_bloc, double tolerance)
+{
+    if (taille_bloc < 1)
     {
-        double H_actuel = _h[i] + _zb[i];
-        
-        // On ne considère que les zones mouillées
-        if (_h[i] > 1e-4 && H_actuel > H_max)
-        {
-            H_max = H_actuel;
-            i_max = i;
-        }
+        cout << "Erreur : taille de bloc " << taille_bloc << " invalide (>= 1)" << endl;
+        return;
     }
-    
-    return (i_max + 0.5) * _dx;
+
+    _zones_actives = actif;
+    _taille_bloc = taille_bloc;
+    _tolerance_repos = tolerance;
+
+    // Au départ tout est actif : le premier pas détermine les zones au repos
+    int nb_blocs = (_N + taille_bloc - 1) / taille_bloc;
+    _bloc_actif.assign(nb_blocs, 1);
+    _v_max_bloc.assign(nb_blocs, 0.0);
+    _plages.clear();
+    _cellules_calculees = _N;
 }
 
 
-double SaintVenant1D::CalculerEnergieTotale()
+double SaintVenant1D::ObtenirFractionActive() const
 {
-    double energie_totale = 0.0;
-    
-    for (int i = 0; i < _N; i++)
+    if (!_zones_actives || _N == 0)
+        return 1.0;
+    return (double)_cellules_calculees / _N;
+}
+
+
+// ========================================
+// Avancer d'un pas de temps en ne calculant que les zones actives
+// ========================================
+// Avec CFL <= 1, l'information parcourt au plus une cellule par pas : calculer les
+// voisins de chaque bloc actif (halo d'un bloc) suffit pour qu'aucune onde n'entre
+// dans un bloc non calculé. Un bloc calculé qui n'a pas évolué de plus de
+// _tolerance_repos redevient inactif au pas suivant.
+double SaintVenant1D::AvancerZonesActives()
+{
+    int nb_blocs = (int)_bloc_actif.size();
+    int B = _taille_bloc;
+
+    // Etat modifié en dehors d'Avancer : tout recalculer
+    if (!_v_max_valide)
+        fill(_bloc_actif.begin(), _bloc_actif.end(), 1);
+
+    CalculerPasDeTemps();
+
+    double coeff = _dt / _dx;
+
+    // 1. Plages calculées (blocs actifs et leurs voisins, fusionnés) ;
+    //    les autres cellules sont recopiées telles quelles
+    _plages.clear();
+    for (int b = 0; b < nb_blocs; b++)
     {
-        // 1. Energie Potentielle : 1/2 * g * h^2
-        double Ep = 0.5 * _g * _h[i] * _h[i];
-        
-        // 2. Energie Cinétique : 1/2 * h * u^2  (ou 1/2 * (hu)^2 / h)
-        double Ec = 0.0;
-        if (_h[i] > 1e-10) {
+        bool calcule = _bloc_actif[b] || (b > 0 && _bloc_actif[b-1]) || (b + 1 < nb_blocs && _bloc_actif[b+1]);
+        int d = b * B, f = min(_N, d + B);
+        if (calcule)
+        {
+            if (!_plages.empty() && _plages.back().second == d)
+                _plages.back().second = f;
+            else
+                _plages.push_back(make_pair(d, f));
+        }
+        else
+        {
+            copy(_h.begin() + d, _h.begin() + f, _h_nouveau.begin() + d);
+            copy(_hu.begin() + d, _hu.begin() + f, _hu_nouveau.begin() + d);
+        }
+    }
+
+    // 2. Interfaces et cellules des plages calculées (schéma choisi)
+    for (size_t k = 0; k < _plages.size(); k++)
+        (this->*_schema)(_plages[k].first, _plages[k].second, coeff);
+
+    // 3. Bords
+    AppliquerConditionsLimites(_h_nouveau.data(), _hu_nouveau.data());
+
+    // 4. Cellules sèches, vitesse max et évolution de chaque bloc calculé
+    _cellules_calculees = 0;
+    for (size_t k = 0; k < _plages.size(); k++)
+    {
+        _cellules_calculees += _plages[k].second - _plages[k].first;
+        Parcourir(_plages[k].first / B, (_plages[k].second + B - 1) / B, [this, B](int b_debut, int b_fin, int)
+        {
+            for (int b = b_debut; b < b_fin; b++)
+            {
+                int d = b * B, f = min(_N, d + B);
+                _v_max_bloc[b] = NettoyerCellules(_h_nouveau.data(), _hu_nouveau.data(), d, f);
+
+                double ecart = 0.0;
+                for (int i = d; i < f; i++)
+                    ecart = max(ecart, max(fabs(_h_nouveau[i] - _h[i]), fabs(_hu_nouveau[i] - _hu[i])));
+                _bloc_actif[b] = ecart > _tolerance_repos;
+            }
+        });
+    }
+
+    // Les blocs non calculés gardent leur vitesse max
+    double v_max = 0.0;
+    for (int b = 0; b < nb_blocs; b++)
+        v_max = max(v_max, _v_max_bloc[b]);
+
+    //  Echanger les tampons (pas de copie)
+    _h.swap(_h_nouveau);
+    _hu.swap(_hu_nouveau);
+    _v_max = v_max;
+    _v_max_valide = true;
+
+    //  Avancer le temps
+    AvancerHorloge();
+
+    return v_max;
+}
+
+
+// ========================================
+// Pas de temps local (multirate)
+// ========================================
+void SaintVenant1D::ActiverPasDeTempsLocal(bool actif, int nb_niveaux)
+{
+    if (nb_niveaux < 1 || nb_niveaux > 16)
+    {
+        cout << "Erreur : nombre de niveaux de pas de temps " << nb_niveaux << " invalide (1 .. 16)" << endl;
+        return;
+    }
+
+    _pas_local = actif;
+    _nb_niveaux_temps = nb_niveaux;
+    _niveau_temps.assign(_N, 0);
+    _vitesse_locale.assign(_N, 0.0);
+    _vitesse_fenetre.assign(_N, 0.0);
+    _cumul_h.assign(_N, 0.0);
+    _cumul_hu.assign(_N, 0.0);
+    _faces_niveau.assign(nb_niveaux, vector<pair<int, int> >());
+    _cellules_niveau.assign(nb_niveaux, vector<pair<int, int> >());
+    _gain_pas_local = 1.0;
+    _v_max_valide = false;  // Les vitesses locales sont à calculer
+}
+
+
+// Vitesse |u| + c de chaque cellule (pour le classement), retourne la plus grande
+double SaintVenant1D::CalculerVitessesLocales()
+{
+    double v_max = 0.0;
+    for (int i = 0; i < _N; i++)
+    {
+        double u = CalculerVitesse(_h[i], _hu[i]);
+        double c = 0.0;
+        if (_h[i] > 1e-10)
+            c = sqrt(_g * _h[i]);
+        _vitesse_locale[i] = fabs(u) + c;
+        v_max = max(v_max, _vitesse_locale[i]);
+    }
+    return v_max;
+}
+
+
+// Niveau de chaque cellule : plus grand k tel que 2^k dt_min respecte la CFL pour
+// toutes les vitesses à moins de 2^(K-1) cellules. Les niveaux restent fixes pendant
+// le macro-pas, au plus 2^(K-1) dt_min, et une onde parcourt au plus une cellule par
+// dt_min : rien de plus rapide ne peut atteindre la cellule avant le classement suivant.
+void SaintVenant1D::ClasserNiveauxTemps(double dt_min)
+{
+    int K = _nb_niveaux_temps;
+
+    // Vitesses calculées à la fin du macro-pas précédent, sauf si l'état a changé depuis
+    if (!_v_max_valide)
+        CalculerVitessesLocales();
+
+    // Fenêtre de rayon 1, puis 2, 4, ... 2^(K-1) : max de la fenêtre précédente décalée de +-r
+    for (int i = 0; i < _N; i++)
+    {
+        double v = _vitesse_locale[i];
+        if (i > 0) v = max(v, _vitesse_locale[i-1]);
+        if (i + 1 < _N) v = max(v, _vitesse_locale[i+1]);
+        _vitesse_fenetre[i] = v;
+    }
+    for (int r = 1; r < (1 << (K - 1)); r *= 2)
+    {
+        _vitesse_locale.swap(_vitesse_fenetre);
+        for (int i = 0; i < _N; i++)
+        {
+            double v = _vitesse_locale[i];
+            if (i - r >= 0) v = max(v, _vitesse_locale[i - r]);
+            if (i + r < _N) v = max(v, _vitesse_locale[i + r]);
+            _vitesse_fenetre[i] = v;
+        }
+    }
+
+    for (int i = 0; i < _N; i++)
+    {
+        int k = 0;
+        while (k + 1 < K && dt_min * (1 << (k + 1)) * _vitesse_fenetre[i] <= _CFL * _dx)
+            k++;
+        _niveau_temps[i] = k;
+    }
+
+    // Au plus un niveau d'écart entre cellules voisines
+    for (int i = 1; i < _N; i++)
+        _niveau_temps[i] = min(_niveau_temps[i], _niveau_temps[i-1] + 1);
+    for (int i = _N - 2; i >= 0; i--)
+        _niveau_temps[i] = min(_niveau_temps[i], _niveau_temps[i+1] + 1);
+
+    // Plages par niveau : une interface suit la plus rapide de ses deux cellules
+    for (int k = 0; k < K; k++)
+    {
+        _faces_niveau[k].clear();
+        _cellules_niveau[k].clear();
+    }
+    const int* niveau = _niveau_temps.data();
+    for (int f = 1; f < _N; )
+    {
+        int k = min(niveau[f-1], niveau[f]);
+        int fin = f + 1;
+        while (fin < _N && min(niveau[fin-1], niveau[fin]) == k)
+            fin++;
+        _faces_niveau[k].push_back(make_pair(f, fin));
+        f = fin;
+    }
+    for (int i = 1; i < _N - 1; )
+    {
+        int k = niveau[i];
+        int fin = i + 1;
+        while (fin < _N - 1 && niveau[fin] == k)
+            fin++;
+        _cellules_niveau[k].push_back(make_pair(i, fin));
+        i = fin;
+    }
+}
+
+
+// Flux des plages d'interfaces sur une durée dt, cumulés dans les deux cellules voisines
+template <class Flux, class Source>
+void SaintVenant1D::CalculerInterfacesLocales(const vector<pair<int, int> >& plages, double dt)
+{
+    const double* h = _h.data();
+    const GeometrieFond fond = Fond();
+
+    for (size_t k = 0; k < plages.size(); k++)
+    {
+        // Reconstruction et flux par lot, comme pour le pas global
+        CalculerInterfaces<Flux, Source>(plages[k].first, plages[k].second);
+
+        // Ce qui sort de la cellule f-1 entre dans la cellule f
+        for (int f = plages[k].first; f < plages[k].second; f++)
+        {
+            double S_G, S_D;
+            Source::SourceFace(h, fond, _face_hG[f], _face_hD[f], f, _g, S_G, S_D);
+            _cumul_h[f-1] -= dt * _flux_h[f];
+            _cumul_hu[f-1] += dt * (S_G - _flux_hu[f]);
+            _cumul_h[f] += dt * _flux_h[f];
+            _cumul_hu[f] += dt * (_flux_hu[f] + S_D);
+        }
+    }
+}
+
+
+// ========================================
+// Avancer d'un macro-pas avec pas de temps local
+// ========================================
+// Le macro-pas est découpé en 2^k_max sous-pas dt_min. Au sous-pas j :
+// 1. les interfaces de niveau k avec j multiple de 2^k sont calculées avec l'état
+//    courant, sur une durée 2^k dt_min, et cumulées dans leurs deux cellules ;
+// 2. les cellules de niveau k dont le pas se termine (j + 1 multiple de 2^k)
+//    reçoivent leurs flux cumulés.
+// Une cellule lente reçoit donc exactement la somme des flux que sa voisine
+// rapide a reçus par l'interface commune (synchronisation conservative).
+double SaintVenant1D::AvancerPasLocal()
+{
+    // Pas de la cellule la plus rapide (pas global habituel)
+    CalculerPasDeTemps();
+    double dt_min = _dt;
+
+    ClasserNiveauxTemps(dt_min);
+    int k_max = 0;
+    for (int k = 0; k < _nb_niveaux_temps; k++)
+    {
+        if (!_faces_niveau[k].empty() || !_cellules_niveau[k].empty())
+            k_max = k;
+    }
+    int nb_sous_pas = 1 << k_max;
+
+    long long mises_a_jour = 0;
+    for (int j = 0; j < nb_sous_pas; j++)
+    {
+        // 1. Interfaces qui commencent un pas
+        for (int k = 0; k <= k_max; k++)
+        {
+            if (j % (1 << k) == 0)
+                (this->*_interfaces_locales)(_faces_niveau[k], dt_min * (1 << k));
+        }
+
+        // 2. Cellules qui terminent leur pas
+        for (int k = 0; k <= k_max; k++)
+        {
+            if ((j + 1) % (1 << k) != 0)
+                continue;
+            const vector<pair<int, int> >& plages = _cellules_niveau[k];
+            for (size_t n = 0; n < plages.size(); n++)
+            {
+                for (int i = plages[n].first; i < plages[n].second; i++)
+                {
+                    _h[i] += _cumul_h[i] / _dx;
+                    _hu[i] += _cumul_hu[i] / _dx;
+                    _cumul_h[i] = 0.0;
+                    _cumul_hu[i] = 0.0;
+                    if (!_manning.empty())
+                        AppliquerFrottement(_h.data(), _hu.data(), i, i + 1, dt_min * (1 << k));
+
+                    // Cellule sèche (la vitesse max est calculée une seule fois, en fin de macro-pas)
+                    if (_h[i] < critere_hauteur_deau)
+                    {
+                        _h[i] = 0.0;
+                        _hu[i] = 0.0;
+                    }
+                }
+                mises_a_jour += plages[n].second - plages[n].first;
+            }
+        }
+
+        // 3. Bords
+        AppliquerConditionsLimites(_h.data(), _hu.data());
+        NettoyerCellules(_h.data(), _hu.data(), 0, 1);
+        NettoyerCellules(_h.data(), _hu.data(), _N - 1, _N);
+    }
+
+    // Les cellules de bord ne sont pas mises à jour par les flux
+    _cumul_h[0] = _cumul_hu[0] = 0.0;
+    _cumul_h[_N-1] = _cumul_hu[_N-1] = 0.0;
+
+    double v_max = CalculerVitessesLocales();
+
+    _gain_pas_local = (mises_a_jour > 0) ? (double)(_N - 2) * nb_sous_pas / mises_a_jour : 1.0;
+    _dt = dt_min * nb_sous_pas;
+    _v_max = v_max;
+    _v_max_valide = true;
+
+    AvancerHorloge();
+
+    return v_max;
+}
+
+
+// ========================================
+// Ordre 2 : reconstruction MUSCL + Runge-Kutta SSP d'ordre 2
+// ========================================
+// Reconstruction hydrostatique d'ordre 2 (Audusse et al., 2004) :
+// - pentes limitées de h, eta = h + zb et u dans chaque cellule ;
+// - valeurs aux bords de cellule h-/h+, eta-/eta+, u-/u+ et z = eta - h ;
+// - à l'interface : z_inter = max(z+ gauche, z- droite), h = max(0, eta - z_inter) ;
+// - source : termes d'interface g/2 (h_interface^2 - h+-^2) et terme centré
+//   -g/2 (h- + h+)(z+ - z-), ce qui préserve exactement le lac au repos.
+
+template <class Flux, class Limiteur>
+void SaintVenant1D::EtapeOrdre2(const double* h, const double* hu, double* h_out, double* hu_out, double coeff)
+{
+#ifdef SV_INSTRUMENTATION
+    int64_t debut_phase = _instrumentation.Maintenant();
+#endif
+
+    // 1. VITESSES puis PENTES LIMITEES (nulles dans les cellules de bord : ordre 1)
+    // ------------------------------------
+    Parcourir(0, _N, [&](int d, int f, int)
+    {
+        for (int i = d; i < f; i++)
+            _u_cellule[i] = CalculerVitesse(h[i], hu[i]);
+    });
+
+    Parcourir(0, _N, [&](int d, int f, int)
+    {
+        for (int i = d; i < f; i++)
+        {
+            if (i == 0 || i == _N - 1)
+            {
+                _pente_h[i] = 0.0;
+                _pente_eta[i] = 0.0;
+                _pente_u[i] = 0.0;
+                continue;
+            }
+
+            double eta_G = h[i-1] + _zb[i-1], eta = h[i] + _zb[i], eta_D = h[i+1] + _zb[i+1];
+
+            _pente_h[i] = Limiteur::Pente(h[i] - h[i-1], h[i+1] - h[i]);
+            _pente_eta[i] = Limiteur::Pente(eta - eta_G, eta_D - eta);
+            _pente_u[i] = Limiteur::Pente(_u_cellule[i] - _u_cellule[i-1], _u_cellule[i+1] - _u_cellule[i]);
+        }
+    });
+
+    // 2. RECONSTRUCTION HYDROSTATIQUE et FLUX aux interfaces (entre f-1 et f)
+    // ------------------------------------
+    Parcourir(1, _N, [&](int f_debut, int f_fin, int)
+    {
+        for (int f = f_debut; f < f_fin; f++)
+        {
+            // Bord droit de la cellule gauche
+            int i = f - 1;
+            double h_p = h[i] + 0.5 * _pente_h[i];
+            double eta_p = h[i] + _zb[i] + 0.5 * _pente_eta[i];
+            double u_p = _u_cellule[i] + 0.5 * _pente_u[i];
+
+            // Bord gauche de la cellule droite
+            int j = f;
+            double h_m = h[j] - 0.5 * _pente_h[j];
+            double eta_m = h[j] + _zb[j] - 0.5 * _pente_eta[j];
+            double u_m = _u_cellule[j] - 0.5 * _pente_u[j];
+
+            // On prend le "plus haut" fond reconstruit à l'interface
+            double z_inter = max(eta_p - h_p, eta_m - h_m);
+
+            double h_L = max(0.0, eta_p - z_inter);
+            double h_R = max(0.0, eta_m - z_inter);
+            _face_hG[f] = h_L;
+            _face_hD[f] = h_R;
+            _face_huG[f] = h_L * u_p;
+            _face_huD[f] = h_R * u_m;
+        }
+
+        Flux::Lot(f_fin - f_debut, &_face_hG[f_debut], &_face_huG[f_debut], &_face_hD[f_debut], &_face_huD[f_debut],
+                  &_flux_h[f_debut], &_flux_hu[f_debut], _g, critere_hauteur_deau);
+#ifdef SV_INSTRUMENTATION
+        if (strcmp(Flux::Nom(), "rusanov") != 0)
+            _instrumentation.ClasserInterfaces(f_fin - f_debut, &_face_hG[f_debut], &_face_huG[f_debut], &_face_hD[f_debut],
+                                               &_face_huD[f_debut], _g, critere_hauteur_deau);
+#endif
+    });
+#ifdef SV_INSTRUMENTATION
+    _instrumentation.AjouterPhase(PHASE_FLUX, debut_phase, _instrumentation.Maintenant());
+    debut_phase = _instrumentation.Maintenant();
+#endif
+
+    // 3. MISE A JOUR des cellules intérieures
+    // ------------------------------------
+    Parcourir(1, _N - 1, [&](int d, int f, int)
+    {
+        for (int i = d; i < f; i++)
+        {
+            double h_m = h[i] - 0.5 * _pente_h[i];
+            double h_p = h[i] + 0.5 * _pente_h[i];
+            double eta = h[i] + _zb[i];
+            double z_m = eta - 0.5 * _pente_eta[i] - h_m;
+            double z_p = eta + 0.5 * _pente_eta[i] - h_p;
+
+            // Terme source équilibré (interface droite, interface gauche, terme centré)
+            double Source_WellBalanced = 0.5 * _g * (_face_hG[i+1] * _face_hG[i+1] - h_p * h_p)
+                                       - 0.5 * _g * (_face_hD[i] * _face_hD[i] - h_m * h_m)
+                                       - 0.5 * _g * (h_m + h_p) * (z_p - z_m);
+
+            h_out[i] = h[i] - coeff * (_flux_h[i+1] - _flux_h[i]);
+            hu_out[i] = hu[i] - coeff * (_flux_hu[i+1] - _flux_hu[i]) + coeff * Source_WellBalanced;
+        }
+    });
+    SV_INSTRUMENTER(_instrumentation.AjouterPhase(PHASE_MISE_A_JOUR, debut_phase, _instrumentation.Maintenant()));
+
+    // 4. Bords
+    AppliquerConditionsLimites(h_out, hu_out);
+}
+
+
+bool SaintVenant1D::ChoisirEtapeOrdre2()
+{
+    struct EntreeEtape
+    {
+        const char* flux;
+        const char* limiteur;
+        FonctionEtape fonction;
+    };
+    static const EntreeEtape etapes[] = {
+        { FluxPolitiqueRusanov::Nom(), LimiteurMinmod::Nom(),  &SaintVenant1D::EtapeOrdre2<FluxPolitiqueRusanov, LimiteurMinmod> },
+        { FluxPolitiqueRusanov::Nom(), LimiteurVanLeer::Nom(), &SaintVenant1D::EtapeOrdre2<FluxPolitiqueRusanov, LimiteurVanLeer> },
+        { FluxPolitiqueRusanov::Nom(), LimiteurMC::Nom(),      &SaintVenant1D::EtapeOrdre2<FluxPolitiqueRusanov, LimiteurMC> },
+        { FluxPolitiqueHLL::Nom(),     LimiteurMinmod::Nom(),  &SaintVenant1D::EtapeOrdre2<FluxPolitiqueHLL,     LimiteurMinmod> },
+        { FluxPolitiqueHLL::Nom(),     LimiteurVanLeer::Nom(), &SaintVenant1D::EtapeOrdre2<FluxPolitiqueHLL,     LimiteurVanLeer> },
+        { FluxPolitiqueHLL::Nom(),     LimiteurMC::Nom(),      &SaintVenant1D::EtapeOrdre2<FluxPolitiqueHLL,     LimiteurMC> },
+    };
+
+    for (const EntreeEtape& entree : etapes)
+    {
+        if (_nom_flux == entree.flux && _nom_limiteur == entree.limiteur)
+        {
+            _etape_ordre2 = entree.fonction;
+            return true;
+        }
+    }
+
+    cout << "Erreur : limiteur inconnu '" << _nom_limiteur << "' (minmod, vanleer, mc)" << endl;
+    return false;
+}
+
+
+bool SaintVenant1D::ChoisirOrdre(int ordre, const string& limiteur)
+{
+    if (ordre != 1 && ordre != 2)
+    {
+        cout << "Erreur : ordre " << ordre << " non disponible (1 ou 2)" << endl;
+        return false;
+    }
+
+    if (ordre == 2)
+    {
+        // EtapeOrdre2 fait toujours la reconstruction hydrostatique
+        if (_nom_source != SourceHydrostatique::Nom())
+        {
+            cout << "Erreur : source '" << _nom_source << "' non disponible a l'ordre 2 (hydrostatique seulement)" << endl;
+            return false;
+        }
+
+        string ancien_limiteur = _nom_limiteur;
+        _nom_limiteur = limiteur;
+        if (!ChoisirEtapeOrdre2())
+        {
+            _nom_limiteur = ancien_limiteur;
+            return false;
+        }
+
+        // Tampons propres à l'ordre 2
+        _h_etape.resize(_N);
+        _hu_etape.resize(_N);
+        _pente_h.resize(_N);
+        _pente_eta.resize(_N);
+        _pente_u.resize(_N);
+        _u_cellule.resize(_N);
+        _face_huG.resize(_N + 1);
+        _face_huD.resize(_N + 1);
+    }
+
+    _ordre = ordre;
+    return true;
+}
+
+
+// ========================================
+// Avancer d'un pas de temps à l'ordre 2 (Runge-Kutta SSP, Shu-Osher)
+// W1 = W + dt L(W) ; W2 = W1 + dt L(W1) ; W(n+1) = (W + W2) / 2
+// Frottement par partage de Strang : dt/2 avant et après le pas Runge-Kutta, ce qui
+// garde l'ordre 2 en temps (le sous-pas semi-implicite est exact, voir AppliquerFrottement)
+// ========================================
+double SaintVenant1D::AvancerOrdre2()
+{
+    CalculerPasDeTemps();
+
+    double coeff = _dt / _dx;
+
+    // 0. Premier demi-pas de frottement, sur l'état courant (|hu| ne peut que diminuer :
+    //    _v_max reste un majorant)
+    if (!_manning.empty())
+        Parcourir(0, _N, [this](int d, int f, int) { AppliquerFrottement(_h.data(), _hu.data(), d, f, 0.5 * _dt); });
+
+    // 1. Première étape : W1 dans _h_nouveau
+    (this->*_etape_ordre2)(_h.data(), _hu.data(), _h_nouveau.data(), _hu_nouveau.data(), coeff);
+    {
+        SV_PHASE(_instrumentation, PHASE_NETTOYAGE);
+        Parcourir(0, _N, [this](int d, int f, int) { NettoyerCellules(_h_nouveau.data(), _hu_nouveau.data(), d, f); });
+    }
+
+    // 2. Deuxième étape : W2 dans _h_etape
+    (this->*_etape_ordre2)(_h_nouveau.data(), _hu_nouveau.data(), _h_etape.data(), _hu_etape.data(), coeff);
+
+    // 3. Moyenne, cellules sèches et vitesse max (réduction par thread)
+    Parcourir(0, _N, [this](int d, int f, int)
+    {
+        for (int i = d; i < f; i++)
+        {
+            _h_nouveau[i] = 0.5 * (_h[i] + _h_etape[i]);
+            _hu_nouveau[i] = 0.5 * (_hu[i] + _hu_etape[i]);
+        }
+        if (!_manning.empty())
+            AppliquerFrottement(_h_nouveau.data(), _hu_nouveau.data(), d, f, 0.5 * _dt);
+    });
+    AppliquerConditionsLimites(_h_nouveau.data(), _hu_nouveau.data());
+
+    SV_PHASE(_instrumentation, PHASE_NETTOYAGE);
+    fill(_v_max_threads.begin(), _v_max_threads.end(), 0.0);
+    Parcourir(0, _N, [this](int d, int f, int id)
+    {
+        _v_max_threads[id] = NettoyerCellules(_h_nouveau.data(), _hu_nouveau.data(), d, f);
+    });
+
+    double v_max = 0.0;
+    for (size_t k = 0; k < _v_max_threads.size(); k++)
+        v_max = max(v_max, _v_max_threads[k]);
+
+    //  Echanger les tampons (pas de copie)
+    _h.swap(_h_nouveau);
+    _hu.swap(_hu_nouveau);
+    _v_max = v_max;
+    _v_max_valide = true;
+
+    //  Avancer le temps
+    AvancerHorloge();
+
+    return v_max;
+}
+
+
+// ========================================
+// Sauvegarder la solution dans le fichier
+// Format texte : t x h u zb H, ou trame binaire (SortieBinaire.h, SortieCompressee.h)
+// ========================================
+void SaintVenant1D::Sauvegarder()
+{
+    SV_PHASE(_instrumentation, PHASE_SAUVEGARDE);
+
+    if (_ecrivain_sauvegardes)
+    {
+        // Copie dans un tampon de la réserve, écrite par le thread d'écriture
+        Instantane* instantane = _ecrivain_sauvegardes->Preparer();
+        if (instantane == nullptr)
+            return;   // Politique d'abandon, tous les tampons en attente
+        instantane->t = _t;
+        instantane->h.assign(_h.begin(), _h.end());
+        instantane->hu.assign(_hu.begin(), _hu.end());
+        instantane->zb.assign(_zb.begin(), _zb.end());
+        _ecrivain_sauvegardes->Lancer(instantane);
+        return;
+    }
+    EcrireInstantane(_t, _h.data(), _hu.data(), _zb.data());
+}
+
+
+// Ecrit un état dans la sortie ouverte par Initialiser (thread du calcul, ou thread
+// d'écriture si les sauvegardes sont asynchrones)
+void SaintVenant1D::EcrireInstantane(double t, const double* h, const double* hu, const double* zb)
+{
+    if (_sortie_binaire)
+    {
+        _sortie_binaire->EcrireTrame(t, _N, _dx, zb, h, hu);
+        return;
+    }
+    if (_sortie_compressee)
+    {
+        _sortie_compressee->EcrireTrame(t, _N, _dx, zb, h, hu, critere_hauteur_deau);
+        return;
+    }
+    if (_sortie_texte)
+        _sortie_texte->EcrireTrame(t, _N, _dx, zb, h, hu, critere_hauteur_deau);
+}
+
+
+void SaintVenant1D::ActiverSauvegardesAsynchrones(bool actif, int nb_tampons, bool bloquer)
+{
+    // Le destructeur de l'écrivain écrit les instantanés en attente
+    _ecrivain_sauvegardes.reset();
+    _nb_tampons_sauvegarde = actif ? max(2, nb_tampons) : 0;
+    _sauvegardes_bloquantes = bloquer;
+    if (actif)
+        _ecrivain_sauvegardes.reset(new EcrivainSauvegardes([this](const Instantane& instantane)
+        {
+            EcrireInstantane(instantane.t, instantane.h.data(), instantane.hu.data(), instantane.zb.data());
+        }, _nb_tampons_sauvegarde, bloquer));
+}
+
+
+void SaintVenant1D::AttendreSauvegardes()
+{
+    if (_ecrivain_sauvegardes)
+        _ecrivain_sauvegardes->Attendre();
+}
+
+
+long SaintVenant1D::ObtenirNombreSauvegardesAbandonnees() const
+{
+    return _ecrivain_sauvegardes ? _ecrivain_sauvegardes->ObtenirNombreAbandonnes() : 0;
+}
+
+
+bool SaintVenant1D::DefinirCompressionSortie(double tolerance_h, double tolerance_u, int intervalle_cle)
+{
+    if (!_sortie_compressee)
+    {
+        cout << "Erreur : la compression demande une sortie .svz (voir Initialiser)" << endl;
+        return false;
+    }
+    AttendreSauvegardes();   // Le thread d'écriture ne compresse pas pendant le changement
+    return _sortie_compressee->DefinirTolerances(tolerance_h, tolerance_u, intervalle_cle);
+}
+
+
+bool SaintVenant1D::DefinirPrecisionSortie(int chiffres)
+{
+    if (chiffres < 1 || chiffres > 17)
+    {
+        cout << "Erreur : precision de sortie entre 1 et 17 chiffres attendue (" << chiffres << ")" << endl;
+        return false;
+    }
+    _precision_sortie = chiffres;
+    AttendreSauvegardes();   // Le thread d'écriture ne met pas en forme pendant le changement
+    if (_sortie_texte)
+        _sortie_texte->DefinirPrecision(chiffres);
+    return true;
+}
+
+
+double SaintVenant1D::ObtenirTauxCompressionSortie() const
+{
+    // Compteurs de la sortie mis à jour par le thread d'écriture
+    if (_ecrivain_sauvegardes)
+        _ecrivain_sauvegardes->Attendre();
+    return _sortie_compressee ? _sortie_compressee->TauxCompression() : 0.0;
+}
+
+
+
+
+// ============================
+// Validation et information
+// ============================
+
+
+
+
+
+
+// Taille des blocs de sommation (fixe, indépendante du nombre de threads)
+static const int TAILLE_BLOC_SOMME = 4096;
+// Films minces du front mouillé, dont le Froude est compté à part : h au plus
+// FRACTION_FILM fois la profondeur au repos, ou FACTEUR_FILM fois le critère sec
+static const double FRACTION_FILM = 0.05;
+static const double FACTEUR_FILM = 10.0;
+
+template <class Terme>
+double SaintVenant1D::SommeParBlocs(Terme terme)
+{
+    int nb_blocs = (_N + TAILLE_BLOC_SOMME - 1) / TAILLE_BLOC_SOMME;
+    vector<SommeCompensee> sommes_blocs(nb_blocs);
+
+    // 1. Somme compensée de chaque bloc (les blocs sont répartis entre les threads)
+    Parcourir(0, nb_blocs, [&](int b_debut, int b_fin, int)
+    {
+        for (int b = b_debut; b < b_fin; b++)
+        {
+            int i_fin = min(_N, (b + 1) * TAILLE_BLOC_SOMME);
+            SommeCompensee somme;
+            for (int i = b * TAILLE_BLOC_SOMME; i < i_fin; i++)
+                somme.Ajouter(terme(i));
+            sommes_blocs[b] = somme;
+        }
+    });
+
+    // 2. Somme des blocs, toujours dans le même ordre
+    SommeCompensee total;
+    for (int b = 0; b < nb_blocs; b++)
+        total.Ajouter(sommes_blocs[b]);
+    return total.Valeur();
+}
+
+
+double SaintVenant1D::CalculerMasseTotale()
+{
+    // On somme la hauteur d'eau de toutes les cellules
+    double volume_total = SommeParBlocs([this](int i) { return _h[i]; });
+    
+    // Volume = Somme des hauteurs * largeur d'une cellule
+    return volume_total * _dx;
+}
+
+
+double SaintVenant1D::ObtenirSurfaceMax()
+{
+    // On cherche l'altitude maximale atteinte par l'eau (H = h + zb)
+    // On initialise très bas
+    double H_max = -99999.0; 
+    
+    for (int i = 0; i < _N; i++)
+    {
+        // On ne regarde que s'il y a un peu d'eau (pour éviter les bugs sur sol sec)
+        if (_h[i] > 1e-6) 
+        {
+            double H_actuel = _h[i] + _zb[i];
+            if (H_actuel > H_max) 
+            {
+                H_max = H_actuel;
+            }
+        }
+    }
+    return H_max;
+}
+
+
+double SaintVenant1D::ObtenirPositionCrete()
+{
+    double H_max = -99999.0;
+    int i_max = 0;
+    
+    // On cherche l'altitude MAXIMALE de la surface (H)
+    for (int i = 0; i < _N; i++)
+    {
+        double H_actuel = _h[i] + _zb[i];
+        
+        // On ne considère que les zones mouillées
+        if (_h[i] > 1e-4 && H_actuel > H_max)
+        {
+            H_max = H_actuel;
+            i_max = i;
+        }
+    }
+    
+    return (i_max + 0.5) * _dx;
+}
+
+
+double SaintVenant1D::CalculerEnergieTotale()
+{
+    double energie_totale = SommeParBlocs([this](int i)
+    {
+        // 1. Energie Potentielle : 1/2 * g * h^2
+        double Ep = 0.5 * _g * _h[i] * _h[i];
+        
+        // 2. Energie Cinétique : 1/2 * h * u^2  (ou 1/2 * (hu)^2 / h)
+        double Ec = 0.0;
+        if (_h[i] > 1e-10) {
             double u = _hu[i] / _h[i];
             Ec = 0.5 * _h[i] * u * u;
         }
         
-        energie_totale += (Ep + Ec);
-    }
+        return Ep + Ec;
+    });
     
     return energie_totale * _dx;
-}
\ No newline at end of file
+}
+
+
+// ========================================
+// Diagnostics en un seul passage
+// ========================================
+
+// Diagnostics des cellules [i_debut, i_fin), après nettoyage des cellules sèches si demandé
+// (mêmes opérations que NettoyerCellules, dans le même ordre)
+void SaintVenant1D::DiagnostiquerBloc(double* h, double* hu, int i_debut, int i_fin, bool nettoyer, DiagnosticsBloc& d) const
+{
+    d = DiagnosticsBloc();
+    d.surface_max = -99999.0;
+    d.hauteur_max = 0.0;
+    d.H_crete = -99999.0;
+    d.i_crete = -1;
+    d.nb_mouillees = 0;
+    d.froude_max = 0.0;
+    d.froude_front = 0.0;
+    d.i_rivage = -1;
+    d.v_max = 0.0;
+
+    bool precedente_mouillee = false;
+    const double h_film = max(FACTEUR_FILM * critere_hauteur_deau, FRACTION_FILM * _h_fond);
+#ifdef SV_INSTRUMENTATION
+    long nb_ecretages = 0;
+#endif
+    for (int i = i_debut; i < i_fin; i++)
+    {
+        if (nettoyer && h[i] < critere_hauteur_deau)
+        {
+#ifdef SV_INSTRUMENTATION
+            nb_ecretages += (h[i] != 0.0 || hu[i] != 0.0);
+#endif
+            h[i] = 0.0;
+            hu[i] = 0.0;
+        }
+
+        // Une seule division : v sert à l'énergie (h > 1e-10), u à la vitesse max (h > critere)
+        double h_i = h[i];
+        double v = (h_i > 1e-10) ? hu[i] / h_i : 0.0;
+        double u = (h_i > critere_hauteur_deau) ? v : 0.0;
+        double c = (h_i > 1e-10) ? sqrt(_g * h_i) : 0.0;
+        d.v_max = max(d.v_max, fabs(u) + c);
+
+        // Masse et énergie (mêmes termes que CalculerMasseTotale et CalculerEnergieTotale)
+        d.masse.Ajouter(h_i);
+        double Ec = 0.5 * h_i * v * v;
+        d.energie.Ajouter(0.5 * _g * h_i * h_i + Ec);
+
+        // Extrema (mêmes critères que ObtenirSurfaceMax et ObtenirPositionCrete)
+        double H = h_i + _zb[i];
+        if (h_i > 1e-6 && H > d.surface_max)
+            d.surface_max = H;
+        if (h_i > 1e-4 && H > d.H_crete)
+        {
+            d.H_crete = H;
+            d.i_crete = i;
+        }
+        d.hauteur_max = max(d.hauteur_max, h_i);
+
+        // Zone mouillée, Froude et rivage
+        bool mouillee = h_i > critere_hauteur_deau;
+        if (mouillee)
+        {
+            d.nb_mouillees++;
+            // Division seulement quand le maximum augmente
+            double& froude = (h_i > h_film) ? d.froude_max : d.froude_front;
+            if (fabs(u) > froude * c)
+                froude = fabs(u) / c;
+        }
+        else if (precedente_mouillee)
+            d.i_rivage = i - 1;
+        if (i == i_debut)
+            d.premier_mouille = mouillee;
+        precedente_mouillee = mouillee;
+    }
+    d.dernier_mouille = precedente_mouillee;
+
+    // Les cellules non mouillées sont sèches après nettoyage
+    if (nettoyer)
+    {
+        SV_COMPTER(_instrumentation, COMPTEUR_CELLULES_SECHES, (i_fin - i_debut) - d.nb_mouillees);
+        SV_COMPTER(_instrumentation, COMPTEUR_ECRETAGES, nb_ecretages);
+    }
+}
+
+
+// Combine les diagnostics des blocs dans l'ordre et retourne la vitesse max
+double SaintVenant1D::CombinerDiagnostics(int nb_blocs, Diagnostics& diagnostics) const
+{
+    SommeCompensee masse, energie;
+    double H_crete = -99999.0;
+    int i_crete = 0, nb_mouillees = 0, i_rivage = -1;
+    double v_max = 0.0;
+
+    diagnostics = Diagnostics();
+    diagnostics.t = _t;
+    for (int b = 0; b < nb_blocs; b++)
+    {
+        const DiagnosticsBloc& d = _diagnostics_blocs[b];
+        masse.Ajouter(d.masse);
+        energie.Ajouter(d.energie);
+        diagnostics.surface_max = max(diagnostics.surface_max, d.surface_max);
+        diagnostics.hauteur_max = max(diagnostics.hauteur_max, d.hauteur_max);
+        diagnostics.froude_max = max(diagnostics.froude_max, d.froude_max);
+        diagnostics.froude_front = max(diagnostics.froude_front, d.froude_front);
+        if (d.i_crete >= 0 && d.H_crete > H_crete)
+        {
+            H_crete = d.H_crete;
+            i_crete = d.i_crete;
+        }
+        nb_mouillees += d.nb_mouillees;
+        v_max = max(v_max, d.v_max);
+
+        // Rivage à la frontière avec le bloc précédent, puis à l'intérieur du bloc
+        if (b > 0 && _diagnostics_blocs[b-1].dernier_mouille && !d.premier_mouille)
+            i_rivage = b * TAILLE_BLOC_SOMME - 1;
+        if (d.i_rivage >= 0)
+            i_rivage = d.i_rivage;
+    }
+
+    diagnostics.masse = masse.Valeur() * _dx;
+    diagnostics.energie = energie.Valeur() * _dx;
+    diagnostics.x_crete = (i_crete + 0.5) * _dx;
+    diagnostics.longueur_mouillee = nb_mouillees * _dx;
+    diagnostics.x_rivage = (i_rivage >= 0) ? (i_rivage + 1) * _dx : -1.0;
+    return v_max;
+}
+
+
+// Passage par blocs fixes de TAILLE_BLOC_SOMME cellules, répartis entre les threads
+double SaintVenant1D::PasserDiagnostics(double* h, double* hu, bool nettoyer, Diagnostics& diagnostics)
+{
+    SV_PHASE(_instrumentation, PHASE_DIAGNOSTICS);
+
+    int nb_blocs = (_N + TAILLE_BLOC_SOMME - 1) / TAILLE_BLOC_SOMME;
+    if ((int)_diagnostics_blocs.size() < nb_blocs)
+        _diagnostics_blocs.resize(nb_blocs);
+
+    Parcourir(0, nb_blocs, [this, h, hu, nettoyer](int b_debut, int b_fin, int)
+    {
+        for (int b = b_debut; b < b_fin; b++)
+            DiagnostiquerBloc(h, hu, b * TAILLE_BLOC_SOMME, min(_N, (b + 1) * TAILLE_BLOC_SOMME), nettoyer,
+                              _diagnostics_blocs[b]);
+    });
+    return CombinerDiagnostics(nb_blocs, diagnostics);
+}
+
+
+Diagnostics SaintVenant1D::CalculerDiagnostics()
+{
+    Diagnostics diagnostics;
+    PasserDiagnostics(_h.data(), _hu.data(), false, diagnostics);
+    return diagnostics;
+}
+
+
+void SaintVenant1D::ActiverDiagnosticsEnLigne(bool actif)
+{
+    _diagnostics_en_ligne = actif;
+    if (actif)
+        _diagnostics = CalculerDiagnostics();
+}
+
+
+// ========================================
+// Instrumentation
+// ========================================
+bool SaintVenant1D::EcrireInstrumentation(const string& nom_fichier) const
+{
+#ifdef SV_INSTRUMENTATION
+    bool json = nom_fichier.size() >= 5 && nom_fichier.compare(nom_fichier.size() - 5, 5, ".json") == 0;
+    return json ? _instrumentation.EcrireTraceChrome(nom_fichier) : _instrumentation.EcrireCSV(nom_fichier);
+#else
+    cout << "Erreur : instrumentation non compilee (cmake -DINSTRUMENTATION=ON), '" << nom_fichier << "' non ecrit" << endl;
+    return false;
+#endif
+}
+
+
+bool SaintVenant1D::AfficherInstrumentation() const
+{
+#ifdef SV_INSTRUMENTATION
+    _instrumentation.Afficher(cout);
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+// ========================================
+// Points de reprise
+// ========================================
+void SaintVenant1D::CopierEtatReprise(EtatReprise& etat) const
+{
+    etat.N = _N;
+    etat.L = _L;
+    etat.dx = _dx;
+    etat.CFL = _CFL;
+    etat.t = _t;
+    etat.dt = _dt;
+    etat.h_fond = _h_fond;
+    etat.critere_hauteur_deau = critere_hauteur_deau;
+    etat.critere_vitesse = critere_vitesse;
+    etat.v_max = _v_max;
+    etat.v_max_valide = _v_max_valide;
+    etat.schema = _nom_schema;
+    etat.ordre = _ordre;
+    etat.limiteur = _nom_limiteur;
+    etat.zones_actives = _zones_actives;
+    etat.taille_bloc = _taille_bloc;
+    etat.tolerance_repos = _tolerance_repos;
+    etat.pas_local = _pas_local;
+    etat.nb_niveaux_temps = _nb_niveaux_temps;
+    etat.frottement_implicite = _frottement_implicite;
+    etat.intervalle_sorties = _intervalle_sorties;
+    etat.t_debut_sorties = _t_debut_sorties;
+    etat.rang_sortie = _rang_sortie;
+    etat.manning.assign(_manning.begin(), _manning.end());
+
+    // assign réutilise la mémoire des copies précédentes
+    etat.h.assign(_h.begin(), _h.end());
+    etat.hu.assign(_hu.begin(), _hu.end());
+    etat.zb.assign(_zb.begin(), _zb.end());
+    etat.d_zb.assign(_d_zb.begin(), _d_zb.end());
+    if (_zones_actives)
+    {
+        etat.bloc_actif.assign(_bloc_actif.begin(), _bloc_actif.end());
+        etat.v_max_bloc.assign(_v_max_bloc.begin(), _v_max_bloc.end());
+    }
+    else
+    {
+        etat.bloc_actif.clear();
+        etat.v_max_bloc.clear();
+    }
+}
+
+
+bool SaintVenant1D::EcrireReprise(const string& nom_fichier) const
+{
+    EtatReprise etat;
+    CopierEtatReprise(etat);
+    return ::EcrireReprise(nom_fichier, etat);
+}
+
+
+bool SaintVenant1D::ChargerReprise(const string& nom_fichier, const string& nom_fichier_sortie)
+{
+    EtatReprise etat;
+    if (!LireReprise(nom_fichier, etat))
+        return false;
+
+    // Schéma et ordre d'abord : ils doivent être connus de cette version. Ils sont
+    // choisis à partir de l'ordre 1 (le schéma du point de reprise est vérifié avec son
+    // propre ordre) ; en cas d'échec, ceux du solveur sont rétablis et rien n'a changé
+    string ancien_schema = _nom_schema, ancien_limiteur = _nom_limiteur;
+    int ancien_ordre = _ordre;
+    _ordre = 1;
+    if (!ChoisirSchema(etat.schema) || !ChoisirOrdre(etat.ordre, etat.limiteur))
+    {
+        _ordre = 1;
+        ChoisirSchema(ancien_schema);
+        ChoisirOrdre(ancien_ordre, ancien_limiteur);
+        return false;
+    }
+    _zones_actives = false;
+    _pas_local = false;
+
+    Initialiser(etat.N, etat.L, etat.CFL, "");
+    if (_dx != etat.dx)
+        cout << "Attention : dx recalcule different de celui du point de reprise" << endl;
+    _dx = etat.dx;
+    if (!nom_fichier_sortie.empty())
+    {
+        _ecrivain_sauvegardes.reset();
+        if (EstSortieBinaire(nom_fichier_sortie))
+        {
+            _sortie_binaire.reset(new SortieBinaire());
+            if (!_sortie_binaire->Ouvrir(nom_fichier_sortie, true, etat.t))
+                _sortie_binaire.reset();
+        }
+        else if (EstSortieCompressee(nom_fichier_sortie))
+        {
+            _sortie_compressee.reset(new SortieCompressee());
+            if (!_sortie_compressee->Ouvrir(nom_fichier_sortie, true, etat.t))
+                _sortie_compressee.reset();
+        }
+        else
+        {
+            _sortie_texte.reset(new SortieTexte());
+            _sortie_texte->DefinirPrecision(_precision_sortie);
+            if (!_sortie_texte->Ouvrir(nom_fichier_sortie, true, etat.t))
+                _sortie_texte.reset();
+        }
+        if (_nb_tampons_sauvegarde > 0)
+            ActiverSauvegardesAsynchrones(true, _nb_tampons_sauvegarde, _sauvegardes_bloquantes);
+    }
+
+    if (etat.zones_actives)
+    {
+        ActiverZonesActives(true, etat.taille_bloc, etat.tolerance_repos);
+        if (etat.bloc_actif.size() == _bloc_actif.size())
+        {
+            _bloc_actif.assign(etat.bloc_actif.begin(), etat.bloc_actif.end());
+            _v_max_bloc.assign(etat.v_max_bloc.begin(), etat.v_max_bloc.end());
+        }
+    }
+    if (etat.pas_local)
+        ActiverPasDeTempsLocal(true, etat.nb_niveaux_temps);
+    _manning.swap(etat.manning);
+    _frottement_implicite = etat.frottement_implicite;
+
+    _h.swap(etat.h);
+    _hu.swap(etat.hu);
+    _zb.swap(etat.zb);
+    _d_zb.swap(etat.d_zb);
+    MettreAJourGeometrieFond();
+    _t = etat.t;
+    _dt = etat.dt;
+    _h_fond = etat.h_fond;
+    critere_hauteur_deau = etat.critere_hauteur_deau;
+    critere_vitesse = etat.critere_vitesse;
+    _v_max = etat.v_max;
+    _v_max_valide = etat.v_max_valide;
+    if (etat.intervalle_sorties > 0.0)
+    {
+        // Echéancier du calcul interrompu, repris tel quel
+        _intervalle_sorties = etat.intervalle_sorties;
+        _t_debut_sorties = etat.t_debut_sorties;
+        _rang_sortie = (long)etat.rang_sortie;
+    }
+    else if (_intervalle_sorties > 0.0)
+    {
+        // Point de reprise sans échéancier : intervalle défini avant l'appel, à partir
+        // de t0 = 0, sans les échéances déjà atteintes avant le point de reprise
+        _rang_sortie = (long)floor(_t / _intervalle_sorties);
+        while (ProchaineSortie() <= _t)
+            _rang_sortie++;
+    }
+    if (_pas_local && _v_max_valide)
+        CalculerVitessesLocales();  // Vitesses de fin de macro-pas, fonction de h et hu seulement
+    if (_diagnostics_en_ligne)
+        _diagnostics = CalculerDiagnostics();
+
+    cout << "Reprise de '" << nom_fichier << "' a t = " << _t << " s" << endl;
+    return true;
+}
+
+
+void SaintVenant1D::ActiverReprises(const string& nom_fichier, int tous_les_pas, double toutes_les_secondes)
+{
+    // Le destructeur de l'écrivain termine l'écriture en cours
+    _ecrivain_reprise.reset();
+    _reprise_tous_les_pas = max(0, tous_les_pas);
+    _reprise_toutes_les_secondes = max(0.0, toutes_les_secondes);
+    _pas_depuis_reprise = 0;
+    _instant_reprise = chrono::steady_clock::now();
+    if (!nom_fichier.empty() && (_reprise_tous_les_pas > 0 || _reprise_toutes_les_secondes > 0.0))
+        _ecrivain_reprise.reset(new EcrivainReprise(nom_fichier));
+}
+
+
+long SaintVenant1D::ObtenirNombreReprises() const
+{
+    return _ecrivain_reprise ? _ecrivain_reprise->ObtenirNombreEcrites() : 0;
+}
+
+
+bool SaintVenant1D::ActiverObservateurs(const vector<double>& x_jauges, const string& fichier_jauges,
+                                        int tous_les_pas, double seuil_arrivee)
+{
+    _observateurs.reset(new Observateurs());
+    if (!_observateurs->Initialiser(_N, _dx, _zb, critere_hauteur_deau, x_jauges, fichier_jauges,
+                                    tous_les_pas, seuil_arrivee, _t, _h.data(), _hu.data()))
+    {
+        _observateurs.reset();
+        return false;
+    }
+    return true;
+}
+
+
+bool SaintVenant1D::EcrireObservations(const string& nom_fichier) const
+{
+    if (!_observateurs)
+    {
+        cout << "Erreur : observateurs non actives (voir ActiverObservateurs)" << endl;
+        return false;
+    }
+    return _observateurs->EcrireEnveloppes(nom_fichier, _zb.data());
+}
+
+
+bool SaintVenant1D::ActiverDiffusion(const string& nom, int tous_les_pas, int nb_emplacements)
+{
+    _diffusion.reset();
+    if (nom.empty())
+        return true;
+    _diffusion.reset(new DiffusionPartagee());
+    if (!_diffusion->Ouvrir(nom, _N, _dx, _zb.data(), nb_emplacements))
+    {
+        _diffusion.reset();
+        return false;
+    }
+    _diffusion_tous_les_pas = max(1, tous_les_pas);
+    _pas_depuis_diffusion = 0;
+    _diffusion->Publier(_t, _h.data(), _hu.data());
+    return true;
+}
+
+
+long SaintVenant1D::ObtenirNombreTramesDiffusees() const
+{
+    return _diffusion ? _diffusion->NombreTrames() : 0;
+}
+
+
+template <class T>
+static size_t OctetsTableau(const vector<T>& tableau)
+{
+    return tableau.capacity() * sizeof(T);
+}
+
+
+size_t SaintVenant1D::ObtenirMemoireTableaux() const
+{
+    size_t octets = 0;
+    // Etat, nouvel état et fond
+    for (const vector<double>* tableau : { &_h, &_hu, &_h_nouveau, &_hu_nouveau, &_zb, &_d_zb })
+        octets += OctetsTableau(*tableau);
+    // Interfaces
+    for (const vector<double>* tableau : { &_z_interface, &_saut_zb, &_face_hG, &_face_hD, &_flux_h, &_flux_hu })
+        octets += OctetsTableau(*tableau);
+    // Ordre 2 (alloués au premier pas)
+    for (const vector<double>* tableau : { &_h_etape, &_hu_etape, &_pente_h, &_pente_eta, &_pente_u, &_u_cellule,
+                                           &_face_huG, &_face_huD })
+        octets += OctetsTableau(*tableau);
+    // Zones actives, pas de temps local et frottement
+    octets += OctetsTableau(_bloc_actif) + OctetsTableau(_v_max_bloc) + OctetsTableau(_plages);
+    octets += OctetsTableau(_niveau_temps);
+    for (const vector<double>* tableau : { &_vitesse_fenetre, &_cumul_h, &_cumul_hu, &_vitesse_locale, &_manning })
+        octets += OctetsTableau(*tableau);
+    for (size_t k = 0; k < _faces_niveau.size(); k++)
+        octets += OctetsTableau(_faces_niveau[k]) + OctetsTableau(_cellules_niveau[k]);
+    octets += OctetsTableau(_v_max_threads) + OctetsTableau(_diagnostics_blocs);
+    return octets;
+}
+
+
+// Appelée à la fin de chaque pas quand les reprises sont activées
+void SaintVenant1D::ReprisePeriodique()
+{
+    _pas_depuis_reprise++;
+    bool echeance = (_reprise_tous_les_pas > 0 && _pas_depuis_reprise >= _reprise_tous_les_pas);
+    if (!echeance && _reprise_toutes_les_secondes > 0.0)
+    {
+        double ecoule = chrono::duration<double>(chrono::steady_clock::now() - _instant_reprise).count();
+        echeance = ecoule >= _reprise_toutes_les_secondes;
+    }
+    if (!echeance)
+        return;
+
+    // Ecriture précédente pas finie : on réessaie au pas suivant
+    EtatReprise* etat = _ecrivain_reprise->Preparer();
+    if (etat == nullptr)
+        return;
+    CopierEtatReprise(*etat);
+    _ecrivain_reprise->Lancer();
+    _pas_depuis_reprise = 0;
+    _instant_reprise = chrono::steady_clock::now();
+}
@@ -4,6 +4,42 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include "SommeCompensee.h"
+#include "Instrumentation.h"
+
+class PoolThreads;
+class EcrivainReprise;
+class Observateurs;
+class SortieTexte;
+class SortieBinaire;
+class SortieCompressee;
+class EcrivainSauvegardes;
+class DiffusionPartagee;
+struct EtatReprise;
+struct GeometrieFond;
+
+// ========================================
+// Diagnostics de l'état, calculés en un seul passage (voir CalculerDiagnostics)
+// ========================================
+struct Diagnostics
+{
+    double t = 0.0;
+    double masse = 0.0;              // Somme de h dx (sommation compensée)
+    double energie = 0.0;            // Somme de (g h^2/2 + h u^2/2) dx (sommation compensée)
+    double surface_max = -99999.0;   // Comme ObtenirSurfaceMax
+    double hauteur_max = 0.0;        // Max de h
+    double x_crete = 0.0;            // Comme ObtenirPositionCrete
+    double longueur_mouillee = 0.0;  // Nombre de cellules mouillées (h > critere_hauteur_deau) * dx
+    double froude_max = 0.0;         // Max de |u| / sqrt(g h) hors films minces : h au-dessus de 5 % de
+                                     // la profondeur au repos (ObtenirHFond) et de 10 critere_hauteur_deau
+    double froude_front = 0.0;       // Même max sur les films minces mouillés (langue du front, où
+                                     // u / sqrt(g h) tend vers l'infini quand h tend vers 0)
+    double x_rivage = -1.0;          // Limite mouillé/sec la plus à droite : bord droit de la dernière
+                                     // cellule mouillée suivie d'une cellule sèche (-1 s'il n'y en a pas)
+};
 
 // ========================================
 // Classe principale : résout Saint-Venant 1D
@@ -29,6 +65,12 @@ private:
     //Bathymetrie
     std::vector<double> _zb;  // Bathymétrie (altitude du fond)
     std::vector<double> _d_zb;  // Bathymétrie (pente du fond)
+    // Tables par interface (N + 1 valeurs), reconstruites à chaque changement du fond
+    // (voir GeometrieFond, Schemas.h)
+    std::vector<double> _z_interface;
+    std::vector<double> _saut_zb;
+    void MettreAJourGeometrieFond();
+    GeometrieFond Fond() const;
 
 
 
@@ -36,12 +78,182 @@ private:
     // W = (h, hu) où h = hauteur, hu = débit
     std::vector<double> _h;   // Hauteur d'eau dans chaque cellule
     std::vector<double> _hu;  // Débit (h*u) dans chaque cellule
+
+    // Tampons du pas de temps (alloués une seule fois dans Initialiser)
+    // L'état au pas suivant est écrit dans _h_nouveau/_hu_nouveau puis échangé avec _h/_hu
+    std::vector<double> _h_nouveau;
+    std::vector<double> _hu_nouveau;
+
+    // Grandeurs aux interfaces : l'interface f sépare les cellules f-1 et f (f = 1..N-1)
+    std::vector<double> _face_hG;  // Hauteur reconstruite à gauche de l'interface
+    std::vector<double> _face_hD;  // Hauteur reconstruite à droite de l'interface
+    std::vector<double> _flux_h;   // Flux numérique de masse
+    std::vector<double> _flux_hu;  // Flux numérique de quantité de mouvement
+
+    // Ordre 2 (MUSCL + SSP-RK2), alloués seulement si ChoisirOrdre(2, ...)
+    std::vector<double> _h_etape;    // Etat après la deuxième étape de Runge-Kutta
+    std::vector<double> _hu_etape;
+    std::vector<double> _pente_h;    // Pentes limitées (non divisées par dx) de h,
+    std::vector<double> _pente_eta;  // de la surface libre eta = h + zb
+    std::vector<double> _pente_u;    // et de la vitesse u
+    std::vector<double> _u_cellule;  // Vitesse u = hu/h de chaque cellule
+    std::vector<double> _face_huG;   // Débit reconstruit à gauche de l'interface
+    std::vector<double> _face_huD;   // Débit reconstruit à droite de l'interface
+
+    // Vitesse max de l'état courant, calculée pendant le balayage d'Avancer
+    double _v_max;
+    bool _v_max_valide;  // false si l'état a été modifié en dehors d'Avancer
     
     // Constante physique
     static constexpr double _g = 9.81;  // Gravité (m/s²)
     
-    // Fichier pour sauvegarder
-    std::ofstream _fichier;
+    // Fichier pour sauvegarder (texte, binaire si son nom finit par .svb, compressé par .svz)
+    std::unique_ptr<SortieTexte> _sortie_texte;
+    int _precision_sortie;        // Chiffres significatifs de la sortie texte
+    std::unique_ptr<SortieBinaire> _sortie_binaire;
+    std::unique_ptr<SortieCompressee> _sortie_compressee;
+    void EcrireInstantane(double t, const double* h, const double* hu, const double* zb);
+
+    // Sauvegardes écrites par un thread dédié (voir ActiverSauvegardesAsynchrones)
+    std::unique_ptr<EcrivainSauvegardes> _ecrivain_sauvegardes;
+    int _nb_tampons_sauvegarde;   // 0 : sauvegardes synchrones
+    bool _sauvegardes_bloquantes;
+
+    // Sauvegardes à des temps imposés (voir DefinirIntervalleSorties) : le dernier pas
+    // avant l'échéance _t_limite est raccourci pour l'atteindre exactement, et le temps
+    // passé à Avancer(t_limite) compte comme une échéance
+    double _intervalle_sorties;   // 0 : pas de sauvegardes planifiées
+    double _t_debut_sorties;
+    long _rang_sortie;            // Rang k de la dernière échéance atteinte
+    double _t_limite_appel;       // Voir Avancer(t_limite)
+    double _t_limite;             // Echéance du pas en cours
+    bool _pas_raccourci;          // Le pas en cours se termine exactement à _t_limite
+    double ProchaineSortie() const;
+    void AvancerHorloge();
+    void FinDePas();
+
+#ifdef SV_INSTRUMENTATION
+    // Minuteurs et compteurs (modifiés aussi par les passages const)
+    mutable Instrumentation _instrumentation;
+#endif
+
+    // Schéma utilisé par Avancer : une instanciation de CalculerFluxEtMiseAJour
+    typedef void (SaintVenant1D::*FonctionSchema)(int i_debut, int i_fin, double coeff);
+    FonctionSchema _schema;
+    std::string _nom_schema;
+    std::string _nom_flux;
+    std::string _nom_source;
+
+    // Ordre 2 : une instanciation de EtapeOrdre2 (flux x limiteur, reconstruction
+    // hydrostatique seulement)
+    typedef void (SaintVenant1D::*FonctionEtape)(const double* h, const double* hu, double* h_out, double* hu_out, double coeff);
+    int _ordre;
+    std::string _nom_limiteur;
+    FonctionEtape _etape_ordre2;
+
+    // Suivi des zones actives (voir ActiverZonesActives)
+    bool _zones_actives;
+    int _taille_bloc;
+    double _tolerance_repos;
+    std::vector<char> _bloc_actif;                  // Le bloc a évolué au dernier pas où il a été calculé
+    std::vector<double> _v_max_bloc;                // Vitesse max de chaque bloc
+    std::vector<std::pair<int, int> > _plages;      // Plages de cellules calculées au pas courant
+    int _cellules_calculees;                        // Nombre de cellules calculées au dernier pas
+    double AvancerZonesActives();
+
+    // Pas de temps local (voir ActiverPasDeTempsLocal)
+    bool _pas_local;
+    int _nb_niveaux_temps;
+    std::vector<int> _niveau_temps;                   // Niveau de chaque cellule : pas de 2^niveau dt_min
+    std::vector<double> _vitesse_fenetre;             // Vitesse max autour de chaque cellule
+    std::vector<std::vector<std::pair<int, int> > > _faces_niveau;     // Plages d'interfaces de chaque niveau
+    std::vector<std::vector<std::pair<int, int> > > _cellules_niveau;  // Plages de cellules intérieures de chaque niveau
+    std::vector<double> _cumul_h;                     // dt * (flux entrant - flux sortant) + dt * source,
+    std::vector<double> _cumul_hu;                    // cumulés depuis la dernière mise à jour de la cellule
+    std::vector<double> _vitesse_locale;              // |u| + c de chaque cellule
+    double _gain_pas_local;                           // Voir ObtenirGainPasLocal
+    typedef void (SaintVenant1D::*FonctionInterfacesLocales)(const std::vector<std::pair<int, int> >& plages, double dt);
+    FonctionInterfacesLocales _interfaces_locales;
+    template <class Flux, class Source>
+    void CalculerInterfacesLocales(const std::vector<std::pair<int, int> >& plages, double dt);
+    double CalculerVitessesLocales();
+    void ClasserNiveauxTemps(double dt_min);
+    double AvancerPasLocal();
+
+    // Calcul parallèle (pas de pool = calcul séquentiel)
+    std::unique_ptr<PoolThreads> _pool;
+    std::vector<double> _v_max_threads;  // Vitesse max partielle de chaque thread
+
+    // Etapes d'Avancer sur une partie du domaine (communes au séquentiel et au parallèle)
+    // Flux et Source sont des politiques de schéma (voir Schemas.h)
+    template <class Flux, class Source>
+    void CalculerInterfaces(int f_debut, int f_fin);
+    template <class Flux, class Source>
+    void MettreAJourCellules(int i_debut, int i_fin, double coeff);
+    template <class Flux, class Source>
+    void CalculerFluxEtMiseAJour(int i_debut, int i_fin, double coeff);
+    void AppliquerConditionsLimites(double* h, double* hu);
+    double NettoyerCellules(double* h, double* hu, int i_debut, int i_fin);
+
+    // Ordre 2 : h_out = h + coeff * dx * L(h, hu), avec reconstruction MUSCL
+    template <class Flux, class Limiteur>
+    void EtapeOrdre2(const double* h, const double* hu, double* h_out, double* hu_out, double coeff);
+    bool ChoisirEtapeOrdre2();
+    double AvancerOrdre2();
+    double VitesseMaximaleMorceau(int i_debut, int i_fin);
+
+    // Appelle tache(d, f, id_thread) sur [debut, fin), découpé entre les threads s'il y a un pool
+    void Parcourir(int debut, int fin, const std::function<void(int, int, int)>& tache);
+
+    // Somme de terme(i) sur toutes les cellules, par blocs de taille fixe :
+    // le résultat ne dépend pas du nombre de threads
+    template <class Terme>
+    double SommeParBlocs(Terme terme);
+
+    // Diagnostics en un passage, par blocs de taille fixe (résultat indépendant du
+    // nombre de threads). Dans Avancer, le passage est fusionné avec le nettoyage
+    // des cellules sèches (voir ActiverDiagnosticsEnLigne).
+    struct DiagnosticsBloc
+    {
+        SommeCompensee masse, energie;
+        double surface_max, hauteur_max;
+        double H_crete;
+        int i_crete;
+        int nb_mouillees;
+        double froude_max, froude_front;
+        int i_rivage;                   // Dernière cellule mouillée suivie d'une sèche dans le bloc (-1 : aucune)
+        bool premier_mouille, dernier_mouille;
+        double v_max;                   // max |u| + c, comme NettoyerCellules
+    };
+    bool _diagnostics_en_ligne;
+    Diagnostics _diagnostics;                       // Diagnostics du dernier pas (en ligne)
+    std::vector<DiagnosticsBloc> _diagnostics_blocs;
+    void DiagnostiquerBloc(double* h, double* hu, int i_debut, int i_fin, bool nettoyer, DiagnosticsBloc& d) const;
+    double CombinerDiagnostics(int nb_blocs, Diagnostics& diagnostics) const;
+    double PasserDiagnostics(double* h, double* hu, bool nettoyer, Diagnostics& diagnostics);
+
+    // Points de reprise périodiques (voir ActiverReprises)
+    std::unique_ptr<EcrivainReprise> _ecrivain_reprise;
+    int _reprise_tous_les_pas;
+    double _reprise_toutes_les_secondes;
+    long _pas_depuis_reprise;
+    std::chrono::steady_clock::time_point _instant_reprise;
+    void CopierEtatReprise(EtatReprise& etat) const;
+    void ReprisePeriodique();
+
+    // Jauges, enveloppes, arrivée et runup (voir ActiverObservateurs)
+    std::unique_ptr<Observateurs> _observateurs;
+
+    // Trames publiées en mémoire partagée (voir ActiverDiffusion)
+    std::unique_ptr<DiffusionPartagee> _diffusion;
+    int _diffusion_tous_les_pas;
+    long _pas_depuis_diffusion;
+
+    // Frottement sur le fond (voir DefinirFrottement)
+    std::vector<double> _manning;   // n de Manning de chaque cellule (vide : sans frottement)
+    bool _frottement_implicite;
+    void AppliquerFrottement(const double* h, double* hu, int i_debut, int i_fin, double dt) const;
+    double PasFrottementExplicite() const;
 
 public:
     // Constructeur
@@ -52,6 +264,46 @@ public:
     
     // Initialiser la simulation
     void Initialiser(int N, double L, double CFL, std::string nom_fichier);
+
+    // Choisir le schéma numérique : "flux" ou "flux/source"
+    //   flux   : rusanov, hll (défaut) ; "hllc" est un alias de hll (voir Schemas.h)
+    //   source : hydrostatique (défaut, équilibré), pente (pente centrée)
+    // Retourne false si la configuration est inconnue ou si la source pente est demandée
+    // à l'ordre 2 (le schéma n'est pas modifié)
+    bool ChoisirSchema(const std::string& config);
+    const std::string& ObtenirNomSchema() const { return _nom_schema; }
+
+    // Ordre du schéma :
+    //   1 : Godunov du premier ordre (défaut)
+    //   2 : reconstruction MUSCL limitée de h, eta = h + zb et u, reconstruction
+    //       hydrostatique d'Audusse (équilibrée, positive) et Runge-Kutta SSP d'ordre 2
+    //       limiteur : minmod (défaut), vanleer, mc. Un CFL <= 0.5 garantit la positivité.
+    //       Source hydrostatique seulement (pas de schéma .../pente à l'ordre 2).
+    // Retourne false si l'ordre ou le limiteur est inconnu, ou à l'ordre 2 avec la source pente
+    bool ChoisirOrdre(int ordre, const std::string& limiteur = "minmod");
+    int ObtenirOrdre() const { return _ordre; }
+
+    // Suivi des zones actives (ordre 1) : le domaine est découpé en blocs de taille_bloc
+    // cellules ; seuls les blocs qui ont évolué de plus de tolerance (sur h ou hu) au
+    // dernier pas, et leurs deux voisins, sont calculés. Les zones sèches et l'eau au
+    // repos ne coûtent plus rien ; les blocs sont réactivés quand le front arrive.
+    void ActiverZonesActives(bool actif, int taille_bloc = 256, double tolerance = 1e-10);
+    double ObtenirFractionActive() const;  // Part des cellules calculées au dernier pas
+
+    // Pas de temps local (ordre 1) : chaque cellule avance avec le pas 2^k dt_min permis
+    // par les vitesses |u| + sqrt(g h) autour d'elle, k < nb_niveaux.
+    // Une interface est calculée au rythme de la plus rapide de ses deux cellules et
+    // son flux est cumulé des deux côtés : la masse est conservée aux niveaux de
+    // raccord. Un appel à Avancer fait un macro-pas 2^k_max dt_min (voir ObtenirDt).
+    void ActiverPasDeTempsLocal(bool actif, int nb_niveaux = 4);
+    // Mises à jour de cellules d'un calcul à pas global sur la même durée, divisées par
+    // celles du dernier macro-pas (1 : aucun gain)
+    double ObtenirGainPasLocal() const { return _gain_pas_local; }
+
+    // Calcul multithread (nb_threads <= 1 : calcul séquentiel)
+    // Les résultats sont identiques bit à bit quel que soit le nombre de threads
+    void DefinirNombreThreads(int nb_threads);
+    int ObtenirNombreThreads() const;
     
     // Définir la condition initiale de vague
     void ConditionInitialeSoliton(double A, double x_depart);
@@ -64,6 +316,29 @@ public:
     void DefinirFondMarche(double x_marche, double z_haut);
     void DefinirFondPentePuisPlat(double x_debut, double x_fin, double z_fin);
     void DefinirFondDoublePente(double x_debut, double x_cassure, double z_cassure, double z_fin);
+    // Profil mesuré (CSV "x z" ou transect binaire, voir Bathymetrie.h), moyenné sur
+    // chaque cellule ; x_debut : abscisse du profil au bord gauche du domaine
+    // Retourne false si le profil est illisible (le fond n'est pas modifié)
+    bool ChargerFond(const std::string& nom_fichier, double x_debut = 0.0);
+
+    // Frottement sur le fond, loi de Manning : d(hu)/dt = -g n² |u| hu / h^(4/3), n en
+    // s/m^(1/3) (0.012 béton, 0.02 à 0.03 sable, 0.04 et plus galets ou végétation).
+    // Intégré après le pas hyperbolique de façon semi-implicite :
+    //   hu <- hu / (1 + dt g n² |u| / h^(4/3))
+    // (solution exacte du terme de frottement à h fixé), stable pour tout dt et sans
+    // changement de signe de hu : le pas reste celui de la condition CFL, même dans les
+    // films minces du rivage où le terme est raide. A l'ordre 2, un demi-pas avant et
+    // un après le pas Runge-Kutta (Strang) gardent l'ordre 2 en temps.
+    // A définir après Initialiser (qui le retire) ; la masse n'est pas modifiée.
+    void DefinirFrottement(double n_manning);                               // n uniforme, 0 : aucun
+    bool DefinirFrottementParCellule(const std::vector<double>& n_manning);  // N valeurs >= 0
+    // Traitement explicite, pour comparaison : hu <- hu (1 - dt g n² |u| / h^(4/3)), le pas
+    // de temps étant réduit pour que ce facteur reste au moins 1 - CFL sur l'état avant
+    // le pas. Le facteur est appliqué à l'état après le pas hyperbolique : dans un film
+    // mince devenu plus raide, il peut être négatif (non borné, Euler explicite tel quel).
+    // Ce pas coûte un passage séquentiel O(N) de plus à chaque pas (voir frottement)
+    void ChoisirFrottementImplicite(bool implicite) { _frottement_implicite = implicite; }
+    const std::vector<double>& ObtenirManning() const { return _manning; }
     // Calculer le flux physique F(h, hu) = (hu, hu²/h + g*h²/2)
     void CalculerFluxPhysique(double h, double hu, double& F_h, double& F_hu);
     
@@ -82,10 +357,45 @@ public:
     void CalculerPasDeTemps();
     
     // Avancer d'un pas de temps (schéma de Godunov)
-    void Avancer();
+    // Retourne la vitesse maximale du nouvel état (réutilisée pour le pas suivant)
+    double Avancer();
+    // Même pas, raccourci si besoin pour ne pas dépasser t_limite : le calcul s'arrête
+    // alors exactement à t_limite (pas de temps local : le macro-pas n'est pas raccourci)
+    double Avancer(double t_limite);
     
     // Sauvegarder la solution dans le fichier
+    // Texte : une ligne "t x h u zb H" par cellule. Fichier .svb : une trame float de h
+    // et hu par appel, x et zb écrits une fois (voir SortieBinaire.h). Fichier .svz :
+    // trame de h et u différenciée en temps et compressée (voir SortieCompressee.h)
     void Sauvegarder();
+    // Sortie .svz : tolérances absolues sur h (m) et u (m/s), 0 : sans perte par rapport
+    // au float, et une trame clé toutes les intervalle_cle sauvegardes. Avant le premier
+    // Sauvegarder ; retourne false (avec un message) sinon ou si la sortie n'est pas .svz.
+    bool DefinirCompressionSortie(double tolerance_h, double tolerance_u, int intervalle_cle = 100);
+    double ObtenirTauxCompressionSortie() const;  // Taille en .svb / taille en .svz (0 sans sortie .svz)
+    // Sauvegarder copie l'état dans un tampon d'une réserve de nb_tampons (au moins 2)
+    // et rend la main ; un thread dédié écrit les instantanés dans l'ordre (voir
+    // EcrivainSauvegardes.h). Tous les tampons en attente : Sauvegarder attend (bloquer)
+    // ou abandonne la sauvegarde. Reste actif après Initialiser et ChargerReprise ; les
+    // instantanés en attente sont écrits avant la fermeture du fichier.
+    void ActiverSauvegardesAsynchrones(bool actif, int nb_tampons = 3, bool bloquer = true);
+    void AttendreSauvegardes();   // Attend que les sauvegardes lancées soient écrites
+    long ObtenirNombreSauvegardesAbandonnees() const;
+    // Sortie texte : chiffres significatifs de chaque nombre (1 à 17, défaut 6 ; voir
+    // SortieTexte.h). Retourne false (avec un message) hors de cet intervalle.
+    bool DefinirPrecisionSortie(int chiffres);
+    // Avancer sauvegarde l'état aux temps t0 + k intervalle (t0 : temps de l'appel,
+    // k >= 1) : le pas qui franchirait une échéance est raccourci pour l'atteindre
+    // exactement, et les temps sont calculés par multiplication (pas de dérive). Les
+    // sorties sont ainsi alignées d'un calcul à l'autre quel que soit dt. Pas de temps
+    // local : sauvegarde à la fin du premier macro-pas qui atteint l'échéance. Avec
+    // Avancer(t_limite), le pas qui atteint t_limite sauvegarde aussi l'état, sur
+    // l'échéancier ou non : l'état final d'un calcul mené jusqu'à t_final est toujours
+    // écrit, une seule fois. intervalle <= 0 : désactivé. Reste actif après Initialiser, avec t0 = 0. Le point
+    // de reprise enregistre l'échéancier (intervalle, t0, échéances atteintes) :
+    // ChargerReprise le rétablit ; s'il n'en contient pas, l'intervalle défini avant
+    // reste actif avec t0 = 0 (les échéances déjà passées ne sont pas réécrites).
+    void DefinirIntervalleSorties(double intervalle);
     
     // Pour valider la quantité de masse
     double CalculerMasseTotale();
@@ -95,10 +405,69 @@ public:
     double ObtenirSurfaceMax();    // Retourne l'altitude max (h + zb) 
     // Pour valider l'energie
     double CalculerEnergieTotale();
+
+    // Tous les diagnostics ci-dessus en un seul passage, plus longueur mouillée,
+    // nombre de Froude max et position du rivage (sommes compensées)
+    Diagnostics CalculerDiagnostics();
+    // En ligne : Avancer calcule les diagnostics du nouvel état pendant son propre
+    // balayage des cellules (ordre 1 global ; les autres modes font un passage de plus)
+    void ActiverDiagnosticsEnLigne(bool actif);
+    const Diagnostics& ObtenirDiagnostics() const { return _diagnostics; }
+
+    // Instrumentation (compilée avec cmake -DINSTRUMENTATION=ON, voir Instrumentation.h) :
+    // minuteurs de phases, compteurs et histogramme de dt depuis Initialiser.
+    // Trace Chrome si le nom finit par .json, CSV sinon.
+    // Retournent false si l'instrumentation n'est pas compilée.
+    bool EcrireInstrumentation(const std::string& nom_fichier) const;
+    bool AfficherInstrumentation() const;
+
+    // Points de reprise binaires (voir Reprise.h) : état, bathymétrie, frottement, t, dt
+    // et paramètres du schéma. Après ChargerReprise, le calcul continue identique bit à
+    // bit (quel que soit le nombre de threads). nom_fichier_sortie : fichier de
+    // Sauvegarder, ouvert en ajout ("" : aucun ; texte, .svb ou .svz : les trames
+    // postérieures au point de reprise sont retirées). Retournent false (avec un
+    // message) en cas d'échec ; un ChargerReprise qui échoue ne modifie pas le solveur.
+    bool EcrireReprise(const std::string& nom_fichier) const;
+    bool ChargerReprise(const std::string& nom_fichier, const std::string& nom_fichier_sortie = "");
+    // Avancer écrit un point de reprise tous les tous_les_pas pas et/ou toutes les
+    // toutes_les_secondes secondes de calcul (0 : critère non utilisé), en arrière-plan :
+    // l'état est copié, puis un thread l'écrit de façon atomique (fichier temporaire
+    // renommé). Si l'écriture précédente n'est pas finie, la copie attend le pas suivant.
+    // nom_fichier vide : désactivé (après la fin de l'écriture en cours).
+    void ActiverReprises(const std::string& nom_fichier, int tous_les_pas, double toutes_les_secondes = 0.0);
+    long ObtenirNombreReprises() const;  // Points de reprise écrits depuis ActiverReprises
+
+    // Analyses en cours de calcul (voir Observateurs.h), mises à jour à la fin de chaque
+    // pas à partir de l'état courant : jauges aux abscisses x_jauges écrites dans
+    // fichier_jauges tous les tous_les_pas pas ("" : pas de fichier), enveloppes de H et
+    // u, temps d'arrivée (seuil_arrivee en m sur H) et runup maximal. A appeler après la
+    // condition initiale ; Initialiser les désactive. Retourne false (avec un message)
+    // si une jauge est hors du domaine ou si le fichier ne peut pas être ouvert.
+    bool ActiverObservateurs(const std::vector<double>& x_jauges, const std::string& fichier_jauges,
+                             int tous_les_pas = 1, double seuil_arrivee = 1e-3);
+    bool EcrireObservations(const std::string& nom_fichier) const;  // Enveloppes, arrivée et runup (CSV)
+    const Observateurs* ObtenirObservateurs() const { return _observateurs.get(); }  // nullptr si inactifs
+
+    // Suivi en direct (voir DiffusionPartagee.h) : l'état est publié tous les
+    // tous_les_pas pas dans un anneau de nb_emplacements trames en mémoire partagée
+    // POSIX nommée nom (/dev/shm/<nom>), lisible à tout moment par un ou plusieurs
+    // lecteurs (diffusion_directe.py) sans ralentir le calcul ni écrire sur le disque.
+    // A appeler après le fond et la condition initiale (publiée tout de suite) ;
+    // Initialiser la désactive. nom vide : désactivée. Retourne false (avec un message)
+    // si le segment ne peut pas être créé.
+    bool ActiverDiffusion(const std::string& nom, int tous_les_pas = 1, int nb_emplacements = 8);
+    long ObtenirNombreTramesDiffusees() const;
+    // Octets alloués par les tableaux du calcul (état, nouvel état, fond, interfaces, et
+    // s'ils sont utilisés ordre 2, zones actives, pas de temps local, frottement), hors
+    // sorties : pour estimer la mémoire d'un calcul plus grand configuré de même
+    size_t ObtenirMemoireTableaux() const;
     // Accesseurs
     double ObtenirTemps() const { return _t; }
     double ObtenirDt() const { return _dt; }
     double ObtenirHFond() const { return _h_fond; }
+    double ObtenirDx() const { return _dx; }
+    const std::vector<double>& ObtenirH() const { return _h; }
+    const std::vector<double>& ObtenirHu() const { return _hu; }
     const std::vector<double>& ObtenirZb() const { return _zb; }
     const std::vector<double>& ObtenirdZb() const { return _d_zb; }
 };
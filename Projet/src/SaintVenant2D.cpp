@@ -0,0 +1,787 @@
+#include "SaintVenant2D.h"
+#include "Schemas.h"
+#include "PoolThreads.h"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+SaintVenant2D::SaintVenant2D() : _Nx(0), _Ny(0), _t(0.0), _dt(0.0), _T(64), _S(66), _nb_tuiles_x(0), _nb_tuiles_y(0),
+    _murs(false), _x_en_premier(true), _vx_max(0.0), _vy_max(0.0), _v_max_valide(false)
+{
+    ChoisirFlux("hll");
+}
+
+
+SaintVenant2D::~SaintVenant2D()
+{
+    if (_fichier.is_open())
+        _fichier.close();
+}
+
+
+// Taille du tampon de faces d'un thread : deux rangées de faces de 9 tableaux (balayage en y)
+static inline size_t TailleTampon(int T)
+{
+    return 18 * (size_t)(T + 1);
+}
+
+
+void SaintVenant2D::Initialiser(int Nx, int Ny, double Lx, double Ly, double CFL, string nom_fichier, int taille_tuile)
+{
+    if (Nx < 2 || Ny < 2 || taille_tuile < 1)
+    {
+        cout << "Erreur : grille " << Nx << " x " << Ny << " ou tuiles de " << taille_tuile << " invalides" << endl;
+        return;
+    }
+
+    _Nx = Nx;
+    _Ny = Ny;
+    _Lx = Lx;
+    _Ly = Ly;
+    _dx = Lx / Nx;
+    _dy = Ly / Ny;
+    _CFL = CFL;
+    _t = 0.0;
+    _x_en_premier = true;
+
+    // Tuiles (les dernières de chaque rangée peuvent être incomplètes)
+    _T = taille_tuile;
+    _S = _T + 2;
+    _nb_tuiles_x = (Nx + _T - 1) / _T;
+    _nb_tuiles_y = (Ny + _T - 1) / _T;
+    int nb_tuiles = _nb_tuiles_x * _nb_tuiles_y;
+
+    _donnees.assign((size_t)nb_tuiles * NB_CHAMPS * _S * _S, 0.0);
+    _vx_max_tuiles.assign(nb_tuiles, 0.0);
+    _vy_max_tuiles.assign(nb_tuiles, 0.0);
+    _tampons.assign(ObtenirNombreThreads(), vector<double>(TailleTampon(_T)));
+    _v_max_valide = false;
+
+    _fichier.open(nom_fichier);
+
+    cout << "Simulation 2D initialisée :" << endl;
+    cout << "  - Grille : " << Nx << " x " << Ny << " cellules" << endl;
+    cout << "  - Domaine : " << Lx << " x " << Ly << " m" << endl;
+    cout << "  - Pas d'espace dx, dy : " << _dx << ", " << _dy << " m" << endl;
+    cout << "  - Tuiles : " << _nb_tuiles_x << " x " << _nb_tuiles_y << " de " << _T << " x " << _T
+         << " cellules (" << _donnees.size() * sizeof(double) / (1024 * 1024) << " Mo)" << endl;
+}
+
+
+bool SaintVenant2D::ChoisirFlux(const string& nom)
+{
+    struct EntreeFlux
+    {
+        const char* nom;
+        FonctionBalayage x;
+        FonctionBalayage y;
+    };
+    static const EntreeFlux flux[] = {
+        { FluxPolitiqueRusanov::Nom(), &SaintVenant2D::BalayageX<FluxPolitiqueRusanov>, &SaintVenant2D::BalayageY<FluxPolitiqueRusanov> },
+        { FluxPolitiqueHLL::Nom(),     &SaintVenant2D::BalayageX<FluxPolitiqueHLL>,     &SaintVenant2D::BalayageY<FluxPolitiqueHLL> },
+    };
+
+    string nom_effectif = NomFluxEffectif(nom);
+    for (const EntreeFlux& entree : flux)
+    {
+        if (nom_effectif == entree.nom)
+        {
+            _balayage_x = entree.x;
+            _balayage_y = entree.y;
+            _nom_flux = nom_effectif;
+            return true;
+        }
+    }
+
+    cout << "Erreur : flux inconnu '" << nom << "' (rusanov, hll)" << endl;
+    return false;
+}
+
+
+void SaintVenant2D::DefinirNombreThreads(int nb_threads)
+{
+    if (nb_threads > 1)
+        _pool.reset(new PoolThreads(nb_threads));
+    else
+        _pool.reset();
+    _tampons.assign(ObtenirNombreThreads(), vector<double>(TailleTampon(_T)));
+}
+
+
+int SaintVenant2D::ObtenirNombreThreads() const
+{
+    return _pool ? _pool->NombreThreads() : 1;
+}
+
+
+void SaintVenant2D::Parcourir(int debut, int fin, const function<void(int, int, int)>& tache)
+{
+    if (_pool)
+        _pool->ExecuterParMorceaux(debut, fin, tache);
+    else if (debut < fin)
+        tache(debut, fin, 0);
+}
+
+
+int SaintVenant2D::CellulesX(int tuile) const
+{
+    int tx = tuile % _nb_tuiles_x;
+    return min(_T, _Nx - tx * _T);
+}
+
+
+int SaintVenant2D::CellulesY(int tuile) const
+{
+    int ty = tuile / _nb_tuiles_x;
+    return min(_T, _Ny - ty * _T);
+}
+
+
+// ========================================
+// Halos
+// ========================================
+// Dans une tuile, la cellule locale (li, lj) est en (lj + 1) * S + (li + 1) :
+// la colonne 0 et la colonne nx + 1, la rangée 0 et la rangée ny + 1 forment le halo.
+// Les tuiles voisines d'une tuile incomplète sont toujours complètes dans la
+// direction de l'échange (seules les dernières tuiles sont incomplètes).
+void SaintVenant2D::EchangerHalos(int tuile, int direction, bool avec_fond)
+{
+    int tx = tuile % _nb_tuiles_x, ty = tuile / _nb_tuiles_x;
+    int nx = CellulesX(tuile), ny = CellulesY(tuile);
+    int nb_champs = avec_fond ? NB_CHAMPS : CHAMP_ZB;
+
+    for (int c = 0; c < nb_champs; c++)
+    {
+        double* q = Champ(tuile, c);
+
+        if (direction == 0)
+        {
+            // Mur : la vitesse normale change de signe
+            double signe = (_murs && c == CHAMP_HU) ? -1.0 : 1.0;
+
+            // Colonne de gauche
+            if (tx > 0)
+            {
+                const double* voisine = Champ(tuile - 1, c);
+                for (int lj = 1; lj <= ny; lj++)
+                    q[lj * _S] = voisine[lj * _S + _T];
+            }
+            else
+            {
+                for (int lj = 1; lj <= ny; lj++)
+                    q[lj * _S] = signe * q[lj * _S + 1];
+            }
+
+            // Colonne de droite
+            if (tx < _nb_tuiles_x - 1)
+            {
+                const double* voisine = Champ(tuile + 1, c);
+                for (int lj = 1; lj <= ny; lj++)
+                    q[lj * _S + nx + 1] = voisine[lj * _S + 1];
+            }
+            else
+            {
+                for (int lj = 1; lj <= ny; lj++)
+                    q[lj * _S + nx + 1] = signe * q[lj * _S + nx];
+            }
+        }
+        else
+        {
+            double signe = (_murs && c == CHAMP_HV) ? -1.0 : 1.0;
+
+            // Rangée du bas
+            if (ty > 0)
+            {
+                const double* voisine = Champ(tuile - _nb_tuiles_x, c);
+                for (int li = 1; li <= nx; li++)
+                    q[li] = voisine[_T * _S + li];
+            }
+            else
+            {
+                for (int li = 1; li <= nx; li++)
+                    q[li] = signe * q[_S + li];
+            }
+
+            // Rangée du haut
+            if (ty < _nb_tuiles_y - 1)
+            {
+                const double* voisine = Champ(tuile + _nb_tuiles_x, c);
+                for (int li = 1; li <= nx; li++)
+                    q[(ny + 1) * _S + li] = voisine[_S + li];
+            }
+            else
+            {
+                for (int li = 1; li <= nx; li++)
+                    q[(ny + 1) * _S + li] = signe * q[ny * _S + li];
+            }
+        }
+    }
+}
+
+
+void SaintVenant2D::EchangerTousLesHalos(int direction, bool avec_fond)
+{
+    // Chaque tuile lit l'intérieur de ses voisines et n'écrit que son halo
+    Parcourir(0, _nb_tuiles_x * _nb_tuiles_y, [this, direction, avec_fond](int d, int f, int)
+    {
+        for (int t = d; t < f; t++)
+            EchangerHalos(t, direction, avec_fond);
+    });
+}
+
+
+// ========================================
+// Balayages
+// ========================================
+// Reconstruction hydrostatique (SourceHydrostatique::ReconstruirePoint), flux de
+// la politique sur (h, débit normal) par lots, débit transverse transporté par le
+// flux de masse (vitesse transverse de la cellule en amont). Le terme source est
+// celui d'Audusse : g/2 (h_interface^2 - h^2) à droite, moins le même à gauche.
+
+static inline double Vitesse(double h, double q, double critere_h)
+{
+    return (h > critere_h) ? q / h : 0.0;
+}
+
+
+template <class Flux>
+void SaintVenant2D::BalayageX(int tuile, double coeff, double* tampon)
+{
+    int nx = CellulesX(tuile), ny = CellulesY(tuile);
+    double* h = Champ(tuile, CHAMP_H);
+    double* hu = Champ(tuile, CHAMP_HU);
+    double* hv = Champ(tuile, CHAMP_HV);
+    const double* zb = Champ(tuile, CHAMP_ZB);
+
+    // Faces f = 0 .. nx d'une rangée : entre les cellules (halo compris) f et f + 1
+    int n = _T + 1;
+    double* hG = tampon;
+    double* hD = hG + n;
+    double* huG = hD + n;
+    double* huD = huG + n;
+    double* vG = huD + n;
+    double* vD = vG + n;
+    double* F_h = vD + n;
+    double* F_hu = F_h + n;
+    double* F_hv = F_hu + n;
+
+    for (int lj = 1; lj <= ny; lj++)
+    {
+        double* hr = h + lj * _S;
+        double* hur = hu + lj * _S;
+        double* hvr = hv + lj * _S;
+        const double* zr = zb + lj * _S;
+
+        // 1. Reconstruction des faces de la rangée
+        for (int f = 0; f <= nx; f++)
+        {
+            SourceHydrostatique::ReconstruirePoint(hr[f], zr[f], hr[f+1], zr[f+1], hG[f], hD[f]);
+            huG[f] = hG[f] * Vitesse(hr[f], hur[f], critere_hauteur_deau);
+            huD[f] = hD[f] * Vitesse(hr[f+1], hur[f+1], critere_hauteur_deau);
+            vG[f] = Vitesse(hr[f], hvr[f], critere_hauteur_deau);
+            vD[f] = Vitesse(hr[f+1], hvr[f+1], critere_hauteur_deau);
+        }
+
+        // 2. Flux de la rangée en un seul lot
+        Flux::Lot(nx + 1, hG, huG, hD, huD, F_h, F_hu, _g, critere_hauteur_deau);
+        for (int f = 0; f <= nx; f++)
+            F_hv[f] = (F_h[f] > 0.0) ? F_h[f] * vG[f] : F_h[f] * vD[f];
+
+        // 3. Mise à jour : la cellule c a la face c - 1 à gauche et la face c à droite
+        for (int c = 1; c <= nx; c++)
+        {
+            double h_c = hr[c];
+            double Source = 0.5 * _g * (hG[c] * hG[c] - h_c * h_c) - 0.5 * _g * (hD[c-1] * hD[c-1] - h_c * h_c);
+
+            double h_n = h_c - coeff * (F_h[c] - F_h[c-1]);
+            double hu_n = hur[c] - coeff * (F_hu[c] - F_hu[c-1]) + coeff * Source;
+            double hv_n = hvr[c] - coeff * (F_hv[c] - F_hv[c-1]);
+
+            // Cellule sèche
+            if (h_n < critere_hauteur_deau)
+            {
+                h_n = 0.0;
+                hu_n = 0.0;
+                hv_n = 0.0;
+            }
+            hr[c] = h_n;
+            hur[c] = hu_n;
+            hvr[c] = hv_n;
+        }
+    }
+}
+
+
+template <class Flux>
+void SaintVenant2D::BalayageY(int tuile, double coeff, double* tampon)
+{
+    int nx = CellulesX(tuile), ny = CellulesY(tuile);
+    double* h = Champ(tuile, CHAMP_H);
+    double* hu = Champ(tuile, CHAMP_HU);
+    double* hv = Champ(tuile, CHAMP_HV);
+    const double* zb = Champ(tuile, CHAMP_ZB);
+
+    // Deux rangées de faces : sous la rangée de cellules en cours (A) et au-dessus (B)
+    int n = _T + 1;
+    struct RangeeFaces
+    {
+        double *hG, *hD, *hvG, *hvD, *uG, *uD, *F_h, *F_hv, *F_hu;
+    };
+    RangeeFaces rangees[2];
+    for (int k = 0; k < 2; k++)
+    {
+        double* p = tampon + k * 9 * n;
+        rangees[k] = { p, p + n, p + 2*n, p + 3*n, p + 4*n, p + 5*n, p + 6*n, p + 7*n, p + 8*n };
+    }
+
+    // Faces entre les rangées r et r + 1 (halo compris), pour les colonnes 1 .. nx
+    auto CalculerFaces = [&](int r, RangeeFaces& F)
+    {
+        const double* h0 = h + r * _S + 1;
+        const double* h1 = h0 + _S;
+        const double* hu0 = hu + r * _S + 1;
+        const double* hu1 = hu0 + _S;
+        const double* hv0 = hv + r * _S + 1;
+        const double* hv1 = hv0 + _S;
+        const double* z0 = zb + r * _S + 1;
+        const double* z1 = z0 + _S;
+
+        for (int k = 0; k < nx; k++)
+        {
+            SourceHydrostatique::ReconstruirePoint(h0[k], z0[k], h1[k], z1[k], F.hG[k], F.hD[k]);
+            F.hvG[k] = F.hG[k] * Vitesse(h0[k], hv0[k], critere_hauteur_deau);
+            F.hvD[k] = F.hD[k] * Vitesse(h1[k], hv1[k], critere_hauteur_deau);
+            F.uG[k] = Vitesse(h0[k], hu0[k], critere_hauteur_deau);
+            F.uD[k] = Vitesse(h1[k], hu1[k], critere_hauteur_deau);
+        }
+
+        Flux::Lot(nx, F.hG, F.hvG, F.hD, F.hvD, F.F_h, F.F_hv, _g, critere_hauteur_deau);
+        for (int k = 0; k < nx; k++)
+            F.F_hu[k] = (F.F_h[k] > 0.0) ? F.F_h[k] * F.uG[k] : F.F_h[k] * F.uD[k];
+    };
+
+    int a = 0;  // Rangée de faces sous la rangée de cellules en cours
+    CalculerFaces(0, rangees[a]);
+    for (int lj = 1; lj <= ny; lj++)
+    {
+        // La face du dessus utilise la rangée lj avant sa mise à jour
+        RangeeFaces& bas = rangees[a];
+        RangeeFaces& haut = rangees[1 - a];
+        CalculerFaces(lj, haut);
+
+        double* hr = h + lj * _S + 1;
+        double* hur = hu + lj * _S + 1;
+        double* hvr = hv + lj * _S + 1;
+        for (int k = 0; k < nx; k++)
+        {
+            double h_c = hr[k];
+            double Source = 0.5 * _g * (haut.hG[k] * haut.hG[k] - h_c * h_c) - 0.5 * _g * (bas.hD[k] * bas.hD[k] - h_c * h_c);
+
+            double h_n = h_c - coeff * (haut.F_h[k] - bas.F_h[k]);
+            double hv_n = hvr[k] - coeff * (haut.F_hv[k] - bas.F_hv[k]) + coeff * Source;
+            double hu_n = hur[k] - coeff * (haut.F_hu[k] - bas.F_hu[k]);
+
+            if (h_n < critere_hauteur_deau)
+            {
+                h_n = 0.0;
+                hu_n = 0.0;
+                hv_n = 0.0;
+            }
+            hr[k] = h_n;
+            hur[k] = hu_n;
+            hvr[k] = hv_n;
+        }
+
+        a = 1 - a;
+    }
+}
+
+
+void SaintVenant2D::VitesseMaximaleTuile(int tuile)
+{
+    int nx = CellulesX(tuile), ny = CellulesY(tuile);
+    const double* h = Champ(tuile, CHAMP_H);
+    const double* hu = Champ(tuile, CHAMP_HU);
+    const double* hv = Champ(tuile, CHAMP_HV);
+
+    double vx = 0.0, vy = 0.0;
+    for (int lj = 1; lj <= ny; lj++)
+    {
+        for (int li = 1; li <= nx; li++)
+        {
+            int k = lj * _S + li;
+            double c = (h[k] > 1e-10) ? sqrt(_g * h[k]) : 0.0;
+            vx = max(vx, fabs(Vitesse(h[k], hu[k], critere_hauteur_deau)) + c);
+            vy = max(vy, fabs(Vitesse(h[k], hv[k], critere_hauteur_deau)) + c);
+        }
+    }
+    _vx_max_tuiles[tuile] = vx;
+    _vy_max_tuiles[tuile] = vy;
+}
+
+
+void SaintVenant2D::CalculerPasDeTemps()
+{
+    int nb_tuiles = _nb_tuiles_x * _nb_tuiles_y;
+
+    // Vitesses fournies par le pas précédent quand l'état n'a pas changé depuis
+    if (!_v_max_valide)
+    {
+        Parcourir(0, nb_tuiles, [this](int d, int f, int)
+        {
+            for (int t = d; t < f; t++)
+                VitesseMaximaleTuile(t);
+        });
+    }
+
+    _vx_max = 0.0;
+    _vy_max = 0.0;
+    for (int t = 0; t < nb_tuiles; t++)
+    {
+        _vx_max = max(_vx_max, _vx_max_tuiles[t]);
+        _vy_max = max(_vy_max, _vy_max_tuiles[t]);
+    }
+
+    // Chaque balayage respecte sa propre condition CFL
+    double dt = 0.01;  // Valeur par défaut si l'eau est immobile
+    if (_vx_max > 1e-10)
+        dt = _CFL * _dx / _vx_max;
+    if (_vy_max > 1e-10)
+        dt = (_vx_max > 1e-10) ? min(dt, _CFL * _dy / _vy_max) : _CFL * _dy / _vy_max;
+    _dt = dt;
+}
+
+
+void SaintVenant2D::Balayer(int direction, double coeff, bool dernier)
+{
+    EchangerTousLesHalos(direction, false);
+
+    FonctionBalayage balayage = (direction == 0) ? _balayage_x : _balayage_y;
+    Parcourir(0, _nb_tuiles_x * _nb_tuiles_y, [this, balayage, coeff, dernier](int d, int f, int id)
+    {
+        double* tampon = _tampons[id].data();
+        for (int t = d; t < f; t++)
+        {
+            (this->*balayage)(t, coeff, tampon);
+
+            // Vitesse max du nouvel état, tant que la tuile est dans le cache
+            if (dernier)
+                VitesseMaximaleTuile(t);
+        }
+    });
+}
+
+
+// ========================================
+// Avancer d'un pas de temps
+// ========================================
+void SaintVenant2D::Avancer()
+{
+    CalculerPasDeTemps();
+
+    if (_x_en_premier)
+    {
+        Balayer(0, _dt / _dx, false);
+        Balayer(1, _dt / _dy, true);
+    }
+    else
+    {
+        Balayer(1, _dt / _dy, false);
+        Balayer(0, _dt / _dx, true);
+    }
+    _x_en_premier = !_x_en_premier;
+    _v_max_valide = true;
+
+    _t += _dt;
+}
+
+
+// ========================================
+// Bathymétrie
+// ========================================
+
+void SaintVenant2D::DefinirFond(const function<double(double, double)>& z)
+{
+    _v_max_valide = false;
+    Parcourir(0, _nb_tuiles_x * _nb_tuiles_y, [this, &z](int d, int f, int)
+    {
+        for (int t = d; t < f; t++)
+        {
+            int tx = t % _nb_tuiles_x, ty = t / _nb_tuiles_x;
+            double* zb = Champ(t, CHAMP_ZB);
+            for (int lj = 0; lj < CellulesY(t); lj++)
+            {
+                double y = (ty * _T + lj + 0.5) * _dy;
+                for (int li = 0; li < CellulesX(t); li++)
+                {
+                    double x = (tx * _T + li + 0.5) * _dx;
+                    zb[(lj + 1) * _S + li + 1] = z(x, y);
+                }
+            }
+        }
+    });
+
+    // Le fond ne change plus : ses halos sont remplis une fois pour toutes
+    EchangerTousLesHalos(0, true);
+    EchangerTousLesHalos(1, true);
+}
+
+
+void SaintVenant2D::DefinirFondPlat()
+{
+    DefinirFond([](double, double) { return 0.0; });
+    cout << "Bathymetrie : Fond plat (z=0)." << endl;
+}
+
+
+void SaintVenant2D::DefinirFondPente(double x_debut, double z_fin)
+{
+    double pente = z_fin / (_Lx - x_debut);
+    DefinirFond([=](double x, double) { return (x < x_debut) ? 0.0 : pente * (x - x_debut); });
+    cout << "Bathymetrie : Pente démarrant a x=" << x_debut << "m." << endl;
+}
+
+
+void SaintVenant2D::DefinirFondMarche(double x_marche, double z_haut)
+{
+    DefinirFond([=](double x, double) { return (x < x_marche) ? 0.0 : z_haut; });
+    cout << "Bathymetrie : Marche d'escalier a x=" << x_marche << "m (Hauteur=" << z_haut << "m)." << endl;
+}
+
+
+void SaintVenant2D::DefinirFondPentePuisPlat(double x_debut, double x_fin, double z_fin)
+{
+    if (x_fin <= x_debut) {
+        cout << "Erreur : x_fin doit etre plus grand que x_debut !" << endl;
+        return;
+    }
+
+    double pente = z_fin / (x_fin - x_debut);
+    DefinirFond([=](double x, double)
+    {
+        if (x < x_debut) return 0.0;
+        if (x > x_fin) return z_fin;
+        return pente * (x - x_debut);
+    });
+    cout << "Bathymetrie : Pente de x=" << x_debut << " a x=" << x_fin
+         << ", puis plateau a z=" << z_fin << "m." << endl;
+}
+
+
+void SaintVenant2D::DefinirFondDoublePente(double x_debut, double x_cassure, double z_cassure, double z_fin)
+{
+    if (x_cassure <= x_debut || x_cassure >= _Lx) {
+        cout << "Erreur Geometrie : Les points x doivent etre ordonnes (debut < cassure < Lx)" << endl;
+        return;
+    }
+
+    double pente_1 = z_cassure / (x_cassure - x_debut);
+    double pente_2 = (z_fin - z_cassure) / (_Lx - x_cassure);
+    DefinirFond([=](double x, double)
+    {
+        if (x < x_debut) return 0.0;
+        if (x < x_cassure) return pente_1 * (x - x_debut);
+        return z_cassure + pente_2 * (x - x_cassure);
+    });
+    cout << "Bathymetrie : Double Pente (" << pente_1 << " puis " << pente_2 << ")." << endl;
+}
+
+
+void SaintVenant2D::DefinirFondIle(double x0, double y0, double rayon, double z_sommet)
+{
+    DefinirFond([=](double x, double y)
+    {
+        double r = sqrt((x - x0) * (x - x0) + (y - y0) * (y - y0));
+        return max(0.0, z_sommet * (1.0 - r / rayon));
+    });
+    cout << "Bathymetrie : Ile conique en (" << x0 << ", " << y0 << "), rayon " << rayon
+         << " m, sommet a z=" << z_sommet << "m." << endl;
+}
+
+
+// ========================================
+// Conditions initiales
+// ========================================
+
+void SaintVenant2D::DefinirEau(const function<void(double, double, double, double&, double&, double&)>& eau)
+{
+    _v_max_valide = false;
+    Parcourir(0, _nb_tuiles_x * _nb_tuiles_y, [this, &eau](int d, int f, int)
+    {
+        for (int t = d; t < f; t++)
+        {
+            int tx = t % _nb_tuiles_x, ty = t / _nb_tuiles_x;
+            double* h = Champ(t, CHAMP_H);
+            double* hu = Champ(t, CHAMP_HU);
+            double* hv = Champ(t, CHAMP_HV);
+            const double* zb = Champ(t, CHAMP_ZB);
+            for (int lj = 0; lj < CellulesY(t); lj++)
+            {
+                double y = (ty * _T + lj + 0.5) * _dy;
+                for (int li = 0; li < CellulesX(t); li++)
+                {
+                    double x = (tx * _T + li + 0.5) * _dx;
+                    int k = (lj + 1) * _S + li + 1;
+                    eau(x, y, zb[k], h[k], hu[k], hv[k]);
+
+                    if (h[k] < critere_hauteur_deau)
+                    {
+                        h[k] = 0.0;
+                        hu[k] = 0.0;
+                        hv[k] = 0.0;
+                    }
+                }
+            }
+        }
+    });
+}
+
+
+void SaintVenant2D::ConditionInitialeSoliton(double A, double x_depart)
+{
+    // Même profil que SaintVenant1D::ConditionInitialeSoliton, invariant en y
+    double h0 = 2;
+    double c = sqrt(_g * (h0 + A));
+    double k = sqrt((3.0 * A) / (4.0 * pow(h0, 3)));
+
+    cout << "Initialisation Soliton plan :" << endl;
+    cout << "  - Amplitude : " << A << " m" << endl;
+    cout << "  - Vitesse de l'onde (calculee) : " << c << " m/s" << endl;
+
+    DefinirEau([=](double x, double, double zb, double& h, double& hu, double& hv)
+    {
+        double sech = 1.0 / cosh(k * (x - x_depart));
+        double eta = A * sech * sech;
+        double H = h0 + eta;
+        h = max(0.0, H - zb);
+        hu = h * c * (eta / H);
+        hv = 0.0;
+    });
+}
+
+
+void SaintVenant2D::ConditionInitialeDamBreak()
+{
+    DefinirEau([this](double x, double, double, double& h, double& hu, double& hv)
+    {
+        h = (x < 0.5 * _Lx) ? 10.0 : 5.0;
+        hu = 0.0;
+        hv = 0.0;
+    });
+}
+
+
+void SaintVenant2D::ConditionInitialeDamBreakCirculaire(double x0, double y0, double rayon, double h_interieur, double h_exterieur)
+{
+    DefinirEau([=](double x, double y, double, double& h, double& hu, double& hv)
+    {
+        double r2 = (x - x0) * (x - x0) + (y - y0) * (y - y0);
+        h = (r2 < rayon * rayon) ? h_interieur : h_exterieur;
+        hu = 0.0;
+        hv = 0.0;
+    });
+}
+
+
+void SaintVenant2D::ConditionInitialeGaussienne(double amplitude, double x0, double y0, double largeur, double vitesse_init)
+{
+    // Même bosse que SaintVenant1D::ConditionInitialeGaussienne, radiale, vitesse selon x
+    double niveau_moyen = 0.2;
+
+    cout << "Initialisation Gaussienne 2D :" << endl;
+    cout << "  - Amplitude : " << amplitude << " m" << endl;
+    cout << "  - Vitesse   : " << vitesse_init << " m/s (Appliquee uniquement sous la bosse)" << endl;
+
+    DefinirEau([=](double x, double y, double zb, double& h, double& hu, double& hv)
+    {
+        double r2 = (x - x0) * (x - x0) + (y - y0) * (y - y0);
+        double facteur_forme = exp(-r2 / (largeur * largeur));
+        h = max(0.0, niveau_moyen + amplitude * facteur_forme - zb);
+        double u_local = (fabs(amplitude) < 1e-9) ? 0.0 : vitesse_init * facteur_forme;
+        hu = h * u_local;
+        hv = 0.0;
+    });
+}
+
+
+void SaintVenant2D::ConditionInitialeLacAuRepos(double niveau)
+{
+    DefinirEau([=](double, double, double zb, double& h, double& hu, double& hv)
+    {
+        h = max(0.0, niveau - zb);
+        hu = 0.0;
+        hv = 0.0;
+    });
+}
+
+
+// ========================================
+// Sauvegarde et validation
+// ========================================
+
+void SaintVenant2D::Sauvegarder(int pas)
+{
+    if (pas < 1) pas = 1;
+    for (int j = 0; j < _Ny; j += pas)
+    {
+        for (int i = 0; i < _Nx; i += pas)
+        {
+            double h = ObtenirH(i, j), zb = ObtenirZb(i, j);
+            double u = Vitesse(h, ObtenirHu(i, j), critere_hauteur_deau);
+            double v = Vitesse(h, ObtenirHv(i, j), critere_hauteur_deau);
+
+            // On écrit : t x y h u v zb H
+            _fichier << _t << " " << (i + 0.5) * _dx << " " << (j + 0.5) * _dy << " " << h << " "
+                     << u << " " << v << " " << zb << " " << h + zb << "\n";
+        }
+        _fichier << "\n";
+    }
+    _fichier << endl;
+}
+
+
+double SaintVenant2D::CalculerMasseTotale()
+{
+    // Somme par tuile puis somme des tuiles dans l'ordre : indépendant du nombre de threads
+    int nb_tuiles = _nb_tuiles_x * _nb_tuiles_y;
+    vector<double> sommes(nb_tuiles);
+    Parcourir(0, nb_tuiles, [this, &sommes](int d, int f, int)
+    {
+        for (int t = d; t < f; t++)
+        {
+            const double* h = Champ(t, CHAMP_H);
+            double somme = 0.0;
+            for (int lj = 1; lj <= CellulesY(t); lj++)
+                for (int li = 1; li <= CellulesX(t); li++)
+                    somme += h[lj * _S + li];
+            sommes[t] = somme;
+        }
+    });
+
+    double volume = 0.0;
+    for (int t = 0; t < nb_tuiles; t++)
+        volume += sommes[t];
+    return volume * _dx * _dy;
+}
+
+
+double SaintVenant2D::ObtenirSurfaceMax()
+{
+    double H_max = -99999.0;
+    for (int t = 0; t < _nb_tuiles_x * _nb_tuiles_y; t++)
+    {
+        const double* h = Champ(t, CHAMP_H);
+        const double* zb = Champ(t, CHAMP_ZB);
+        for (int lj = 1; lj <= CellulesY(t); lj++)
+        {
+            for (int li = 1; li <= CellulesX(t); li++)
+            {
+                int k = lj * _S + li;
+                if (h[k] > 1e-6)
+                    H_max = max(H_max, h[k] + zb[k]);
+            }
+        }
+    }
+    return H_max;
+}
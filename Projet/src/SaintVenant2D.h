@@ -0,0 +1,165 @@
+#ifndef _SAINT_VENANT_2D_H
+#define _SAINT_VENANT_2D_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <memory>
+#include <functional>
+
+class PoolThreads;
+
+// ========================================
+// Saint-Venant 2D : bassins
+// ========================================
+// Volumes finis sur une grille Nx x Ny, avec séparation des directions : un
+// balayage en x (flux HLL/Rusanov des politiques de Schemas.h sur (h, hu),
+// hv transporté par le flux de masse) puis un balayage en y, dans l'ordre
+// inverse au pas suivant. Reconstruction hydrostatique d'Audusse dans chaque
+// direction (lac au repos préservé exactement).
+//
+// Stockage par tuiles : la grille est découpée en tuiles de T x T cellules, chacune
+// entourée d'un halo d'une cellule. Les champs h, hu, hv, zb d'une tuile sont
+// contigus ((T+2)^2 valeurs chacun) : une tuile de 64 x 64 tient dans le cache L2
+// et chaque balayage la traite entièrement avant de passer à la suivante.
+// Avant chaque balayage, les halos sont recopiés depuis les tuiles voisines (ou
+// les conditions aux limites). Les tuiles sont ensuite indépendantes et sont
+// réparties entre les threads ; le flux d'une interface entre deux tuiles est
+// calculé des deux côtés avec les mêmes valeurs, donc la masse est conservée.
+class SaintVenant2D
+{
+private:
+    // Paramètres du domaine
+    int _Nx, _Ny;         // Nombre de cellules
+    double _Lx, _Ly;      // Domaine [0, Lx] x [0, Ly]
+    double _dx, _dy;
+    double critere_hauteur_deau = 1e-4;
+
+    // Paramètres temporels
+    double _t;
+    double _dt;
+    double _CFL;
+
+    // Tuiles
+    int _T;               // Cellules par côté de tuile
+    int _S;               // Côté avec le halo : T + 2
+    int _nb_tuiles_x, _nb_tuiles_y;
+    std::vector<double> _donnees;  // Tuile après tuile : h, hu, hv, zb (S x S chacun)
+    enum { CHAMP_H = 0, CHAMP_HU = 1, CHAMP_HV = 2, CHAMP_ZB = 3, NB_CHAMPS = 4 };
+
+    // Bords : murs (réflexion) ou ouverts (sortie libre)
+    bool _murs;
+
+    // Balayages alternés : x puis y, puis y puis x au pas suivant
+    bool _x_en_premier;
+
+    // Vitesses max de l'état courant (|u| + c en x, |v| + c en y), par tuile
+    double _vx_max, _vy_max;
+    bool _v_max_valide;
+    std::vector<double> _vx_max_tuiles;
+    std::vector<double> _vy_max_tuiles;
+
+    static constexpr double _g = 9.81;
+
+    std::ofstream _fichier;
+
+    // Balayages : une instanciation par politique de flux
+    typedef void (SaintVenant2D::*FonctionBalayage)(int tuile, double coeff, double* tampon);
+    FonctionBalayage _balayage_x;
+    FonctionBalayage _balayage_y;
+    std::string _nom_flux;
+
+    // Calcul parallèle par tuiles (pas de pool = calcul séquentiel)
+    std::unique_ptr<PoolThreads> _pool;
+    std::vector<std::vector<double> > _tampons;  // Tampon de faces de chaque thread
+
+    // Accès aux tuiles
+    int TuileDe(int i, int j) const { return (j / _T) * _nb_tuiles_x + (i / _T); }
+    int CellulesX(int tuile) const;
+    int CellulesY(int tuile) const;
+    double* Champ(int tuile, int champ) { return &_donnees[((size_t)tuile * NB_CHAMPS + champ) * _S * _S]; }
+    const double* Champ(int tuile, int champ) const { return &_donnees[((size_t)tuile * NB_CHAMPS + champ) * _S * _S]; }
+    // Position de la cellule (i, j) dans sa tuile (halo compris)
+    int Local(int i, int j) const { return (j % _T + 1) * _S + (i % _T + 1); }
+
+    // Halos de la tuile dans une direction (0 : x, 1 : y), avec ou sans le fond
+    void EchangerHalos(int tuile, int direction, bool avec_fond);
+    void EchangerTousLesHalos(int direction, bool avec_fond);
+
+    template <class Flux>
+    void BalayageX(int tuile, double coeff, double* tampon);
+    template <class Flux>
+    void BalayageY(int tuile, double coeff, double* tampon);
+    void Balayer(int direction, double coeff, bool dernier);
+    void VitesseMaximaleTuile(int tuile);
+    void CalculerPasDeTemps();
+
+    // Appelle tache(d, f, id_thread) sur [debut, fin), découpé entre les threads s'il y a un pool
+    void Parcourir(int debut, int fin, const std::function<void(int, int, int)>& tache);
+
+    // Fond zb(x, y) sur toute la grille, halos compris
+    void DefinirFond(const std::function<double(double, double)>& z);
+    // h, hu, hv sur toute la grille à partir de (x, y, zb)
+    void DefinirEau(const std::function<void(double, double, double, double&, double&, double&)>& eau);
+
+public:
+    SaintVenant2D();
+    ~SaintVenant2D();
+
+    // Initialiser la simulation (taille_tuile : côté des tuiles, en cellules)
+    void Initialiser(int Nx, int Ny, double Lx, double Ly, double CFL, std::string nom_fichier, int taille_tuile = 64);
+
+    // Flux numérique : rusanov, hll (défaut) ; "hllc" est un alias de hll (voir Schemas.h)
+    // Retourne false si le flux est inconnu (le schéma n'est pas modifié)
+    bool ChoisirFlux(const std::string& nom);
+    const std::string& ObtenirNomFlux() const { return _nom_flux; }
+
+    // Bords : true = murs réfléchissants, false = sortie libre (défaut)
+    void DefinirMurs(bool murs) { _murs = murs; }
+
+    // Calcul multithread par tuiles (nb_threads <= 1 : calcul séquentiel)
+    // Les résultats sont identiques bit à bit quel que soit le nombre de threads
+    void DefinirNombreThreads(int nb_threads);
+    int ObtenirNombreThreads() const;
+
+    // Bathymétrie : profils de SaintVenant1D le long de x (invariants en y)
+    void DefinirFondPlat();
+    void DefinirFondPente(double x_debut, double z_fin);
+    void DefinirFondMarche(double x_marche, double z_haut);
+    void DefinirFondPentePuisPlat(double x_debut, double x_fin, double z_fin);
+    void DefinirFondDoublePente(double x_debut, double x_cassure, double z_cassure, double z_fin);
+    // Île conique de sommet z_sommet centrée en (x0, y0)
+    void DefinirFondIle(double x0, double y0, double rayon, double z_sommet);
+
+    // Conditions initiales
+    void ConditionInitialeSoliton(double A, double x_depart);          // Soliton plan se propageant vers +x
+    void ConditionInitialeDamBreak();                                   // Barrage en x = Lx/2
+    void ConditionInitialeDamBreakCirculaire(double x0, double y0, double rayon, double h_interieur, double h_exterieur);
+    void ConditionInitialeGaussienne(double amplitude, double x0, double y0, double largeur, double vitesse_init);
+    void ConditionInitialeLacAuRepos(double niveau);                    // Surface libre plane, eau immobile
+
+    // Avancer d'un pas de temps (balayage x puis y, ou y puis x)
+    void Avancer();
+
+    // Sauvegarder la solution : t x y h u v zb H, une cellule sur pas dans chaque direction
+    void Sauvegarder(int pas = 1);
+
+    // Validation
+    double CalculerMasseTotale();
+    double ObtenirSurfaceMax();
+
+    // Accesseurs
+    double ObtenirTemps() const { return _t; }
+    double ObtenirDt() const { return _dt; }
+    double ObtenirDx() const { return _dx; }
+    double ObtenirDy() const { return _dy; }
+    int ObtenirNx() const { return _Nx; }
+    int ObtenirNy() const { return _Ny; }
+    int ObtenirTailleTuile() const { return _T; }
+    double ObtenirH(int i, int j) const { return Champ(TuileDe(i, j), CHAMP_H)[Local(i, j)]; }
+    double ObtenirHu(int i, int j) const { return Champ(TuileDe(i, j), CHAMP_HU)[Local(i, j)]; }
+    double ObtenirHv(int i, int j) const { return Champ(TuileDe(i, j), CHAMP_HV)[Local(i, j)]; }
+    double ObtenirZb(int i, int j) const { return Champ(TuileDe(i, j), CHAMP_ZB)[Local(i, j)]; }
+};
+
+#endif // _SAINT_VENANT_2D_H
@@ -0,0 +1,391 @@
+#include "SaintVenantPrecision.h"
+#include "SaintVenant.h"
+#include "SommeCompensee.h"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+// ========================================
+// Noyaux, pour un type réel T
+// ========================================
+// Mêmes opérations, dans le même ordre, que FluxHLLInterface / FluxRusanovInterface,
+// SourceHydrostatique et SaintVenant1D::NettoyerCellules : avec T = double, les
+// résultats sont ceux de SaintVenant1D bit à bit. Les boucles sont sans branchement
+// (sélections) et vectorisées par le compilateur ; comme pour l'ensemble, chaque noyau
+// est compilé pour AVX-512, AVX2 et le jeu de base, et le fichier l'est sans
+// contraction FMA ni errno sur sqrt, et sans exceptions flottantes : une division
+// sélectionnée peut alors être calculée pour toutes les voies, même sans masques
+// AVX-512 (voir CMakeLists.txt).
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define SV_VERSIONS_PRECISION __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SV_VERSIONS_PRECISION
+#endif
+
+template <class T>
+static inline void FluxHLLPoint(T hl, T hul, T hr, T hur, T& flux_h, T& flux_hu, T g, T critere_h)
+{
+    const T demi_g = T(0.5) * g;
+
+    T qL = hul / (hl > T(0) ? hl : T(1));
+    T qR = hur / (hr > T(0) ? hr : T(1));
+    T uL = (hl > T(1e-8)) ? qL : T(0);
+    T uR = (hr > T(1e-8)) ? qR : T(0);
+    T cL = std::sqrt(g * hl);
+    T cR = std::sqrt(g * hr);
+
+    T a = uL - cL, b = uR - cR;
+    T S_L = (b < a) ? b : a;
+    a = uL + cL; b = uR + cR;
+    T S_R = (a < b) ? b : a;
+
+    T FL_h = hul;
+    T FR_h = hur;
+    T FL_hu = (hl > critere_h) ? hul * qL + demi_g * hl * hl : T(0);
+    T FR_hu = (hr > critere_h) ? hur * qR + demi_g * hr * hr : T(0);
+
+    T denom = S_R - S_L;
+    T fh  = (S_R * FL_h  - S_L * FR_h  + S_L * S_R * (hr - hl)) / denom;
+    T fhu = (S_R * FL_hu - S_L * FR_hu + S_L * S_R * (hur - hul)) / denom;
+
+    fh  = (S_R <= T(0)) ? FR_h  : fh;
+    fhu = (S_R <= T(0)) ? FR_hu : fhu;
+    flux_h  = (S_L >= T(0)) ? FL_h  : fh;
+    flux_hu = (S_L >= T(0)) ? FL_hu : fhu;
+}
+
+
+template <class T>
+static inline void FluxRusanovPoint(T hl, T hul, T hr, T hur, T& flux_h, T& flux_hu, T g, T critere_h)
+{
+    const T demi_g = T(0.5) * g;
+
+    bool mouilleL = hl > critere_h;
+    bool mouilleR = hr > critere_h;
+
+    T qL = hul / (hl > T(0) ? hl : T(1));
+    T qR = hur / (hr > T(0) ? hr : T(1));
+    T uL = mouilleL ? qL : T(0);
+    T uR = mouilleR ? qR : T(0);
+    T cL = mouilleL ? std::sqrt(g * hl) : T(0);
+    T cR = mouilleR ? std::sqrt(g * hr) : T(0);
+
+    T FL_hu = mouilleL ? hul * qL + demi_g * hl * hl : T(0);
+    T FR_hu = mouilleR ? hur * qR + demi_g * hr * hr : T(0);
+
+    T lambdaL = std::fabs(uL) + cL;
+    T lambdaR = std::fabs(uR) + cR;
+    T lambda = (lambdaL < lambdaR) ? lambdaR : lambdaL;
+
+    flux_h  = T(0.5) * (hul + hur) - T(0.5) * lambda * (hr - hl);
+    flux_hu = T(0.5) * (FL_hu + FR_hu) - T(0.5) * lambda * (hur - hul);
+}
+
+
+// Reconstruction hydrostatique et flux des interfaces [f_debut, f_fin] (bornes comprises),
+// rangés en k = f - f_debut
+template <class T, bool HLL>
+SV_VERSIONS_PRECISION
+static void CalculerInterfacesTuile(int f_debut, int f_fin, const T* __restrict h, const T* __restrict hu,
+                                    const T* __restrict zb, const T* __restrict z_interface, T g, T critere_h,
+                                    T* __restrict face_hG, T* __restrict face_hD,
+                                    T* __restrict flux_h, T* __restrict flux_hu)
+{
+    for (int f = f_debut; f <= f_fin; f++)
+    {
+        int k = f - f_debut;
+        T z_inter = z_interface[f];
+        T hG = std::max(T(0), h[f-1] + zb[f-1] - z_inter);
+        T hD = std::max(T(0), h[f] + zb[f] - z_inter);
+        face_hG[k] = hG;
+        face_hD[k] = hD;
+        if (HLL)
+            FluxHLLPoint<T>(hG, hu[f-1], hD, hu[f], flux_h[k], flux_hu[k], g, critere_h);
+        else
+            FluxRusanovPoint<T>(hG, hu[f-1], hD, hu[f], flux_h[k], flux_hu[k], g, critere_h);
+    }
+}
+
+
+// Mise à jour des cellules [i_debut, i_fin) à partir des interfaces de la tuile (k = i - i_debut
+// à gauche, k + 1 à droite), nettoyage des cellules sèches si nettoyer, et vitesse max |u| + c
+// de chaque cellule dans v (sur l'état nettoyé)
+template <class T>
+SV_VERSIONS_PRECISION
+static void MettreAJourTuile(int i_debut, int i_fin, const T* __restrict h, const T* __restrict hu,
+                             const T* __restrict face_hG, const T* __restrict face_hD,
+                             const T* __restrict flux_h, const T* __restrict flux_hu,
+                             T coeff, T g, T critere_h, bool nettoyer,
+                             T* __restrict h_nouveau, T* __restrict hu_nouveau, T* __restrict v)
+{
+    for (int i = i_debut; i < i_fin; i++)
+    {
+        int k = i - i_debut;
+        T h_c = h[i];
+        T TermeSource_G = T(0.5) * g * (face_hD[k] * face_hD[k] - h_c * h_c);
+        T TermeSource_D = T(0.5) * g * (face_hG[k+1] * face_hG[k+1] - h_c * h_c);
+        T Source_i = TermeSource_G + TermeSource_D;
+
+        T h_n = h[i] - coeff * (flux_h[k+1] - flux_h[k]);
+        T hu_n = hu[i] - coeff * (flux_hu[k+1] - flux_hu[k]) + coeff * Source_i;
+
+        bool sec = nettoyer & (h_n < critere_h);
+        h_n = sec ? T(0) : h_n;
+        hu_n = sec ? T(0) : hu_n;
+        h_nouveau[i] = h_n;
+        hu_nouveau[i] = hu_n;
+
+        // Mêmes résultats que CalculerVitesse : hu / h si h > critere_h, 0 sinon ; c = 0 si h <= 1e-10
+        T u = (h_n > critere_h) ? hu_n / (h_n > critere_h ? h_n : T(1)) : T(0);
+        T c = (h_n > T(1e-10)) ? std::sqrt(g * (h_n > T(1e-10) ? h_n : T(0))) : T(0);
+        v[k] = std::fabs(u) + c;
+    }
+}
+
+
+// Maximum de n valeurs positives, par voies indépendantes (vectorisable, exact)
+template <class T>
+SV_VERSIONS_PRECISION
+static T MaximumTuile(int n, const T* __restrict v)
+{
+    const int VOIES = 16;
+    T m[VOIES] = {};
+    int k = 0;
+    for (; k + VOIES <= n; k += VOIES)
+        for (int l = 0; l < VOIES; l++)
+            m[l] = (m[l] < v[k + l]) ? v[k + l] : m[l];
+    for (; k < n; k++)
+        m[0] = (m[0] < v[k]) ? v[k] : m[0];
+
+    T v_max = T(0);
+    for (int l = 0; l < VOIES; l++)
+        v_max = (v_max < m[l]) ? m[l] : v_max;
+    return v_max;
+}
+
+
+// ========================================
+// Constructeur et initialisation
+// ========================================
+
+template <class Reel>
+SaintVenantPrecision<Reel>::SaintVenantPrecision()
+    : _N(0), _L(0.0), _dx(0.0), _CFL(0.0), _t(0.0), _dt(0.0), _v_max(0.0), _v_max_valide(false),
+      _flux_hll(true), _nom_flux("hll")
+{
+}
+
+
+template <class Reel>
+bool SaintVenantPrecision<Reel>::Initialiser(const SaintVenant1D& reference, double CFL)
+{
+    const vector<double>& h = reference.ObtenirH();
+    const vector<double>& hu = reference.ObtenirHu();
+    const vector<double>& zb = reference.ObtenirZb();
+    if (h.size() < 4)
+    {
+        cout << "Erreur : " << h.size() << " cellules, il en faut au moins 4" << endl;
+        return false;
+    }
+
+    _N = (int)h.size();
+    _dx = reference.ObtenirDx();
+    _L = _N * _dx;
+    _CFL = CFL;
+    _t = 0.0;
+    _dt = 0.0;
+
+    _zb.assign(zb.begin(), zb.end());
+    _h.assign(h.begin(), h.end());
+    _hu.assign(hu.begin(), hu.end());
+    _h_nouveau.assign(_N, Reel(0));
+    _hu_nouveau.assign(_N, Reel(0));
+
+    // Fond des interfaces, calculé en double puis stocké
+    _z_interface.assign(_N + 1, Reel(0));
+    for (int f = 1; f < _N; f++)
+        _z_interface[f] = Reel(max(zb[f-1], zb[f]));
+
+    _face_hG.assign(TAILLE_TUILE + 1, Reel(0));
+    _face_hD.assign(TAILLE_TUILE + 1, Reel(0));
+    _flux_h.assign(TAILLE_TUILE + 1, Reel(0));
+    _flux_hu.assign(TAILLE_TUILE + 1, Reel(0));
+    _vitesses.assign(TAILLE_TUILE, Reel(0));
+
+    _v_max_valide = false;
+    return true;
+}
+
+
+template <class Reel>
+bool SaintVenantPrecision<Reel>::ChoisirFlux(const string& nom)
+{
+    if (nom != "hll" && nom != "rusanov")
+    {
+        cout << "Erreur : flux inconnu '" << nom << "' (rusanov, hll)" << endl;
+        return false;
+    }
+    _flux_hll = (nom == "hll");
+    _nom_flux = nom;
+    return true;
+}
+
+
+template <>
+const char* SaintVenantPrecision<double>::NomPrecision() { return "double"; }
+template <>
+const char* SaintVenantPrecision<float>::NomPrecision() { return "float"; }
+
+
+// ========================================
+// Pas de temps
+// ========================================
+
+template <class Reel>
+Reel SaintVenantPrecision<Reel>::VitesseMaximale() const
+{
+    const Reel g = Reel(_g), critere_h = Reel(critere_hauteur_deau);
+    Reel v_max = Reel(0);
+    for (int i = 0; i < _N; i++)
+    {
+        Reel h = _h[i], hu = _hu[i];
+        Reel u = (h > critere_h) ? hu / h : Reel(0);
+        Reel c = (h > Reel(1e-10)) ? std::sqrt(g * h) : Reel(0);
+        Reel v = std::fabs(u) + c;
+        v_max = (v_max < v) ? v : v_max;
+    }
+    return v_max;
+}
+
+
+template <class Reel>
+Reel SaintVenantPrecision<Reel>::AvancerCellules(int i_debut, int i_fin, Reel coeff, bool nettoyer)
+{
+    const Reel g = Reel(_g), critere_h = Reel(critere_hauteur_deau);
+
+    // Interfaces i_debut .. i_fin, puis cellules
+    if (_flux_hll)
+        CalculerInterfacesTuile<Reel, true>(i_debut, i_fin, _h.data(), _hu.data(), _zb.data(),
+                                                        _z_interface.data(), g, critere_h, _face_hG.data(),
+                                                        _face_hD.data(), _flux_h.data(), _flux_hu.data());
+    else
+        CalculerInterfacesTuile<Reel, false>(i_debut, i_fin, _h.data(), _hu.data(), _zb.data(),
+                                                         _z_interface.data(), g, critere_h, _face_hG.data(),
+                                                         _face_hD.data(), _flux_h.data(), _flux_hu.data());
+
+    MettreAJourTuile<Reel>(i_debut, i_fin, _h.data(), _hu.data(), _face_hG.data(), _face_hD.data(),
+                                       _flux_h.data(), _flux_hu.data(), coeff, g, critere_h, nettoyer,
+                                       _h_nouveau.data(), _hu_nouveau.data(), _vitesses.data());
+    return MaximumTuile<Reel>(i_fin - i_debut, _vitesses.data());
+}
+
+
+template <class Reel>
+double SaintVenantPrecision<Reel>::Avancer(double t_final)
+{
+    // Vitesse max fournie par le pas précédent quand l'état n'a pas changé depuis
+    double v_max = _v_max_valide ? _v_max : (double)VitesseMaximale();
+    _dt = (v_max > critere_vitesse) ? _CFL * _dx / v_max : 0.01;
+    if (t_final > 0.0)
+        _dt = max(0.0, min(_dt, t_final - _t));
+
+    const Reel coeff = Reel(_dt / _dx);
+    const Reel g = Reel(_g), critere_h = Reel(critere_hauteur_deau);
+
+    // 1. Cellules intérieures 1 .. N-2 par tuiles. Les cellules 1 et N-2 ne sont nettoyées
+    // qu'après les conditions aux limites, qui lisent leur valeur non nettoyée (comme SaintVenant1D)
+    Reel v_max_nouveau = Reel(0);
+    AvancerCellules(1, 2, coeff, false);
+    for (int debut = 2; debut < _N - 2; debut += TAILLE_TUILE)
+    {
+        Reel v = AvancerCellules(debut, min(_N - 2, debut + TAILLE_TUILE), coeff, true);
+        v_max_nouveau = (v_max_nouveau < v) ? v : v_max_nouveau;
+    }
+    AvancerCellules(_N - 2, _N - 1, coeff, false);
+
+    // 2. Bords (sortie libre, comme SaintVenant1D::AppliquerConditionsLimites)
+    Reel* h = _h_nouveau.data();
+    Reel* hu = _hu_nouveau.data();
+    h[0] = h[1];
+    hu[0] = hu[1];
+    Reel H_voisin = h[_N-2] + _zb[_N-2];
+    h[_N-1] = max(Reel(0), H_voisin - _zb[_N-1]);
+    hu[_N-1] = hu[_N-2];
+
+    // 3. Nettoyage et vitesse des quatre cellules restantes
+    const int bords[4] = { 0, 1, _N - 2, _N - 1 };
+    for (int i : bords)
+    {
+        if (h[i] < critere_h)
+        {
+            h[i] = Reel(0);
+            hu[i] = Reel(0);
+        }
+        Reel h_v = h[i], hu_v = hu[i];
+        Reel u = (h_v > critere_h) ? hu_v / h_v : Reel(0);
+        Reel c = (h_v > Reel(1e-10)) ? std::sqrt(g * h_v) : Reel(0);
+        Reel v = std::fabs(u) + c;
+        v_max_nouveau = (v_max_nouveau < v) ? v : v_max_nouveau;
+    }
+
+    // Echanger les tampons (pas de copie)
+    _h.swap(_h_nouveau);
+    _hu.swap(_hu_nouveau);
+    _v_max = v_max_nouveau;
+    _v_max_valide = true;
+    _t += _dt;
+    return _v_max;
+}
+
+
+// ========================================
+// Diagnostics (en double)
+// ========================================
+
+template <class Reel>
+double SaintVenantPrecision<Reel>::CalculerMasseTotale() const
+{
+    SommeCompensee volume;
+    for (int i = 0; i < _N; i++)
+        volume.Ajouter((double)_h[i]);
+    return volume.Valeur() * _dx;
+}
+
+
+template <class Reel>
+double SaintVenantPrecision<Reel>::ObtenirSurfaceMax() const
+{
+    double H_max = -99999.0;
+    for (int i = 0; i < _N; i++)
+    {
+        double H_actuel = (double)_h[i] + (double)_zb[i];
+        if (_h[i] > 1e-6 && H_actuel > H_max)
+            H_max = H_actuel;
+    }
+    return H_max;
+}
+
+
+template <class Reel>
+double SaintVenantPrecision<Reel>::ObtenirPositionCrete() const
+{
+    double H_max = -99999.0;
+    int i_max = 0;
+    for (int i = 0; i < _N; i++)
+    {
+        double H_actuel = (double)_h[i] + (double)_zb[i];
+        if (_h[i] > 1e-4 && H_actuel > H_max)
+        {
+            H_max = H_actuel;
+            i_max = i;
+        }
+    }
+    return (i_max + 0.5) * _dx;
+}
+
+
+// Précisions compilées (voir les typedef de SaintVenantPrecision.h)
+template class SaintVenantPrecision<double>;
+template class SaintVenantPrecision<float>;
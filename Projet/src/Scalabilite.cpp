@@ -0,0 +1,80 @@
+// ========================================
+// Rapport de scalabilité forte de SaintVenant1D
+// ========================================
+// Même problème (N cellules, même nombre de pas) résolu avec 1, 2, 4, ... threads.
+// Affiche les cellules mises à jour par seconde, l'accélération et l'efficacité,
+// et vérifie que la masse finale est identique bit à bit pour tous les nombres de threads.
+//
+// Usage : scalabilite [N] [nb_pas] [threads_max]
+// (à compiler en Release pour des mesures représentatives)
+
+#include "SaintVenant.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+// Temps (s) pour nb_pas pas de temps avec nb_threads, masse finale dans masse
+static double Mesurer(int N, int nb_pas, int nb_threads, double& masse)
+{
+    SaintVenant1D solveur;
+
+    // Les messages d'initialisation ne font pas partie du rapport
+    streambuf* sortie = cout.rdbuf(nullptr);
+    solveur.Initialiser(N, 75.0, 0.9, "");
+    solveur.DefinirFondPentePuisPlat(35, 50, 2);
+    solveur.ConditionInitialeSoliton(0.2, 20);
+    cout.rdbuf(sortie);
+
+    solveur.DefinirNombreThreads(nb_threads);
+
+    // Un pas de chauffe (réveil des threads, mise en cache)
+    solveur.Avancer();
+
+    auto debut = chrono::steady_clock::now();
+    for (int k = 0; k < nb_pas; k++)
+        solveur.Avancer();
+    auto fin = chrono::steady_clock::now();
+
+    masse = solveur.CalculerMasseTotale();
+    return chrono::duration<double>(fin - debut).count();
+}
+
+
+int main(int argc, char** argv)
+{
+    int N = (argc > 1) ? atoi(argv[1]) : 4000000;
+    int nb_pas = (argc > 2) ? atoi(argv[2]) : 50;
+    int threads_max = (argc > 3) ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+    if (threads_max < 1) threads_max = 1;
+
+    cout << "Scalabilite forte : N = " << N << " cellules, " << nb_pas << " pas" << endl;
+    cout << setw(8) << "threads" << setw(14) << "temps (s)" << setw(18) << "cellules/s"
+         << setw(14) << "acceleration" << setw(12) << "efficacite" << setw(18) << "masse identique" << endl;
+
+    double temps_ref = 0.0, masse_ref = 0.0;
+    for (int T = 1; ; T = (2 * T <= threads_max || T == threads_max) ? 2 * T : threads_max)
+    {
+        if (T > threads_max) break;
+
+        double masse;
+        double temps = Mesurer(N, nb_pas, T, masse);
+        if (T == 1) { temps_ref = temps; masse_ref = masse; }
+
+        double cellules_par_s = (double)N * nb_pas / temps;
+        double acceleration = temps_ref / temps;
+        cout << setw(8) << T << setw(14) << fixed << setprecision(4) << temps
+             << setw(18) << scientific << setprecision(3) << cellules_par_s
+             << setw(14) << fixed << setprecision(2) << acceleration
+             << setw(12) << acceleration / T
+             << setw(18) << (memcmp(&masse, &masse_ref, sizeof(double)) == 0 ? "oui" : "NON") << endl;
+
+        if (T == threads_max) break;
+    }
+
+    return 0;
+}
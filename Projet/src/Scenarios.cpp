@@ -0,0 +1,338 @@
+#include "Scenarios.h"
+#include "SaintVenant.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+// Formes de fond et de condition initiale reconnues, avec leur nombre de paramètres
+struct FormeConnue
+{
+    const char* nom;
+    size_t nb_parametres;
+};
+
+static const FormeConnue FONDS[] = {
+    { "plat", 0 }, { "pente", 2 }, { "marche", 2 }, { "pente_puis_plat", 3 }, { "double_pente", 4 },
+};
+
+static const FormeConnue CONDITIONS[] = {
+    { "soliton", 2 }, { "dam_break", 0 }, { "gaussienne", 4 },
+};
+
+
+template <size_t n>
+static bool VerifierForme(const FormeConnue (&formes)[n], const string& nom, size_t nb_parametres, const string& quoi)
+{
+    for (const FormeConnue& forme : formes)
+    {
+        if (nom == forme.nom)
+        {
+            if (nb_parametres == forme.nb_parametres)
+                return true;
+            cout << "Erreur : " << quoi << " '" << nom << "' attend " << forme.nb_parametres
+                 << " parametres (" << nb_parametres << " donnes)" << endl;
+            return false;
+        }
+    }
+    cout << "Erreur : " << quoi << " inconnu(e) '" << nom << "'" << endl;
+    return false;
+}
+
+
+// Valeurs d'un mot : "a,b,c", "debut:fin:pas" ou une valeur seule
+static bool DevelopperValeurs(const string& mot, vector<string>& valeurs)
+{
+    valeurs.clear();
+
+    size_t deux_points = mot.find(':');
+    if (deux_points != string::npos)
+    {
+        size_t second = mot.find(':', deux_points + 1);
+        if (second == string::npos)
+        {
+            cout << "Erreur : intervalle '" << mot << "' (attendu debut:fin:pas)" << endl;
+            return false;
+        }
+        double debut = atof(mot.substr(0, deux_points).c_str());
+        double fin = atof(mot.substr(deux_points + 1, second - deux_points - 1).c_str());
+        double pas = atof(mot.substr(second + 1).c_str());
+        if (pas <= 0.0 || fin < debut)
+        {
+            cout << "Erreur : intervalle '" << mot << "' vide" << endl;
+            return false;
+        }
+
+        // Fin comprise, à l'arrondi près
+        int nb = (int)floor((fin - debut) / pas + 1e-9) + 1;
+        for (int k = 0; k < nb; k++)
+        {
+            ostringstream valeur;
+            valeur << debut + k * pas;
+            valeurs.push_back(valeur.str());
+        }
+        return true;
+    }
+
+    stringstream flux(mot);
+    string valeur;
+    while (getline(flux, valeur, ','))
+        if (!valeur.empty())
+            valeurs.push_back(valeur);
+    return !valeurs.empty();
+}
+
+
+// Une ligne "cle = mots..." d'une section
+struct Ligne
+{
+    string cle;
+    vector<string> mots;
+};
+
+
+// Construit le scénario correspondant à un choix de valeurs pour chaque mot
+static bool ConstruireScenario(const string& nom, const vector<Ligne>& lignes,
+                               const vector<vector<vector<string> > >& valeurs, const vector<vector<int> >& choix,
+                               Scenario& scenario)
+{
+    scenario = Scenario();
+    scenario.nom = nom;
+
+    for (size_t l = 0; l < lignes.size(); l++)
+    {
+        const string& cle = lignes[l].cle;
+        vector<string> mots(lignes[l].mots.size());
+        for (size_t m = 0; m < mots.size(); m++)
+        {
+            mots[m] = valeurs[l][m][choix[l][m]];
+            if (valeurs[l][m].size() > 1)
+            {
+                if (!scenario.description.empty())
+                    scenario.description += " ";
+                scenario.description += (mots.size() > 1) ? cle + "[" + to_string(m) + "]=" + mots[m] : cle + "=" + mots[m];
+            }
+        }
+
+        if (cle == "fond" || cle == "condition")
+        {
+            vector<double> parametres;
+            for (size_t m = 1; m < mots.size(); m++)
+                parametres.push_back(atof(mots[m].c_str()));
+            if (cle == "fond")
+            {
+                scenario.fond = mots[0];
+                scenario.parametres_fond = parametres;
+            }
+            else
+            {
+                scenario.condition = mots[0];
+                scenario.parametres_condition = parametres;
+            }
+        }
+        else if (mots.size() != 1)
+        {
+            cout << "Erreur : '" << cle << "' attend une seule valeur" << endl;
+            return false;
+        }
+        else if (cle == "N")        scenario.N = atoi(mots[0].c_str());
+        else if (cle == "L")        scenario.L = atof(mots[0].c_str());
+        else if (cle == "CFL")      scenario.CFL = atof(mots[0].c_str());
+        else if (cle == "t_final")  scenario.t_final = atof(mots[0].c_str());
+        else if (cle == "schema")   scenario.schema = mots[0];
+        else if (cle == "ordre")    scenario.ordre = atoi(mots[0].c_str());
+        else if (cle == "limiteur") scenario.limiteur = mots[0];
+        else if (cle == "sortie")   scenario.sortie = mots[0];
+        else
+        {
+            cout << "Erreur : cle inconnue '" << cle << "'" << endl;
+            return false;
+        }
+    }
+
+    if (scenario.N < 3 || scenario.L <= 0.0 || scenario.CFL <= 0.0 || scenario.t_final <= 0.0)
+    {
+        cout << "Erreur : [" << nom << "] N, L, CFL ou t_final invalide" << endl;
+        return false;
+    }
+    return VerifierForme(FONDS, scenario.fond, scenario.parametres_fond.size(), "fond")
+        && VerifierForme(CONDITIONS, scenario.condition, scenario.parametres_condition.size(), "condition");
+}
+
+
+// Fichier de sortie du k-ième scénario d'une section développée : "f.txt" -> "f_k.txt"
+// (l'extension, qui choisit le format de sortie, est gardée)
+static string SortieIndicee(const string& sortie, size_t k)
+{
+    size_t point = sortie.find_last_of('.');
+    size_t barre = sortie.find_last_of('/');
+    if (point == string::npos || (barre != string::npos && point < barre))
+        point = sortie.size();
+    return sortie.substr(0, point) + "_" + to_string(k) + sortie.substr(point);
+}
+
+
+// Toutes les combinaisons de valeurs d'une section
+static bool DevelopperSection(const string& nom, const vector<Ligne>& communes, const vector<Ligne>& propres,
+                              vector<Scenario>& scenarios)
+{
+    // Les lignes de la section remplacent les lignes communes de même clé
+    vector<Ligne> lignes;
+    for (const Ligne& commune : communes)
+    {
+        bool remplacee = false;
+        for (const Ligne& ligne : propres)
+            remplacee = remplacee || ligne.cle == commune.cle;
+        if (!remplacee)
+            lignes.push_back(commune);
+    }
+    lignes.insert(lignes.end(), propres.begin(), propres.end());
+
+    vector<vector<vector<string> > > valeurs(lignes.size());
+    vector<vector<int> > choix(lignes.size());
+    for (size_t l = 0; l < lignes.size(); l++)
+    {
+        valeurs[l].resize(lignes[l].mots.size());
+        choix[l].assign(lignes[l].mots.size(), 0);
+        for (size_t m = 0; m < lignes[l].mots.size(); m++)
+        {
+            // Le nom du fond ou de la condition n'est pas développé
+            bool nom_forme = (m == 0) && (lignes[l].cle == "fond" || lignes[l].cle == "condition");
+            if (nom_forme)
+                valeurs[l][m].assign(1, lignes[l].mots[m]);
+            else if (!DevelopperValeurs(lignes[l].mots[m], valeurs[l][m]))
+                return false;
+        }
+    }
+
+    // Compteur à plusieurs chiffres : le dernier mot varie le plus vite
+    size_t premier = scenarios.size();
+    while (true)
+    {
+        Scenario scenario;
+        if (!ConstruireScenario(nom, lignes, valeurs, choix, scenario))
+            return false;
+        scenarios.push_back(scenario);
+
+        bool fini = true;
+        for (int l = (int)lignes.size() - 1; l >= 0 && fini; l--)
+        {
+            for (int m = (int)choix[l].size() - 1; m >= 0 && fini; m--)
+            {
+                if (++choix[l][m] < (int)valeurs[l][m].size())
+                    fini = false;
+                else
+                    choix[l][m] = 0;
+            }
+        }
+        if (fini)
+            break;
+    }
+
+    // Une sortie commune à plusieurs scénarios de la section : un fichier par scénario
+    if (scenarios.size() - premier > 1)
+        for (size_t k = premier; k < scenarios.size(); k++)
+            if (!scenarios[k].sortie.empty())
+                scenarios[k].sortie = SortieIndicee(scenarios[k].sortie, k - premier);
+    return true;
+}
+
+
+bool LireScenarios(const string& nom_fichier, vector<Scenario>& scenarios)
+{
+    ifstream fichier(nom_fichier);
+    if (!fichier.is_open())
+    {
+        cout << "Erreur : impossible d'ouvrir '" << nom_fichier << "'" << endl;
+        return false;
+    }
+
+    vector<Ligne> communes, propres;
+    string section;
+    bool dans_section = false;
+    string texte;
+    int numero = 0;
+
+    while (getline(fichier, texte))
+    {
+        numero++;
+        size_t diese = texte.find('#');
+        if (diese != string::npos)
+            texte.erase(diese);
+
+        stringstream flux(texte);
+        string premier;
+        if (!(flux >> premier))
+            continue;
+
+        // Nouvelle section : on développe la précédente
+        if (premier[0] == '[')
+        {
+            if (dans_section && !DevelopperSection(section, communes, propres, scenarios))
+                return false;
+            size_t fin = texte.find(']');
+            size_t debut = texte.find('[');
+            section = (fin == string::npos) ? premier.substr(1) : texte.substr(debut + 1, fin - debut - 1);
+            propres.clear();
+            dans_section = true;
+            continue;
+        }
+
+        size_t egal = texte.find('=');
+        if (egal == string::npos)
+        {
+            cout << "Erreur : " << nom_fichier << ":" << numero << " : ligne sans '='" << endl;
+            return false;
+        }
+
+        Ligne ligne;
+        stringstream cle(texte.substr(0, egal));
+        cle >> ligne.cle;
+        stringstream mots(texte.substr(egal + 1));
+        string mot;
+        while (mots >> mot)
+            ligne.mots.push_back(mot);
+        if (ligne.mots.empty())
+        {
+            cout << "Erreur : " << nom_fichier << ":" << numero << " : '" << ligne.cle << "' sans valeur" << endl;
+            return false;
+        }
+
+        (dans_section ? propres : communes).push_back(ligne);
+    }
+
+    // Dernière section (ou fichier sans section : un seul groupe de scénarios)
+    return DevelopperSection(dans_section ? section : "scenario", communes, propres, scenarios);
+}
+
+
+bool PreparerSolveur(const Scenario& scenario, SaintVenant1D& solveur)
+{
+    if (!VerifierForme(FONDS, scenario.fond, scenario.parametres_fond.size(), "fond")
+        || !VerifierForme(CONDITIONS, scenario.condition, scenario.parametres_condition.size(), "condition"))
+        return false;
+
+    solveur.Initialiser(scenario.N, scenario.L, scenario.CFL, scenario.sortie);
+    if (!solveur.ChoisirSchema(scenario.schema))
+        return false;
+    if (scenario.ordre != 1 && !solveur.ChoisirOrdre(scenario.ordre, scenario.limiteur))
+        return false;
+
+    // Bathymétrie
+    const vector<double>& f = scenario.parametres_fond;
+    if (scenario.fond == "plat")                 solveur.DefinirFondPlat();
+    else if (scenario.fond == "pente")           solveur.DefinirFondPente(f[0], f[1]);
+    else if (scenario.fond == "marche")          solveur.DefinirFondMarche(f[0], f[1]);
+    else if (scenario.fond == "pente_puis_plat") solveur.DefinirFondPentePuisPlat(f[0], f[1], f[2]);
+    else                                         solveur.DefinirFondDoublePente(f[0], f[1], f[2], f[3]);
+
+    // Eau
+    const vector<double>& c = scenario.parametres_condition;
+    if (scenario.condition == "soliton")         solveur.ConditionInitialeSoliton(c[0], c[1]);
+    else if (scenario.condition == "dam_break")  solveur.ConditionInitialeDamBreak();
+    else                                         solveur.ConditionInitialeGaussienne(c[0], c[1], c[2], c[3]);
+    return true;
+}
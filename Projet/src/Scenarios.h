@@ -0,0 +1,62 @@
+#ifndef _SCENARIOS_H
+#define _SCENARIOS_H
+
+#include <vector>
+#include <string>
+
+class SaintVenant1D;
+
+// ========================================
+// Fichiers de scénarios
+// ========================================
+// Un fichier décrit une ou plusieurs simulations SaintVenant1D sans recompiler :
+//
+//   # Valeurs communes (avant la première section)
+//   L = 75
+//   CFL = 0.9
+//
+//   [soliton_double_pente]
+//   fond = double_pente 15 30 1.8 2.2
+//   condition = soliton 0.1:0.5:0.1 8,12
+//   N = 500,1000
+//   t_final = 6
+//
+// Clés : N, L, CFL, t_final, schema (comme ChoisirSchema), ordre (1 ou 2),
+// limiteur, sortie (fichier de la solution finale, rien par défaut),
+//   fond = plat | pente x_debut z_fin | marche x_marche z_haut
+//        | pente_puis_plat x_debut x_fin z_fin
+//        | double_pente x_debut x_cassure z_cassure z_fin
+//   condition = soliton A x_depart | dam_break | gaussienne A x largeur vitesse
+// Chaque valeur peut être une liste "a,b,c" ou un intervalle "debut:fin:pas"
+// (fin comprise) : une section donne une simulation par combinaison de valeurs.
+// Si une section donne plusieurs simulations, leur sortie est indicée dans l'ordre
+// de développement : "sortie = f.txt" écrit f_0.txt, f_1.txt...
+struct Scenario
+{
+    std::string nom;          // Nom de la section
+    std::string description;  // Valeurs des paramètres balayés, ex. "condition[1]=0.3 N=1000"
+
+    int N = 1100;
+    double L = 75.0;
+    double CFL = 0.9;
+    double t_final = 10.0;
+    std::string schema = "hll/hydrostatique";
+    int ordre = 1;
+    std::string limiteur = "minmod";
+    std::string sortie;
+
+    std::string fond = "plat";
+    std::vector<double> parametres_fond;
+    std::string condition = "soliton";
+    std::vector<double> parametres_condition;
+};
+
+// Lit le fichier et développe les grilles de paramètres (les scénarios sont ajoutés
+// à la fin de scenarios). Retourne false si le fichier est illisible ou invalide.
+bool LireScenarios(const std::string& nom_fichier, std::vector<Scenario>& scenarios);
+
+// Initialise le solveur (grille, schéma, fond, condition initiale) selon le scénario
+// Retourne false si le fond ou la condition est inconnu
+bool PreparerSolveur(const Scenario& scenario, SaintVenant1D& solveur);
+
+#endif // _SCENARIOS_H
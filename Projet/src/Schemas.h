@@ -0,0 +1,233 @@
+#ifndef _SCHEMAS_H
+#define _SCHEMAS_H
+
+#include "FluxVectorise.h"
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+// ========================================
+// Politiques de schéma pour SaintVenant1D
+// ========================================
+// La boucle du pas de temps est un template sur une politique de FLUX et une
+// politique de SOURCE : chaque combinaison est compilée séparément et tout est
+// mis en ligne dans la boucle, sans appel indirect par interface.
+//
+// Politique de flux :
+//   Calculer(...) : flux d'une interface
+//   Lot(...)      : flux d'un lot d'interfaces contiguës
+// Politique de source (le fond est lu dans les tables de GeometrieFond) :
+//   Reconstruire(...) : hauteurs de part et d'autre de l'interface f (entre f-1 et f)
+//   Source(...)       : terme source de la cellule i, multiplié par dx
+//   SourceFace(...)   : le même terme découpé par interface : part de l'interface f
+//                       dans la source de la cellule f-1 (S_G) et de la cellule f (S_D)
+//                       (la source de la cellule i est S_D de f = i plus S_G de f = i+1)
+
+
+// ========================================
+// Géométrie du fond
+// ========================================
+// Le fond ne change pas pendant le calcul : ce qui n'en dépend que par interface est
+// calculé une fois quand il est défini (voir ConstruireGeometrieFond), et la boucle
+// du pas de temps lit ces tables au lieu de le recalculer à chaque pas.
+// Tableaux de N + 1 valeurs pour N cellules, l'interface f est entre f-1 et f.
+struct GeometrieFond
+{
+    const double* zb;            // Fond des cellules (N valeurs)
+    const double* z_interface;   // max(zb[f-1], zb[f]) : fond de la reconstruction hydrostatique
+    const double* saut_zb;       // zb[f] - zb[f-1]
+};
+
+// Remplit z_interface et saut_zb (N + 1 valeurs, interfaces 0 et N à zéro) à partir de zb
+inline void ConstruireGeometrieFond(int N, const double* zb, double* z_interface, double* saut_zb)
+{
+    z_interface[0] = z_interface[N] = 0.0;
+    saut_zb[0] = saut_zb[N] = 0.0;
+    for (int f = 1; f < N; f++)
+    {
+        z_interface[f] = std::max(zb[f-1], zb[f]);
+        saut_zb[f] = zb[f] - zb[f-1];
+    }
+}
+
+
+// ========================================
+// Flux de Rusanov
+// ========================================
+struct FluxPolitiqueRusanov
+{
+    static const char* Nom() { return "rusanov"; }
+
+    static inline void Calculer(double hL, double huL, double hR, double huR,
+                                double& flux_h, double& flux_hu, double g, double critere_h)
+    {
+        FluxRusanovInterface(hL, huL, hR, huR, flux_h, flux_hu, g, critere_h);
+    }
+
+    static inline void Lot(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                           double* flux_h, double* flux_hu, double g, double critere_h)
+    {
+        FluxRusanovLot(n, hL, huL, hR, huR, flux_h, flux_hu, g, critere_h);
+    }
+};
+
+
+// ========================================
+// Flux HLL
+// ========================================
+struct FluxPolitiqueHLL
+{
+    static const char* Nom() { return "hll"; }
+
+    static inline void Calculer(double hL, double huL, double hR, double huR,
+                                double& flux_h, double& flux_hu, double g, double critere_h)
+    {
+        FluxHLLInterface(hL, huL, hR, huR, flux_h, flux_hu, g, critere_h);
+    }
+
+    static inline void Lot(int n, const double* hL, const double* huL, const double* hR, const double* huR,
+                           double* flux_h, double* flux_hu, double g, double critere_h)
+    {
+        FluxHLLLot(n, hL, huL, hR, huR, flux_h, flux_hu, g, critere_h);
+    }
+};
+
+
+// ========================================
+// "hllc" : alias de HLL
+// ========================================
+// L'onde de contact de HLLC (Toro) ne sert qu'à transporter un scalaire passif
+// à travers le contact. Il n'y en a pas ici : en 1D, la vitesse du contact est
+// celle de l'état intermédiaire HLL, et en 2D hv est décentré selon le signe du
+// flux de masse ; les flux de h et hu de HLLC seraient ceux de HLL aux arrondis
+// près. Le nom reste accepté pour les configurations existantes et désigne HLL
+// (les noms de schéma et de flux retournés sont alors "hll").
+inline std::string NomFluxEffectif(const std::string& nom)
+{
+    return (nom == "hllc") ? FluxPolitiqueHLL::Nom() : nom;
+}
+
+
+// ========================================
+// Source : reconstruction hydrostatique (équilibre du lac au repos)
+// ========================================
+struct SourceHydrostatique
+{
+    static const char* Nom() { return "hydrostatique"; }
+
+    static inline void Reconstruire(const double* h, const GeometrieFond& fond, int f, double& h_L, double& h_R)
+    {
+        // On prend le "plus haut" fond à l'interface (précalculé)
+        double z_inter = fond.z_interface[f];
+
+        h_L = std::max(0.0, h[f-1] + fond.zb[f-1] - z_inter); // Gauche de l'interface
+        h_R = std::max(0.0, h[f] + fond.zb[f] - z_inter);     // Droite de l'interface
+    }
+
+    // Même reconstruction à partir des deux cellules voisines (utilisée aussi en 2D)
+    static inline void ReconstruirePoint(double h_gauche, double zb_gauche, double h_droite, double zb_droite,
+                                         double& h_L, double& h_R)
+    {
+        // On prend le "plus haut" fond à l'interface
+        double z_inter = std::max(zb_gauche, zb_droite);
+
+        h_L = std::max(0.0, h_gauche + zb_gauche - z_inter); // Gauche de l'interface
+        h_R = std::max(0.0, h_droite + zb_droite - z_inter); // Droite de l'interface
+    }
+
+    static inline double Source(const double* h, const GeometrieFond& /*fond*/, const double* face_hG,
+                                const double* face_hD, int i, double g)
+    {
+        // Interface GAUCHE = f = i, interface DROITE = f = i+1
+        double TermeSource_G = 0.5 * g * (std::pow(face_hD[i], 2) - std::pow(h[i], 2));
+        double TermeSource_D = 0.5 * g * (std::pow(face_hG[i+1], 2) - std::pow(h[i], 2));
+
+        // Somme des sources (c'est un terme de force, pas un flux)
+        return TermeSource_G + TermeSource_D;
+    }
+
+    static inline void SourceFace(const double* h, const GeometrieFond& /*fond*/, double h_G, double h_D, int f,
+                                  double g, double& S_G, double& S_D)
+    {
+        S_G = 0.5 * g * (std::pow(h_G, 2) - std::pow(h[f-1], 2));
+        S_D = 0.5 * g * (std::pow(h_D, 2) - std::pow(h[f], 2));
+    }
+};
+
+
+// ========================================
+// Source : pente centrée -g h dzb/dx, sans reconstruction
+// ========================================
+// Schéma naïf, non équilibré : le lac au repos sur fond variable se met en mouvement.
+// Sert de référence pour mesurer l'apport de la reconstruction hydrostatique.
+struct SourcePenteCentree
+{
+    static const char* Nom() { return "pente"; }
+
+    static inline void Reconstruire(const double* h, const GeometrieFond& /*fond*/, int f, double& h_L, double& h_R)
+    {
+        h_L = h[f-1];
+        h_R = h[f];
+    }
+
+    static inline double Source(const double* h, const GeometrieFond& fond, const double* /*face_hG*/,
+                                const double* /*face_hD*/, int i, double g)
+    {
+        // -g h (zb[i+1] - zb[i-1]) / (2 dx), multiplié par dx
+        return -0.5 * g * h[i] * (fond.zb[i+1] - fond.zb[i-1]);
+    }
+
+    static inline void SourceFace(const double* h, const GeometrieFond& fond, double /*h_G*/, double /*h_D*/, int f,
+                                  double g, double& S_G, double& S_D)
+    {
+        S_G = -0.5 * g * h[f-1] * fond.saut_zb[f];
+        S_D = -0.5 * g * h[f] * fond.saut_zb[f];
+    }
+};
+
+// ========================================
+// Limiteurs de pente pour l'ordre 2 (MUSCL)
+// ========================================
+// Pente(dm, dp) : pente limitée (non divisée par dx) à partir des différences
+// à gauche dm = q[i] - q[i-1] et à droite dp = q[i+1] - q[i].
+// Les trois limiteurs sont TVD : les valeurs reconstruites q[i] +- pente/2
+// restent entre les valeurs des cellules voisines (donc h reste positif).
+
+struct LimiteurMinmod
+{
+    static const char* Nom() { return "minmod"; }
+
+    static inline double Pente(double dm, double dp)
+    {
+        if (dm * dp <= 0.0) return 0.0;
+        return (dm > 0.0) ? std::min(dm, dp) : std::max(dm, dp);
+    }
+};
+
+
+struct LimiteurVanLeer
+{
+    static const char* Nom() { return "vanleer"; }
+
+    static inline double Pente(double dm, double dp)
+    {
+        if (dm * dp <= 0.0) return 0.0;
+        return 2.0 * dm * dp / (dm + dp);
+    }
+};
+
+
+// Monotonized Central
+struct LimiteurMC
+{
+    static const char* Nom() { return "mc"; }
+
+    static inline double Pente(double dm, double dp)
+    {
+        if (dm * dp <= 0.0) return 0.0;
+        double pente = std::min(std::min(2.0 * std::fabs(dm), 2.0 * std::fabs(dp)), 0.5 * std::fabs(dm + dp));
+        return (dm > 0.0) ? pente : -pente;
+    }
+};
+
+#endif // _SCHEMAS_H
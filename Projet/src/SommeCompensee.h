@@ -0,0 +1,40 @@
+#ifndef _SOMME_COMPENSEE_H
+#define _SOMME_COMPENSEE_H
+
+#include <cmath>
+
+// ========================================
+// Somme compensée de Neumaier (Kahan amélioré)
+// ========================================
+// Garde l'erreur d'arrondi de chaque addition dans un terme de compensation :
+// l'erreur de la somme ne croît plus avec le nombre de termes (précision de
+// l'ordre de l'epsilon machine, quel que soit N), ce qui permet de suivre la
+// conservation de la masse à 1e-15 près même sur de très grandes grilles.
+// Le fichier qui l'utilise ne doit pas être compilé avec -ffast-math.
+struct SommeCompensee
+{
+    double somme = 0.0;
+    double compensation = 0.0;
+
+    inline void Ajouter(double x)
+    {
+        // Sélection sans branchement : le plus grand des deux termes en premier
+        double t = somme + x;
+        bool somme_plus_grande = std::fabs(somme) >= std::fabs(x);
+        double grand = somme_plus_grande ? somme : x;
+        double petit = somme_plus_grande ? x : somme;
+        compensation += (grand - t) + petit;
+        somme = t;
+    }
+
+    // Ajoute une autre somme partielle (somme et compensation)
+    inline void Ajouter(const SommeCompensee& autre)
+    {
+        Ajouter(autre.somme);
+        compensation += autre.compensation;
+    }
+
+    inline double Valeur() const { return somme + compensation; }
+};
+
+#endif // _SOMME_COMPENSEE_H
@@ -0,0 +1,229 @@
+#include "SortieBinaire.h"
+#include <iostream>
+#include <cstring>
+#include <sys/types.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const char SIGNATURE[8] = { 'S', 'V', 'S', 'O', 'R', 'T', 'I', 'E' };
+static const char SIGNATURE_INDEX[8] = { 'S', 'V', 'I', 'N', 'D', 'E', 'X', '\0' };
+static const uint32_t VERSION_SORTIE = 1;
+static const uint32_t MARQUEUR_BOUTISME = 0x01020304;
+
+// En-tête du format (64 octets)
+struct EnteteSortie
+{
+    char signature[8];
+    uint32_t version;
+    uint32_t marqueur;
+    uint32_t octets_par_valeur;
+    uint32_t reserve;
+    uint64_t N;
+    double dx;
+    uint64_t debut_trames;
+    uint64_t taille_trame;
+    uint64_t reserve2;
+};
+
+// Fin de fichier après l'index des temps
+struct PiedIndex
+{
+    char signature[8];
+    uint64_t nb;
+};
+
+
+bool EstSortieBinaire(const string& nom_fichier)
+{
+    return nom_fichier.size() >= 4 && nom_fichier.compare(nom_fichier.size() - 4, 4, ".svb") == 0;
+}
+
+
+SortieBinaire::SortieBinaire()
+    : _fichier(nullptr), _entete_ecrite(false), _N(0), _debut_trames(0), _taille_trame(0)
+{
+}
+
+
+SortieBinaire::~SortieBinaire()
+{
+    Fermer();
+}
+
+
+bool SortieBinaire::Ouvrir(const string& nom_fichier, bool reprendre, double t_max)
+{
+    Fermer();
+    _nom = nom_fichier;
+    _entete_ecrite = false;
+    _temps.clear();
+
+    if (reprendre)
+    {
+        _fichier = fopen(nom_fichier.c_str(), "r+b");
+        if (_fichier)
+            return Reprendre(t_max);
+    }
+
+    _fichier = fopen(nom_fichier.c_str(), "wb");
+    if (!_fichier)
+    {
+        cout << "Erreur : impossible d'ecrire '" << nom_fichier << "'" << endl;
+        return false;
+    }
+    return true;
+}
+
+
+// Relit l'en-tête et les temps d'une sortie existante, puis la tronque après la
+// dernière trame de temps <= t_max
+bool SortieBinaire::Reprendre(double t_max)
+{
+    fseeko(_fichier, 0, SEEK_END);
+    uint64_t taille = (uint64_t)ftello(_fichier);
+    if (taille == 0)
+        return true;   // Fichier vide : l'en-tête sera écrit à la première trame
+
+    EnteteSortie entete;
+    rewind(_fichier);
+    string erreur;
+    if (taille < sizeof(entete) || fread(&entete, sizeof(entete), 1, _fichier) != 1
+        || memcmp(entete.signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+        erreur = "n'est pas une sortie binaire";
+    else if (entete.marqueur != MARQUEUR_BOUTISME)
+        erreur = "écrit sur une machine d'un autre boutisme";
+    else if (entete.version != VERSION_SORTIE)
+        erreur = "version " + to_string(entete.version) + " inconnue";
+    else if (entete.octets_par_valeur != sizeof(float) || entete.N == 0
+             || entete.taille_trame != sizeof(double) + 2 * entete.N * sizeof(float)
+             || entete.debut_trames > taille)
+        erreur = "en-tête incohérent";
+    if (!erreur.empty())
+    {
+        cout << "Erreur : sortie '" << _nom << "' " << erreur << endl;
+        fclose(_fichier);
+        _fichier = nullptr;
+        return false;
+    }
+    _N = (int)entete.N;
+    _debut_trames = entete.debut_trames;
+    _taille_trame = entete.taille_trame;
+    _entete_ecrite = true;
+
+    // Nombre de trames : donné par l'index s'il est complet, sinon par la taille
+    uint64_t nb = (taille - _debut_trames) / _taille_trame;
+    PiedIndex pied;
+    if (taille >= _debut_trames + sizeof(pied))
+    {
+        fseeko(_fichier, (off_t)(taille - sizeof(pied)), SEEK_SET);
+        if (fread(&pied, sizeof(pied), 1, _fichier) == 1
+            && memcmp(pied.signature, SIGNATURE_INDEX, sizeof(SIGNATURE_INDEX)) == 0
+            && _debut_trames + pied.nb * (_taille_trame + sizeof(double)) + sizeof(pied) == taille)
+            nb = pied.nb;
+    }
+
+    // Trames conservées : temps croissants jusqu'à t_max
+    for (uint64_t k = 0; k < nb; k++)
+    {
+        double t;
+        fseeko(_fichier, (off_t)(_debut_trames + k * _taille_trame), SEEK_SET);
+        if (fread(&t, sizeof(t), 1, _fichier) != 1 || !(t <= t_max))
+            break;
+        _temps.push_back(t);
+    }
+
+    uint64_t fin = _debut_trames + _temps.size() * _taille_trame;
+    fflush(_fichier);
+    if (ftruncate(fileno(_fichier), (off_t)fin) != 0 || fseeko(_fichier, (off_t)fin, SEEK_SET) != 0)
+    {
+        cout << "Erreur : impossible de tronquer '" << _nom << "'" << endl;
+        fclose(_fichier);
+        _fichier = nullptr;
+        return false;
+    }
+    return true;
+}
+
+
+bool SortieBinaire::EcrireEntete(int N, double dx, const double* zb)
+{
+    EnteteSortie entete;
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.signature, SIGNATURE, sizeof(SIGNATURE));
+    entete.version = VERSION_SORTIE;
+    entete.marqueur = MARQUEUR_BOUTISME;
+    entete.octets_par_valeur = sizeof(float);
+    entete.N = (uint64_t)N;
+    entete.dx = dx;
+    entete.debut_trames = sizeof(entete) + 2 * (uint64_t)N * sizeof(double);
+    entete.taille_trame = sizeof(double) + 2 * (uint64_t)N * sizeof(float);
+
+    vector<double> x(N);
+    for (int i = 0; i < N; i++)
+        x[i] = (i + 0.5) * dx;
+
+    bool ok = fwrite(&entete, sizeof(entete), 1, _fichier) == 1
+           && fwrite(x.data(), sizeof(double), N, _fichier) == (size_t)N
+           && fwrite(zb, sizeof(double), N, _fichier) == (size_t)N;
+    _N = N;
+    _debut_trames = entete.debut_trames;
+    _taille_trame = entete.taille_trame;
+    _entete_ecrite = true;
+    return ok;
+}
+
+
+bool SortieBinaire::EcrireTrame(double t, int N, double dx, const double* zb, const double* h, const double* hu)
+{
+    if (!_fichier)
+        return false;
+    if (!_entete_ecrite && !EcrireEntete(N, dx, zb))
+    {
+        cout << "Erreur : ecriture incomplete de '" << _nom << "'" << endl;
+        return false;
+    }
+    if (N != _N)
+    {
+        cout << "Erreur : sortie '" << _nom << "' de " << _N << " cellules, trame de " << N << " ignoree" << endl;
+        return false;
+    }
+
+    _trame.resize(2 * (size_t)N);
+    float* trame = _trame.data();
+    for (int i = 0; i < N; i++)
+    {
+        trame[i] = (float)h[i];
+        trame[N + i] = (float)hu[i];
+    }
+    if (fwrite(&t, sizeof(t), 1, _fichier) != 1 || fwrite(trame, sizeof(float), _trame.size(), _fichier) != _trame.size())
+    {
+        cout << "Erreur : ecriture incomplete de '" << _nom << "'" << endl;
+        return false;
+    }
+    _temps.push_back(t);
+    return true;
+}
+
+
+bool SortieBinaire::Fermer()
+{
+    if (!_fichier)
+        return true;
+
+    bool ok = true;
+    if (_entete_ecrite)
+    {
+        PiedIndex pied;
+        memcpy(pied.signature, SIGNATURE_INDEX, sizeof(SIGNATURE_INDEX));
+        pied.nb = _temps.size();
+        ok = fwrite(_temps.data(), sizeof(double), _temps.size(), _fichier) == _temps.size()
+          && fwrite(&pied, sizeof(pied), 1, _fichier) == 1;
+    }
+    ok = (fclose(_fichier) == 0) && ok;
+    _fichier = nullptr;
+
+    if (!ok)
+        cout << "Erreur : ecriture incomplete de '" << _nom << "'" << endl;
+    return ok;
+}
@@ -0,0 +1,67 @@
+#ifndef _SORTIE_BINAIRE_H
+#define _SORTIE_BINAIRE_H
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+
+// ========================================
+// Sortie binaire en colonnes des sauvegardes
+// ========================================
+// Alternative au fichier texte de Sauvegarder (choisie par l'extension .svb) : les
+// grandeurs constantes sont écrites une seule fois, chaque sauvegarde est une trame
+// de taille fixe, et un index des temps termine le fichier. Une trame se lit donc en
+// O(1) (np.memmap, voir solution_binaire.py).
+//
+// Format (version 1), nombres dans l'ordre d'octets de la machine :
+//   en-tête de 64 octets :
+//     "SVSORTIE" (8 octets), uint32 version, uint32 marqueur 0x01020304 (ordre des octets)
+//     uint32 octets par valeur des trames (4 : float), uint32 réservé (0)
+//     uint64 N, double dx, uint64 début des trames, uint64 taille d'une trame, uint64 réservé
+//   x (N doubles, centres des cellules), zb (N doubles, fond de la première sauvegarde)
+//   trames, à partir du début des trames : double t, N floats h, N floats hu
+//   index : nb doubles t (un par trame), puis "SVINDEX" + '\0' et uint64 nb
+// L'index est écrit à la fermeture. Sans lui (calcul interrompu), le nombre de trames
+// se déduit de la taille du fichier et les temps se lisent dans les trames.
+
+class SortieBinaire
+{
+private:
+    FILE* _fichier;
+    std::string _nom;
+    bool _entete_ecrite;
+    int _N;
+    uint64_t _debut_trames;
+    uint64_t _taille_trame;
+    std::vector<float> _trame;    // h puis hu convertis en float
+    std::vector<double> _temps;   // Temps des trames écrites, pour l'index
+
+    bool EcrireEntete(int N, double dx, const double* zb);
+    bool Reprendre(double t_max);
+
+public:
+    SortieBinaire();
+    ~SortieBinaire();
+    SortieBinaire(const SortieBinaire&) = delete;
+    SortieBinaire& operator=(const SortieBinaire&) = delete;
+
+    // Crée le fichier. Avec reprendre, un fichier existant est conservé : son index
+    // est retiré, les trames de temps > t_max (écrites après le point de reprise) sont
+    // supprimées et les suivantes sont ajoutées à la fin. Retourne false (avec un
+    // message) si le fichier ne peut pas être ouvert ou n'est pas une sortie valide.
+    bool Ouvrir(const std::string& nom_fichier, bool reprendre = false, double t_max = 0.0);
+
+    // Ajoute l'état au temps t ; l'en-tête (N, dx, x, zb) est écrit à la première trame
+    bool EcrireTrame(double t, int N, double dx, const double* zb, const double* h, const double* hu);
+
+    // Ecrit l'index et ferme le fichier (appelé aussi par le destructeur)
+    bool Fermer();
+
+    long NombreTrames() const { return (long)_temps.size(); }
+};
+
+// Le nom désigne-t-il une sortie binaire (extension .svb) ?
+bool EstSortieBinaire(const std::string& nom_fichier);
+
+#endif // _SORTIE_BINAIRE_H
@@ -0,0 +1,691 @@
+#include "SortieCompressee.h"
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <queue>
+#include <sys/types.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const char SIGNATURE[8] = { 'S', 'V', 'C', 'O', 'M', 'P', 'R', 'E' };
+static const uint32_t VERSION_COMPRESSEE = 1;
+static const uint32_t MARQUEUR_BOUTISME = 0x01020304;
+
+static const int NB_CLASSES = 96;
+static const int PREMIERE_CLASSE_SERIE = 64;   // Classes 64..95 : séries de zéros
+static const int LONGUEUR_CODE_MAX = 15;
+static const size_t TAILLE_ENTETE_TRAME = sizeof(double) + 1 + sizeof(uint32_t);
+
+// En-tête du format (56 octets)
+struct EnteteCompressee
+{
+    char signature[8];
+    uint32_t version;
+    uint32_t marqueur;
+    uint64_t N;
+    double dx;
+    double tolerance_h;
+    double tolerance_u;
+    uint32_t intervalle_cle;
+    uint32_t reserve;
+};
+
+
+bool EstSortieCompressee(const string& nom_fichier)
+{
+    return nom_fichier.size() >= 4 && nom_fichier.compare(nom_fichier.size() - 4, 4, ".svz") == 0;
+}
+
+
+// ========================================
+// Quantification
+// ========================================
+static inline int64_t Quantifier(double v, double tolerance)
+{
+    if (tolerance > 0.0)
+        return llround(v / (2.0 * tolerance));
+    // Sans perte : bits du float
+    float f = (float)v;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return (int64_t)bits;
+}
+
+
+static inline double Reconstruire(int64_t q, double tolerance)
+{
+    if (tolerance > 0.0)
+        return (double)q * (2.0 * tolerance);
+    uint32_t bits = (uint32_t)q;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+
+static inline int NombreBits(uint64_t v)
+{
+    return 64 - __builtin_clzll(v);   // v > 0
+}
+
+
+// ========================================
+// Bits, poids fort en premier
+// ========================================
+struct EcrivainBits
+{
+    vector<uint8_t>& octets;
+    uint64_t accumulateur;
+    int nb_bits;
+
+    explicit EcrivainBits(vector<uint8_t>& o) : octets(o), accumulateur(0), nb_bits(0) {}
+
+    void Ecrire(uint64_t valeur, int n)
+    {
+        if (n > 32)
+        {
+            Ecrire(valeur >> 32, n - 32);
+            n = 32;
+        }
+        if (n == 0)
+            return;
+        accumulateur = (accumulateur << n) | (valeur & ((1ULL << n) - 1));
+        nb_bits += n;
+        while (nb_bits >= 8)
+        {
+            nb_bits -= 8;
+            octets.push_back((uint8_t)(accumulateur >> nb_bits));
+        }
+        accumulateur &= (1ULL << nb_bits) - 1;
+    }
+
+    void Terminer()
+    {
+        if (nb_bits > 0)
+            octets.push_back((uint8_t)(accumulateur << (8 - nb_bits)));
+        accumulateur = 0;
+        nb_bits = 0;
+    }
+};
+
+
+struct LecteurBits
+{
+    const uint8_t* octets;
+    size_t nb_octets;
+    size_t position;   // En bits
+    bool depasse;
+
+    LecteurBits(const uint8_t* o, size_t n) : octets(o), nb_octets(n), position(0), depasse(false) {}
+
+    inline int LireBit()
+    {
+        if (position >= 8 * nb_octets)
+        {
+            depasse = true;
+            return 0;
+        }
+        int bit = (octets[position >> 3] >> (7 - (position & 7))) & 1;
+        position++;
+        return bit;
+    }
+
+    uint64_t Lire(int n)
+    {
+        uint64_t valeur = 0;
+        for (int k = 0; k < n; k++)
+            valeur = (valeur << 1) | (uint64_t)LireBit();
+        return valeur;
+    }
+};
+
+
+// ========================================
+// Huffman canonique
+// ========================================
+// Longueurs de code des classes de fréquence non nulle, limitées à LONGUEUR_CODE_MAX :
+// si l'arbre est trop profond, les fréquences sont divisées par deux et l'arbre refait
+static void LongueursHuffman(const uint64_t* frequences, uint8_t* longueurs)
+{
+    vector<uint64_t> f(frequences, frequences + NB_CLASSES);
+    typedef pair<uint64_t, int> Noeud;
+    for (;;)
+    {
+        priority_queue<Noeud, vector<Noeud>, greater<Noeud> > file;
+        vector<int> parent(2 * NB_CLASSES, -1);
+        for (int s = 0; s < NB_CLASSES; s++)
+        {
+            longueurs[s] = 0;
+            if (f[s] > 0)
+                file.push(Noeud(f[s], s));
+        }
+        if (file.size() == 1)
+        {
+            longueurs[file.top().second] = 1;
+            return;
+        }
+
+        int suivant = NB_CLASSES;
+        while (file.size() > 1)
+        {
+            Noeud a = file.top(); file.pop();
+            Noeud b = file.top(); file.pop();
+            parent[a.second] = parent[b.second] = suivant;
+            file.push(Noeud(a.first + b.first, suivant++));
+        }
+
+        int longueur_max = 0;
+        for (int s = 0; s < NB_CLASSES; s++)
+        {
+            if (f[s] == 0)
+                continue;
+            int profondeur = 0;
+            for (int n = s; parent[n] >= 0; n = parent[n])
+                profondeur++;
+            longueurs[s] = (uint8_t)profondeur;
+            longueur_max = max(longueur_max, profondeur);
+        }
+        if (longueur_max <= LONGUEUR_CODE_MAX)
+            return;
+        for (int s = 0; s < NB_CLASSES; s++)
+            if (f[s] > 0)
+                f[s] = (f[s] + 1) / 2;
+    }
+}
+
+
+// Codes canoniques : classes rangées par (longueur, classe), codes consécutifs
+static void CodesCanoniques(const uint8_t* longueurs, uint32_t* codes)
+{
+    uint32_t code = 0;
+    for (int l = 1; l <= LONGUEUR_CODE_MAX; l++)
+    {
+        for (int s = 0; s < NB_CLASSES; s++)
+            if (longueurs[s] == l)
+                codes[s] = code++;
+        code <<= 1;
+    }
+}
+
+
+// Décodeur canonique (nombre de codes par longueur et classes rangées)
+struct DecodeurHuffman
+{
+    int nb_par_longueur[LONGUEUR_CODE_MAX + 1];
+    int classes[NB_CLASSES];
+
+    void Construire(const uint8_t* longueurs)
+    {
+        memset(nb_par_longueur, 0, sizeof(nb_par_longueur));
+        int k = 0;
+        for (int l = 1; l <= LONGUEUR_CODE_MAX; l++)
+            for (int s = 0; s < NB_CLASSES; s++)
+                if (longueurs[s] == l)
+                {
+                    classes[k++] = s;
+                    nb_par_longueur[l]++;
+                }
+    }
+
+    // -1 si aucun code ne correspond
+    int Decoder(LecteurBits& bits) const
+    {
+        int code = 0, premier = 0, indice = 0;
+        for (int l = 1; l <= LONGUEUR_CODE_MAX; l++)
+        {
+            code |= bits.LireBit();
+            int nb = nb_par_longueur[l];
+            if (code - premier < nb)
+                return classes[indice + code - premier];
+            indice += nb;
+            premier = (premier + nb) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+};
+
+
+// ========================================
+// Codage d'un champ : jetons, table de Huffman, bits
+// ========================================
+struct Jeton
+{
+    uint8_t classe;
+    uint8_t nb_bits_bas;
+    uint64_t bits_bas;
+};
+
+
+static void CoderChamp(const int64_t* q, const int64_t* precedent, int N, vector<Jeton>& jetons,
+                       vector<uint8_t>& octets)
+{
+    // 1. Jetons : séries de différences nulles et différences non nulles (zigzag)
+    uint64_t frequences[NB_CLASSES] = {};
+    jetons.clear();
+    int i = 0;
+    while (i < N)
+    {
+        int64_t d = precedent ? q[i] - precedent[i] : q[i];
+        uint64_t v;
+        int premiere_classe;
+        if (d == 0)
+        {
+            int j = i + 1;
+            while (j < N && (precedent ? q[j] == precedent[j] : q[j] == 0))
+                j++;
+            v = (uint64_t)(j - i);
+            premiere_classe = PREMIERE_CLASSE_SERIE;
+            i = j;
+        }
+        else
+        {
+            v = ((uint64_t)d << 1) ^ (uint64_t)(d >> 63);
+            premiere_classe = 0;
+            i++;
+        }
+        int b = NombreBits(v);
+        Jeton jeton;
+        jeton.classe = (uint8_t)(premiere_classe + b - 1);
+        jeton.nb_bits_bas = (uint8_t)(b - 1);
+        jeton.bits_bas = v & ((b > 1) ? ((1ULL << (b - 1)) - 1) : 0);
+        frequences[jeton.classe]++;
+        jetons.push_back(jeton);
+    }
+
+    // 2. Table : classes utilisées et longueurs de leurs codes
+    uint8_t longueurs[NB_CLASSES];
+    uint32_t codes[NB_CLASSES] = {};
+    LongueursHuffman(frequences, longueurs);
+    CodesCanoniques(longueurs, codes);
+    size_t debut_table = octets.size();
+    octets.push_back(0);
+    for (int s = 0; s < NB_CLASSES; s++)
+        if (longueurs[s] > 0)
+        {
+            octets.push_back((uint8_t)s);
+            octets.push_back(longueurs[s]);
+            octets[debut_table]++;
+        }
+
+    // 3. Bits, précédés de leur nombre d'octets
+    size_t debut_taille = octets.size();
+    octets.resize(debut_taille + sizeof(uint32_t));
+    EcrivainBits bits(octets);
+    for (const Jeton& jeton : jetons)
+    {
+        bits.Ecrire(codes[jeton.classe], longueurs[jeton.classe]);
+        bits.Ecrire(jeton.bits_bas, jeton.nb_bits_bas);
+    }
+    bits.Terminer();
+    uint32_t nb_octets = (uint32_t)(octets.size() - debut_taille - sizeof(uint32_t));
+    memcpy(&octets[debut_taille], &nb_octets, sizeof(nb_octets));
+}
+
+
+// Décode un champ à partir de position ; false si le champ est corrompu
+static bool DecoderChamp(const vector<uint8_t>& octets, size_t& position, int N, bool cle, int64_t* q)
+{
+    if (position >= octets.size())
+        return false;
+    int nb_classes = octets[position++];
+    if (position + 2 * (size_t)nb_classes + sizeof(uint32_t) > octets.size())
+        return false;
+    uint8_t longueurs[NB_CLASSES] = {};
+    for (int k = 0; k < nb_classes; k++)
+    {
+        int s = octets[position], l = octets[position + 1];
+        position += 2;
+        if (s >= NB_CLASSES || l < 1 || l > LONGUEUR_CODE_MAX)
+            return false;
+        longueurs[s] = (uint8_t)l;
+    }
+    uint32_t nb_octets;
+    memcpy(&nb_octets, &octets[position], sizeof(nb_octets));
+    position += sizeof(nb_octets);
+    if (position + nb_octets > octets.size())
+        return false;
+
+    DecodeurHuffman decodeur;
+    decodeur.Construire(longueurs);
+    LecteurBits bits(&octets[position], nb_octets);
+    position += nb_octets;
+
+    int i = 0;
+    while (i < N)
+    {
+        int classe = decodeur.Decoder(bits);
+        if (classe < 0)
+            return false;
+        bool serie = classe >= PREMIERE_CLASSE_SERIE;
+        int b = classe - (serie ? PREMIERE_CLASSE_SERIE : 0) + 1;
+        uint64_t v = (1ULL << (b - 1)) | bits.Lire(b - 1);
+        if (bits.depasse)
+            return false;
+        if (serie)
+        {
+            if (v > (uint64_t)(N - i))
+                return false;
+            int fin = i + (int)v;
+            for (; i < fin; i++)
+                if (cle)
+                    q[i] = 0;
+        }
+        else
+        {
+            int64_t d = (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+            q[i] = cle ? d : q[i] + d;
+            i++;
+        }
+    }
+    return true;
+}
+
+
+// ========================================
+// Ecriture
+// ========================================
+SortieCompressee::SortieCompressee()
+    : _fichier(nullptr), _entete_ecrite(false), _N(0), _tolerance_h(0.0), _tolerance_u(0.0),
+      _intervalle_cle(100), _nb_trames(0), _forcer_cle(false), _octets_bruts(0), _octets_ecrits(0)
+{
+}
+
+
+SortieCompressee::~SortieCompressee()
+{
+    Fermer();
+}
+
+
+bool SortieCompressee::Ouvrir(const string& nom_fichier, bool reprendre, double t_max)
+{
+    Fermer();
+    _nom = nom_fichier;
+    _entete_ecrite = false;
+    _nb_trames = 0;
+    _forcer_cle = false;
+    _octets_bruts = 0;
+    _octets_ecrits = 0;
+
+    if (reprendre)
+    {
+        _fichier = fopen(nom_fichier.c_str(), "r+b");
+        if (_fichier)
+            return Reprendre(t_max);
+    }
+
+    _fichier = fopen(nom_fichier.c_str(), "wb");
+    if (!_fichier)
+    {
+        cout << "Erreur : impossible d'ecrire '" << nom_fichier << "'" << endl;
+        return false;
+    }
+    return true;
+}
+
+
+// Relit l'en-tête et parcourt les trames (sans les décoder) jusqu'à la dernière de
+// temps <= t_max, puis tronque le fichier après elle
+bool SortieCompressee::Reprendre(double t_max)
+{
+    fseeko(_fichier, 0, SEEK_END);
+    uint64_t taille = (uint64_t)ftello(_fichier);
+    if (taille == 0)
+        return true;   // Fichier vide : l'en-tête sera écrit à la première trame
+
+    EnteteCompressee entete;
+    rewind(_fichier);
+    string erreur;
+    if (taille < sizeof(entete) || fread(&entete, sizeof(entete), 1, _fichier) != 1
+        || memcmp(entete.signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+        erreur = "n'est pas une sortie compressée";
+    else if (entete.marqueur != MARQUEUR_BOUTISME)
+        erreur = "écrit sur une machine d'un autre boutisme";
+    else if (entete.version != VERSION_COMPRESSEE)
+        erreur = "version " + to_string(entete.version) + " inconnue";
+    else if (entete.N == 0 || sizeof(entete) + entete.N * sizeof(double) > taille)
+        erreur = "en-tête incohérent";
+    if (!erreur.empty())
+    {
+        cout << "Erreur : sortie '" << _nom << "' " << erreur << endl;
+        fclose(_fichier);
+        _fichier = nullptr;
+        return false;
+    }
+    _N = (int)entete.N;
+    _tolerance_h = entete.tolerance_h;
+    _tolerance_u = entete.tolerance_u;
+    _intervalle_cle = (int)entete.intervalle_cle;
+    _entete_ecrite = true;
+
+    uint64_t fin = sizeof(entete) + entete.N * sizeof(double);
+    for (;;)
+    {
+        double t;
+        uint8_t cle;
+        uint32_t taille_trame;
+        fseeko(_fichier, (off_t)fin, SEEK_SET);
+        if (fread(&t, sizeof(t), 1, _fichier) != 1 || fread(&cle, 1, 1, _fichier) != 1
+            || fread(&taille_trame, sizeof(taille_trame), 1, _fichier) != 1
+            || fin + TAILLE_ENTETE_TRAME + taille_trame > taille || !(t <= t_max))
+            break;
+        fin += TAILLE_ENTETE_TRAME + taille_trame;
+        _nb_trames++;
+    }
+
+    // Les q de la dernière trame gardée ne sont pas relus : la suivante est une trame clé
+    _forcer_cle = true;
+    fflush(_fichier);
+    if (ftruncate(fileno(_fichier), (off_t)fin) != 0 || fseeko(_fichier, (off_t)fin, SEEK_SET) != 0)
+    {
+        cout << "Erreur : impossible de tronquer '" << _nom << "'" << endl;
+        fclose(_fichier);
+        _fichier = nullptr;
+        return false;
+    }
+    return true;
+}
+
+
+bool SortieCompressee::DefinirTolerances(double tolerance_h, double tolerance_u, int intervalle_cle)
+{
+    if (_entete_ecrite)
+    {
+        cout << "Erreur : tolerances de '" << _nom << "' deja ecrites dans le fichier" << endl;
+        return false;
+    }
+    _tolerance_h = max(0.0, tolerance_h);
+    _tolerance_u = max(0.0, tolerance_u);
+    _intervalle_cle = max(0, intervalle_cle);
+    return true;
+}
+
+
+bool SortieCompressee::EcrireEntete(int N, double dx, const double* zb)
+{
+    EnteteCompressee entete;
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.signature, SIGNATURE, sizeof(SIGNATURE));
+    entete.version = VERSION_COMPRESSEE;
+    entete.marqueur = MARQUEUR_BOUTISME;
+    entete.N = (uint64_t)N;
+    entete.dx = dx;
+    entete.tolerance_h = _tolerance_h;
+    entete.tolerance_u = _tolerance_u;
+    entete.intervalle_cle = (uint32_t)_intervalle_cle;
+
+    bool ok = fwrite(&entete, sizeof(entete), 1, _fichier) == 1
+           && fwrite(zb, sizeof(double), N, _fichier) == (size_t)N;
+    _N = N;
+    _entete_ecrite = true;
+    _octets_ecrits += sizeof(entete) + N * sizeof(double);
+    _octets_bruts += 64 + 2 * (uint64_t)N * sizeof(double);   // En-tête, x et zb de la sortie .svb
+    return ok;
+}
+
+
+bool SortieCompressee::EcrireTrame(double t, int N, double dx, const double* zb, const double* h,
+                                   const double* hu, double critere_h)
+{
+    if (!_fichier)
+        return false;
+    if (!_entete_ecrite && !EcrireEntete(N, dx, zb))
+    {
+        cout << "Erreur : ecriture incomplete de '" << _nom << "'" << endl;
+        return false;
+    }
+    if (N != _N)
+    {
+        cout << "Erreur : sortie '" << _nom << "' de " << _N << " cellules, trame de " << N << " ignoree" << endl;
+        return false;
+    }
+
+    // Quantification de h et u
+    _q_h_nouveau.resize(N);
+    _q_u_nouveau.resize(N);
+    for (int i = 0; i < N; i++)
+    {
+        double u = (h[i] > critere_h) ? hu[i] / h[i] : 0.0;
+        _q_h_nouveau[i] = Quantifier(h[i], _tolerance_h);
+        _q_u_nouveau[i] = Quantifier(u, _tolerance_u);
+    }
+
+    bool cle = _nb_trames == 0 || _forcer_cle || (_intervalle_cle > 0 && _nb_trames % _intervalle_cle == 0)
+            || (int)_q_h.size() != N;
+    _octets.resize(TAILLE_ENTETE_TRAME);
+    memcpy(&_octets[0], &t, sizeof(t));
+    _octets[sizeof(t)] = cle ? 1 : 0;
+
+    vector<Jeton> jetons;
+    CoderChamp(_q_h_nouveau.data(), cle ? nullptr : _q_h.data(), N, jetons, _octets);
+    CoderChamp(_q_u_nouveau.data(), cle ? nullptr : _q_u.data(), N, jetons, _octets);
+    uint32_t taille = (uint32_t)(_octets.size() - TAILLE_ENTETE_TRAME);
+    memcpy(&_octets[sizeof(t) + 1], &taille, sizeof(taille));
+
+    if (fwrite(_octets.data(), 1, _octets.size(), _fichier) != _octets.size())
+    {
+        cout << "Erreur : ecriture incomplete de '" << _nom << "'" << endl;
+        return false;
+    }
+    _q_h.swap(_q_h_nouveau);
+    _q_u.swap(_q_u_nouveau);
+    _forcer_cle = false;
+    _nb_trames++;
+    _octets_ecrits += _octets.size();
+    _octets_bruts += sizeof(double) + 2 * (uint64_t)N * sizeof(float);
+    return true;
+}
+
+
+bool SortieCompressee::Fermer()
+{
+    if (!_fichier)
+        return true;
+    bool ok = fclose(_fichier) == 0;
+    _fichier = nullptr;
+    if (!ok)
+        cout << "Erreur : ecriture incomplete de '" << _nom << "'" << endl;
+    return ok;
+}
+
+
+double SortieCompressee::TauxCompression() const
+{
+    return (_octets_ecrits > 0) ? (double)_octets_bruts / (double)_octets_ecrits : 0.0;
+}
+
+
+// ========================================
+// Lecture en flux
+// ========================================
+LecteurCompresse::LecteurCompresse()
+    : _fichier(nullptr), _N(0), _dx(0.0), _tolerance_h(0.0), _tolerance_u(0.0)
+{
+}
+
+
+LecteurCompresse::~LecteurCompresse()
+{
+    if (_fichier)
+        fclose(_fichier);
+}
+
+
+bool LecteurCompresse::Ouvrir(const string& nom_fichier)
+{
+    if (_fichier)
+        fclose(_fichier);
+    _nom = nom_fichier;
+    _fichier = fopen(nom_fichier.c_str(), "rb");
+    if (!_fichier)
+    {
+        cout << "Erreur : impossible de lire '" << nom_fichier << "'" << endl;
+        return false;
+    }
+
+    EnteteCompressee entete;
+    string erreur;
+    if (fread(&entete, sizeof(entete), 1, _fichier) != 1 || memcmp(entete.signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+        erreur = "n'est pas une sortie compressée";
+    else if (entete.marqueur != MARQUEUR_BOUTISME)
+        erreur = "écrit sur une machine d'un autre boutisme";
+    else if (entete.version != VERSION_COMPRESSEE)
+        erreur = "version " + to_string(entete.version) + " inconnue";
+    else if (entete.N == 0 || entete.N > (uint64_t)INT32_MAX)
+        erreur = "en-tête incohérent";
+    else
+    {
+        _zb.resize(entete.N);
+        if (fread(_zb.data(), sizeof(double), entete.N, _fichier) != entete.N)
+            erreur = "tronqué";
+    }
+    if (!erreur.empty())
+    {
+        cout << "Erreur : sortie '" << nom_fichier << "' " << erreur << endl;
+        fclose(_fichier);
+        _fichier = nullptr;
+        return false;
+    }
+
+    _N = (int)entete.N;
+    _dx = entete.dx;
+    _tolerance_h = entete.tolerance_h;
+    _tolerance_u = entete.tolerance_u;
+    _q_h.assign(_N, 0);
+    _q_u.assign(_N, 0);
+    return true;
+}
+
+
+bool LecteurCompresse::LireTrame(double& t, vector<double>& h, vector<double>& u)
+{
+    if (!_fichier)
+        return false;
+
+    uint8_t cle;
+    uint32_t taille;
+    if (fread(&t, sizeof(t), 1, _fichier) != 1 || fread(&cle, 1, 1, _fichier) != 1
+        || fread(&taille, sizeof(taille), 1, _fichier) != 1)
+        return false;   // Fin du fichier
+    _octets.resize(taille);
+    size_t position = 0;
+    if (fread(_octets.data(), 1, taille, _fichier) != taille
+        || !DecoderChamp(_octets, position, _N, cle != 0, _q_h.data())
+        || !DecoderChamp(_octets, position, _N, cle != 0, _q_u.data()))
+    {
+        cout << "Erreur : trame corrompue dans '" << _nom << "' (t = " << t << ")" << endl;
+        return false;
+    }
+
+    h.resize(_N);
+    u.resize(_N);
+    for (int i = 0; i < _N; i++)
+    {
+        h[i] = Reconstruire(_q_h[i], _tolerance_h);
+        u[i] = Reconstruire(_q_u[i], _tolerance_u);
+    }
+    return true;
+}
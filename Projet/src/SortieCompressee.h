@@ -0,0 +1,126 @@
+#ifndef _SORTIE_COMPRESSEE_H
+#define _SORTIE_COMPRESSEE_H
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+
+// ========================================
+// Sortie compressée des sauvegardes
+// ========================================
+// Variante de la sortie binaire (choisie par l'extension .svz) pour les longs calculs
+// où l'essentiel du domaine change peu d'une sauvegarde à l'autre. Pour chaque
+// trame, h et u (u = hu/h, 0 si la cellule est sèche) sont :
+// 1. quantifiés : q = arrondi(v / (2 tolerance)), erreur absolue <= tolerance ;
+//    tolerance nulle : sans perte par rapport au float (q = bits du float) ;
+// 2. différenciés en temps : d = q - q de la trame précédente (en entiers, donc sans
+//    dérive), ou d = q pour une trame clé (la première, puis toutes les
+//    intervalle_cle trames, pour pouvoir reprendre la lecture) ;
+// 3. codés en jetons : séries de d nuls (longueur) et valeurs non nulles (zigzag),
+//    chaque jeton étant une classe de taille (nombre de bits) suivie des bits bas ;
+// 4. les classes sont codées par un code de Huffman canonique propre à la trame et
+//    au champ (longueurs limitées à 15 bits), les bits bas sont écrits tels quels.
+//
+// Format (version 1), nombres dans l'ordre d'octets de la machine :
+//   en-tête de 56 octets :
+//     "SVCOMPRE" (8 octets), uint32 version, uint32 marqueur 0x01020304 (ordre des octets)
+//     uint64 N, double dx, double tolerance_h, double tolerance_u,
+//     uint32 intervalle_cle, uint32 réservé (0)
+//   zb (N doubles), les centres des cellules étant (i + 0.5) dx
+//   trames : double t, uint8 clé (1 ou 0), uint32 taille de la suite en octets, puis
+//   le champ h et le champ u, chacun :
+//     uint8 nombre de classes utilisées, puis (uint8 classe, uint8 longueur du code)
+//     uint32 nombre d'octets, puis les bits (premier bit = bit de poids fort)
+//   classes 0..63 : valeur zigzag z >= 1 de b = classe + 1 bits, suivie de ses b - 1 bits bas
+//   classes 64..95 : série de L >= 1 zéros, L de b = classe - 63 bits, suivie de ses b - 1 bits bas
+// Décodage en flux : LecteurCompresse ici, solution_compressee.py en Python.
+
+// Nom d'une sortie compressée (extension .svz) ?
+bool EstSortieCompressee(const std::string& nom_fichier);
+
+class SortieCompressee
+{
+private:
+    FILE* _fichier;
+    std::string _nom;
+    bool _entete_ecrite;
+    int _N;
+    double _tolerance_h;
+    double _tolerance_u;
+    int _intervalle_cle;
+    long _nb_trames;
+    bool _forcer_cle;
+
+    // Valeurs quantifiées de la trame précédente et de la trame courante
+    std::vector<int64_t> _q_h, _q_u;
+    std::vector<int64_t> _q_h_nouveau, _q_u_nouveau;
+    std::vector<uint8_t> _octets;   // Trame en cours de codage
+
+    // Bilan
+    uint64_t _octets_bruts;     // Trames équivalentes de la sortie .svb
+    uint64_t _octets_ecrits;
+
+    bool EcrireEntete(int N, double dx, const double* zb);
+    bool Reprendre(double t_max);
+
+public:
+    SortieCompressee();
+    ~SortieCompressee();
+    SortieCompressee(const SortieCompressee&) = delete;
+    SortieCompressee& operator=(const SortieCompressee&) = delete;
+
+    // Comme SortieBinaire::Ouvrir : avec reprendre, les trames de temps > t_max sont
+    // retirées et la trame suivante est une trame clé (tolérances du fichier conservées)
+    bool Ouvrir(const std::string& nom_fichier, bool reprendre = false, double t_max = 0.0);
+
+    // Tolérances absolues sur h (m) et u (m/s), 0 : sans perte par rapport au float.
+    // Possible seulement avant la première trame ; retourne false (avec un message) sinon.
+    bool DefinirTolerances(double tolerance_h, double tolerance_u, int intervalle_cle);
+
+    // Ajoute l'état au temps t ; l'en-tête (N, dx, tolérances, zb) est écrit à la première trame
+    bool EcrireTrame(double t, int N, double dx, const double* zb, const double* h, const double* hu,
+                     double critere_h);
+
+    bool Fermer();
+
+    long NombreTrames() const { return _nb_trames; }
+    uint64_t OctetsEcrits() const { return _octets_ecrits; }
+    // Taille des trames écrites en sortie .svb / taille écrite (en-têtes compris)
+    double TauxCompression() const;
+};
+
+// Lecture en flux d'une sortie compressée
+class LecteurCompresse
+{
+private:
+    FILE* _fichier;
+    std::string _nom;
+    int _N;
+    double _dx;
+    double _tolerance_h;
+    double _tolerance_u;
+    std::vector<double> _zb;
+    std::vector<int64_t> _q_h, _q_u;
+    std::vector<uint8_t> _octets;
+
+public:
+    LecteurCompresse();
+    ~LecteurCompresse();
+    LecteurCompresse(const LecteurCompresse&) = delete;
+    LecteurCompresse& operator=(const LecteurCompresse&) = delete;
+
+    // Retourne false (avec un message) si le fichier est illisible ou d'un autre format
+    bool Ouvrir(const std::string& nom_fichier);
+
+    // Trame suivante ; false à la fin du fichier (ou avec un message si elle est corrompue)
+    bool LireTrame(double& t, std::vector<double>& h, std::vector<double>& u);
+
+    int ObtenirN() const { return _N; }
+    double ObtenirDx() const { return _dx; }
+    double ObtenirToleranceH() const { return _tolerance_h; }
+    double ObtenirToleranceU() const { return _tolerance_u; }
+    const std::vector<double>& ObtenirZb() const { return _zb; }
+};
+
+#endif // _SORTIE_COMPRESSEE_H
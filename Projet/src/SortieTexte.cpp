@@ -0,0 +1,199 @@
+#include "SortieTexte.h"
+#include <iostream>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+SortieTexte::SortieTexte() : _descripteur(-1), _precision(6)
+{
+}
+
+
+SortieTexte::~SortieTexte()
+{
+    Fermer();
+}
+
+
+bool SortieTexte::Ouvrir(const string& nom_fichier, bool reprendre, double t_max)
+{
+    Fermer();
+    _nom = nom_fichier;
+    int options = reprendre ? (O_RDWR | O_CREAT) : (O_WRONLY | O_CREAT | O_TRUNC);
+    _descripteur = open(nom_fichier.c_str(), options, 0644);
+    if (_descripteur < 0)
+    {
+        cout << "Erreur : impossible d'ecrire '" << nom_fichier << "'" << endl;
+        return false;
+    }
+    return reprendre ? Reprendre(t_max) : true;
+}
+
+
+// Parcourt les trames (séparées par une ligne vide) d'une sortie existante et la
+// tronque après la dernière trame complète de temps <= t_max
+bool SortieTexte::Reprendre(double t_max)
+{
+    // Les temps du fichier sont arrondis : t_max est comparé arrondi de la même façon
+    char texte[40];
+    *EcrireNombre(texte, t_max) = '\0';
+    double t_limite = strtod(texte, nullptr);
+
+    vector<char> bloc(1 << 20);
+    off_t position = 0;       // Position dans le fichier du début de bloc
+    off_t fin_gardee = 0;     // Fin de la dernière trame gardée
+    bool debut_trame = true;
+    bool lecture_t = false;
+    string texte_t;
+    char precedent = '\0';
+    bool fin = false;
+    while (!fin)
+    {
+        ssize_t lu = read(_descripteur, bloc.data(), bloc.size());
+        if (lu < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            cout << "Erreur : lecture de '" << _nom << "' impossible (" << strerror(errno) << ")" << endl;
+            Fermer();
+            return false;
+        }
+        if (lu == 0)
+            break;
+        for (ssize_t k = 0; k < lu && !fin; k++)
+        {
+            char c = bloc[k];
+            if (debut_trame)
+            {
+                debut_trame = false;
+                lecture_t = true;
+                texte_t.clear();
+            }
+            if (lecture_t)
+            {
+                if (c == ' ' || c == '\n')
+                    lecture_t = false;
+                else
+                    texte_t += c;
+            }
+            if (c == '\n' && precedent == '\n')
+            {
+                // Fin de trame : les temps croissent, la première trame trop tardive arrête
+                char* fin_nombre = nullptr;
+                double t = strtod(texte_t.c_str(), &fin_nombre);
+                if (texte_t.empty() || *fin_nombre != '\0')
+                {
+                    cout << "Erreur : '" << _nom << "' n'est pas une sortie texte de Sauvegarder" << endl;
+                    Fermer();
+                    return false;
+                }
+                if (t > t_limite)
+                    fin = true;
+                else
+                    fin_gardee = position + k + 1;
+                debut_trame = true;
+                c = '\0';
+            }
+            precedent = c;
+        }
+        position += lu;
+    }
+
+    if (ftruncate(_descripteur, fin_gardee) != 0 || lseek(_descripteur, 0, SEEK_END) < 0)
+    {
+        cout << "Erreur : reprise de '" << _nom << "' impossible (" << strerror(errno) << ")" << endl;
+        Fermer();
+        return false;
+    }
+    return true;
+}
+
+
+bool SortieTexte::DefinirPrecision(int chiffres)
+{
+    if (chiffres < 1 || chiffres > 17)
+    {
+        cout << "Erreur : precision de sortie entre 1 et 17 chiffres attendue (" << chiffres << ")" << endl;
+        return false;
+    }
+    _precision = chiffres;
+    return true;
+}
+
+
+// Même texte que ostream << valeur avec setprecision(_precision) (format %g)
+char* SortieTexte::EcrireNombre(char* p, double valeur) const
+{
+    return to_chars(p, p + 32, valeur, chars_format::general, _precision).ptr;
+}
+
+
+bool SortieTexte::EcrireTrame(double t, int N, double dx, const double* zb, const double* h, const double* hu,
+                              double critere_h)
+{
+    if (_descripteur < 0)
+        return false;
+
+    // Au plus signe, chiffres, point et exposant "e-308" par nombre : 6 nombres et
+    // 6 séparateurs par ligne, plus la ligne vide finale
+    size_t taille_ligne = 6 * (size_t)(_precision + 7) + 6;
+    size_t taille = (size_t)N * taille_ligne + 1;
+    if (_tampon.size() < taille + 32)
+        _tampon.resize(taille + 32);
+
+    // t est le même sur toutes les lignes : mis en forme une fois
+    char texte_t[32];
+    size_t longueur_t = EcrireNombre(texte_t, t) - texte_t;
+
+    char* p = _tampon.data();
+    for (int i = 0; i < N; i++)
+    {
+        double u = (h[i] > critere_h) ? hu[i] / h[i] : 0.0;
+        memcpy(p, texte_t, longueur_t);
+        p += longueur_t;
+        *p++ = ' ';
+        p = EcrireNombre(p, (i + 0.5) * dx);
+        *p++ = ' ';
+        p = EcrireNombre(p, h[i]);
+        *p++ = ' ';
+        p = EcrireNombre(p, u);
+        *p++ = ' ';
+        p = EcrireNombre(p, zb[i]);
+        *p++ = ' ';
+        p = EcrireNombre(p, h[i] + zb[i]);
+        *p++ = '\n';
+    }
+    *p++ = '\n';
+
+    // Un seul appel système, sauf écriture partielle (signal, disque plein)
+    const char* debut = _tampon.data();
+    size_t reste = p - debut;
+    while (reste > 0)
+    {
+        ssize_t ecrit = write(_descripteur, debut, reste);
+        if (ecrit < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            cout << "Erreur : ecriture de '" << _nom << "' impossible (" << strerror(errno) << ")" << endl;
+            return false;
+        }
+        debut += ecrit;
+        reste -= ecrit;
+    }
+    return true;
+}
+
+
+void SortieTexte::Fermer()
+{
+    if (_descripteur >= 0)
+        close(_descripteur);
+    _descripteur = -1;
+}
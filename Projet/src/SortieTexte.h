@@ -0,0 +1,53 @@
+#ifndef _SORTIE_TEXTE_H
+#define _SORTIE_TEXTE_H
+
+#include <vector>
+#include <string>
+
+// ========================================
+// Sortie texte des sauvegardes
+// ========================================
+// Format historique de Sauvegarder : une ligne "t x h u zb H" par cellule, puis une
+// ligne vide. Les nombres sont mis en forme par std::to_chars (format %g, precision
+// chiffres significatifs) dans un tampon alloué une fois, et chaque sauvegarde est
+// écrite en un seul appel système. Avec la précision par défaut (6), le fichier est
+// identique octet pour octet à celui de l'ancienne écriture par ofstream.
+
+class SortieTexte
+{
+private:
+    int _descripteur;
+    std::string _nom;
+    int _precision;
+    std::vector<char> _tampon;
+
+    char* EcrireNombre(char* p, double valeur) const;
+    bool Reprendre(double t_max);
+
+public:
+    SortieTexte();
+    ~SortieTexte();
+    SortieTexte(const SortieTexte&) = delete;
+    SortieTexte& operator=(const SortieTexte&) = delete;
+
+    // Crée le fichier. Avec reprendre, un fichier existant est conservé jusqu'à la
+    // dernière trame complète de temps <= t_max (t_max arrondi à la précision de
+    // sortie, comme les temps écrits) : les trames écrites après le point de reprise,
+    // ou interrompues, sont supprimées et les suivantes ajoutées à la fin. Appeler
+    // DefinirPrecision avant. Retourne false (avec un message) si le fichier ne peut
+    // pas être ouvert ou n'est pas une sortie texte de Sauvegarder.
+    bool Ouvrir(const std::string& nom_fichier, bool reprendre = false, double t_max = 0.0);
+
+    // Chiffres significatifs (1 à 17 ; 17 : relecture exacte des doubles)
+    bool DefinirPrecision(int chiffres);
+    int ObtenirPrecision() const { return _precision; }
+
+    // Ecrit l'état au temps t (u = hu/h sur les cellules mouillées, 0 sinon)
+    bool EcrireTrame(double t, int N, double dx, const double* zb, const double* h, const double* hu,
+                     double critere_h);
+
+    void Fermer();
+    bool EstOuverte() const { return _descripteur >= 0; }
+};
+
+#endif // _SORTIE_TEXTE_H
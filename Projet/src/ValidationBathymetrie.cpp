@@ -0,0 +1,120 @@
+// ========================================
+// Validation du chargement des profils de fond
+// ========================================
+// La pente de DefinirFondPente (fond plat puis pente linéaire) est écrite dans les
+// trois formats lus par ChargerFond, puis rechargée sur la même grille :
+// - texte (CSV), avec les trois points qui définissent le fond ;
+// - binaire SVPROFIL en double, plus fin que la grille (moyenne par cellule) et
+//   commençant à l'abscisse 100 m (grille chargée avec x_debut = 100) ;
+// - même profil binaire en float.
+// Le début de la pente tombe sur une limite de cellule : la moyenne de
+// l'interpolation sur chaque cellule vaut alors le fond de DefinirFondPente au
+// centre. Ecart toléré : 1e-12 m pour le texte et le double, 1e-6 m pour le float
+// (le demi-ulp d'un fond de 2.2 m stocké en float vaut 1.2e-7 m).
+// Chaque cas affiche l'écart max et OK ou ECHEC ; le programme retourne 1 si un cas échoue.
+//
+// Usage : validation_bathymetrie [N]   (N multiple de 10)
+
+#include "SaintVenant.h"
+#include "Bathymetrie.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+static const double L = 50.0;
+static const double X_PENTE = 15.0;
+static const double Z_FIN = 2.2;
+static const double X_PROFIL_BINAIRE = 100.0;
+static const int POINTS_BINAIRE = 2001;   // pas de 2.5 cm
+
+
+static double FondPente(double x)
+{
+    return (x < X_PENTE) ? 0.0 : Z_FIN / (L - X_PENTE) * (x - X_PENTE);
+}
+
+
+// Fond chargé depuis nom_fichier, comparé à zb_reference ; false si le chargement échoue
+// ou si un écart dépasse tolerance
+static bool ComparerProfil(const string& cas, const string& nom_fichier, double x_debut, int N,
+                           const vector<double>& zb_reference, double tolerance)
+{
+    SaintVenant1D solveur;
+    streambuf* sortie = cout.rdbuf(nullptr);
+    solveur.Initialiser(N, L, 0.9, "");
+    bool charge = solveur.ChargerFond(nom_fichier, x_debut);
+    cout.rdbuf(sortie);
+
+    double ecart_max = 0.0;
+    if (charge)
+    {
+        const vector<double>& zb = solveur.ObtenirZb();
+        for (int i = 0; i < N; i++)
+            ecart_max = max(ecart_max, fabs(zb[i] - zb_reference[i]));
+    }
+    bool ok = charge && ecart_max <= tolerance;
+
+    cout << "  " << left << setw(18) << cas << right;
+    if (charge)
+        cout << "ecart max " << scientific << setprecision(2) << ecart_max << defaultfloat;
+    else
+        cout << "chargement impossible";
+    cout << " : " << (ok ? "OK" : "ECHEC") << endl;
+    remove(nom_fichier.c_str());
+    return ok;
+}
+
+
+int main(int argc, char** argv)
+{
+    int N = (argc > 1) ? atoi(argv[1]) : 500;
+    if (N < 10 || N % 10 != 0)
+    {
+        cout << "Erreur : N doit etre un multiple de 10 (debut de la pente sur une limite de cellule)" << endl;
+        return 1;
+    }
+
+    // Référence
+    SaintVenant1D reference;
+    streambuf* sortie = cout.rdbuf(nullptr);
+    reference.Initialiser(N, L, 0.9, "");
+    reference.DefinirFondPente(X_PENTE, Z_FIN);
+    cout.rdbuf(sortie);
+    const vector<double>& zb_reference = reference.ObtenirZb();
+
+    // Profils
+    const string nom_csv = "validation_bathymetrie.csv";
+    const string nom_double = "validation_bathymetrie_f64.bin";
+    const string nom_float = "validation_bathymetrie_f32.bin";
+
+    ofstream csv(nom_csv);
+    csv << "x,z" << endl << setprecision(17);
+    for (double x : { 0.0, X_PENTE, L })
+        csv << x << "," << FondPente(x) << endl;
+    csv.close();
+
+    double pas = L / (POINTS_BINAIRE - 1);
+    vector<double> z(POINTS_BINAIRE);
+    for (int k = 0; k < POINTS_BINAIRE; k++)
+        z[k] = FondPente(k * pas);
+    if (!csv || !EcrireProfilBinaire(nom_double, X_PROFIL_BINAIRE, pas, z, false)
+        || !EcrireProfilBinaire(nom_float, X_PROFIL_BINAIRE, pas, z, true))
+    {
+        cout << "Erreur : impossible d'ecrire les profils" << endl;
+        return 1;
+    }
+
+    cout << "Profils de fond contre DefinirFondPente(" << X_PENTE << ", " << Z_FIN << ") : N = " << N
+         << ", L = " << L << " m" << endl;
+    bool ok = ComparerProfil("CSV", nom_csv, 0.0, N, zb_reference, 1e-12);
+    ok = ComparerProfil("SVPROFIL float64", nom_double, X_PROFIL_BINAIRE, N, zb_reference, 1e-12) && ok;
+    ok = ComparerProfil("SVPROFIL float32", nom_float, X_PROFIL_BINAIRE, N, zb_reference, 1e-6) && ok;
+    return ok ? 0 : 1;
+}
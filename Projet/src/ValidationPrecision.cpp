@@ -0,0 +1,271 @@
+// ========================================
+// Validation du solveur en simple précision
+// ========================================
+// Trois cas tests, pour plusieurs N, résolus jusqu'au même temps final avec
+// SaintVenantPrecision en double (la référence) et en float :
+// - soliton sur fond plat ;
+// - soliton qui monte sur une pente puis un plateau (bord mouillé/sec) ;
+// - rupture de barrage sur fond plat.
+// Pour chaque précision : écart de position de l'onde (crête du soliton, choc de
+// la rupture de barrage) en m et en cellules, écart de la surface maximale, écart
+// relatif de masse et écart L1 relatif sur h par rapport au double, et un verdict
+// (sûr si l'onde est à moins d'une cellule, la masse à 1e-5 près et l'écart L1
+// sous 1e-3). La masse est comparée à celle du calcul double au même instant : de
+// l'eau sort par les bords ouverts, seule compte l'erreur due à la précision.
+// Vérifie aussi que la version double reproduit SaintVenant1D bit à bit, puis
+// mesure le coût par cellule des deux précisions sur une grande grille.
+//
+// Usage : precision_flottante [N_max] [N_cout]
+// (à compiler en Release pour des temps représentatifs)
+
+#include "SaintVenant.h"
+#include "SaintVenantPrecision.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+// Seuils du verdict
+static const double ECART_ONDE_MAX = 1.0;      // cellules
+static const double ERREUR_MASSE_MAX = 1e-5;   // relative
+static const double ECART_L1_MAX = 1e-3;       // relatif
+
+
+// Les messages d'initialisation du solveur ne font pas partie du rapport
+struct Silence
+{
+    streambuf* _sortie;
+    Silence() : _sortie(cout.rdbuf(nullptr)) {}
+    ~Silence() { cout.rdbuf(_sortie); }
+};
+
+
+struct CasTest
+{
+    const char* nom;
+    double L;
+    double t_final;
+};
+
+static const CasTest CAS[] = {
+    { "soliton, fond plat", 75.0, 4.0 },
+    { "soliton, pente et plateau", 75.0, 6.0 },
+    { "rupture de barrage", 50.0, 1.5 },
+};
+
+
+static void PreparerCas(SaintVenant1D& reference, int cas, int N)
+{
+    Silence silence;
+    reference.Initialiser(N, CAS[cas].L, 0.9, "");
+    if (cas == 0)
+    {
+        reference.DefinirFondPlat();
+        reference.ConditionInitialeSoliton(0.2, 20.0);
+    }
+    else if (cas == 1)
+    {
+        reference.DefinirFondPentePuisPlat(35.0, 50.0, 2.0);
+        reference.ConditionInitialeSoliton(0.2, 20.0);
+    }
+    else
+    {
+        reference.DefinirFondPlat();
+        reference.ConditionInitialeDamBreak();
+    }
+}
+
+
+struct Resultat
+{
+    double x_onde;
+    double H_max;
+    double masse;
+    long pas;
+    vector<double> h;
+};
+
+
+// Position du choc de la rupture de barrage : dernière cellule au-dessus de la
+// moyenne entre la hauteur aval et le maximum de la moitié droite (état intermédiaire)
+static double PositionChoc(const vector<double>& h, double dx)
+{
+    int N = (int)h.size();
+    double h_aval = h[N-1], h_milieu = 0.0;
+    for (int i = N / 2; i < N; i++)
+        h_milieu = max(h_milieu, h[i]);
+    double seuil = 0.5 * (h_aval + h_milieu);
+    int i_choc = N - 1;
+    while (i_choc > 0 && h[i_choc] <= seuil)
+        i_choc--;
+    return (i_choc + 0.5) * dx;
+}
+
+
+template <class Solveur>
+static Resultat Resoudre(const SaintVenant1D& reference, int cas)
+{
+    const double t_final = CAS[cas].t_final;
+    Solveur solveur;
+    solveur.Initialiser(reference, 0.9);
+
+    Resultat r;
+    r.pas = 0;
+    while (solveur.ObtenirTemps() < t_final)
+    {
+        solveur.Avancer(t_final);
+        r.pas++;
+    }
+
+    r.H_max = solveur.ObtenirSurfaceMax();
+    r.masse = solveur.CalculerMasseTotale();
+    r.h.assign(solveur.ObtenirH().begin(), solveur.ObtenirH().end());
+    r.x_onde = (cas == 2) ? PositionChoc(r.h, solveur.ObtenirDx()) : solveur.ObtenirPositionCrete();
+    return r;
+}
+
+
+// ========================================
+// La version double est-elle identique à SaintVenant1D ?
+// ========================================
+static bool VerifierIdentiteDouble(int N, int nb_pas)
+{
+    bool identique = true;
+    for (int cas = 0; cas < 3; cas++)
+    {
+        SaintVenant1D reference;
+        PreparerCas(reference, cas, N);
+        SaintVenantDouble solveur;
+        solveur.Initialiser(reference, 0.9);
+
+        for (int n = 0; n < nb_pas; n++)
+        {
+            reference.Avancer();
+            solveur.Avancer();
+        }
+
+        const vector<double>& h_ref = reference.ObtenirH();
+        const vector<double>& hu_ref = reference.ObtenirHu();
+        bool cas_identique = reference.ObtenirTemps() == solveur.ObtenirTemps()
+                          && memcmp(h_ref.data(), solveur.ObtenirH().data(), N * sizeof(double)) == 0
+                          && memcmp(hu_ref.data(), solveur.ObtenirHu().data(), N * sizeof(double)) == 0;
+        cout << "  " << left << setw(28) << CAS[cas].nom << right << (cas_identique ? "identique" : "DIFFERENT") << endl;
+        identique = identique && cas_identique;
+    }
+    return identique;
+}
+
+
+// ========================================
+// Coût par cellule et par pas
+// ========================================
+template <class Solveur>
+static double MesurerCout(const SaintVenant1D& reference, int nb_pas)
+{
+    Solveur solveur;
+    solveur.Initialiser(reference, 0.9);
+    solveur.Avancer();  // Pages du nouvel état touchées une première fois
+
+    auto debut = chrono::steady_clock::now();
+    for (int n = 0; n < nb_pas; n++)
+        solveur.Avancer();
+    auto fin = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(fin - debut).count() / ((double)nb_pas * solveur.ObtenirN());
+}
+
+
+static void AfficherLigne(const char* precision, const Resultat& r, const Resultat& ref, double dx, bool& sur)
+{
+    double ecart_onde = fabs(r.x_onde - ref.x_onde);
+    double ecart_masse = (r.masse - ref.masse) / ref.masse;
+    double l1 = 0.0, norme = 0.0;
+    for (size_t i = 0; i < r.h.size(); i++)
+    {
+        l1 += fabs(r.h[i] - ref.h[i]);
+        norme += fabs(ref.h[i]);
+    }
+    double ecart_l1 = (norme > 0.0) ? l1 / norme : 0.0;
+    sur = ecart_onde <= ECART_ONDE_MAX * dx + 1e-12 && fabs(ecart_masse) <= ERREUR_MASSE_MAX
+       && ecart_l1 <= ECART_L1_MAX;
+
+    cout << setw(10) << precision << setw(8) << r.pas
+         << setw(11) << fixed << setprecision(4) << r.x_onde
+         << setw(10) << setprecision(2) << ecart_onde / dx
+         << setw(12) << scientific << setprecision(2) << fabs(r.H_max - ref.H_max)
+         << setw(12) << ecart_masse
+         << setw(12) << ecart_l1
+         << setw(8) << (sur ? "sur" : "NON") << defaultfloat << endl;
+}
+
+
+int main(int argc, char** argv)
+{
+    int N_max = (argc > 1) ? atoi(argv[1]) : 16000;
+    int N_cout = (argc > 2) ? atoi(argv[2]) : 2000000;
+    if (N_max < 100 || N_cout < 100)
+    {
+        cout << "Erreur : N_max et N_cout doivent valoir au moins 100" << endl;
+        return 1;
+    }
+
+    cout << "Solveur Saint-Venant 1D en double et en float (HLL, reconstruction hydrostatique, CFL 0.9)" << endl;
+    cout << endl << "Version double contre SaintVenant1D (N = 1000, 500 pas) :" << endl;
+    bool identique = VerifierIdentiteDouble(1000, 500);
+
+    vector<int> tailles;
+    for (int N = 1000; N <= N_max; N *= 4)
+        tailles.push_back(N);
+
+    int nb_sur = 0, nb_lignes = 0;
+    for (int cas = 0; cas < 3; cas++)
+    {
+        cout << endl << CAS[cas].nom << " (t = " << CAS[cas].t_final << " s)" << endl;
+        cout << setw(8) << "N" << setw(10) << "precision" << setw(8) << "pas" << setw(11) << "x_onde"
+             << setw(10) << "ecart/dx" << setw(12) << "ecart H_max" << setw(12) << "ecart masse" << setw(12) << "ecart L1"
+             << setw(8) << "verdict" << endl;
+
+        for (int N : tailles)
+        {
+            SaintVenant1D reference;
+            PreparerCas(reference, cas, N);
+            double dx = reference.ObtenirDx();
+
+            Resultat r_double = Resoudre<SaintVenantDouble>(reference, cas);
+            Resultat r_float = Resoudre<SaintVenantFloat>(reference, cas);
+
+            bool sur;
+            cout << setw(8) << N;
+            AfficherLigne(SaintVenantDouble::NomPrecision(), r_double, r_double, dx, sur);
+            cout << setw(8) << "";
+            AfficherLigne(SaintVenantFloat::NomPrecision(), r_float, r_double, dx, sur);
+            nb_sur += sur;
+            nb_lignes++;
+        }
+    }
+
+    // Coût : soliton sur fond plat, grande grille (état hors cache)
+    const int nb_pas = 20;
+    SaintVenant1D reference;
+    PreparerCas(reference, 0, N_cout);
+    double cout_double = MesurerCout<SaintVenantDouble>(reference, nb_pas);
+    double cout_float = MesurerCout<SaintVenantFloat>(reference, nb_pas);
+
+    cout << endl << "Coût par cellule et par pas (N = " << N_cout << ", " << nb_pas << " pas) :" << endl;
+    cout << fixed << setprecision(2);
+    cout << "  double : " << setw(7) << cout_double << " ns" << endl;
+    cout << "  float  : " << setw(7) << cout_float << " ns  (x" << cout_double / cout_float << ")" << endl;
+    cout << defaultfloat;
+
+    cout << endl << "Bilan : double identique à SaintVenant1D : " << (identique ? "oui" : "NON") << endl;
+    cout << "  float sûr dans " << nb_sur << " cas sur " << nb_lignes << endl;
+    cout << "  (seuils : onde à moins de " << ECART_ONDE_MAX << " cellule, masse à " << ERREUR_MASSE_MAX
+         << " près, écart L1 relatif sous " << ECART_L1_MAX << ")" << endl;
+
+    return identique ? 0 : 1;
+}
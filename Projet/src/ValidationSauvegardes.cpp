@@ -0,0 +1,221 @@
+// ========================================
+// Validation des sauvegardes asynchrones
+// ========================================
+// Cas qui mêlent le thread d'écriture des sauvegardes (ActiverSauvegardesAsynchrones)
+// et les changements d'état du solveur :
+// - des sauvegardes en attente quand Initialiser change N et dx : elles doivent être
+//   écrites entières dans l'ancien fichier, avec l'ancienne grille ;
+// - même situation avec ChargerReprise ;
+// - tolérances et taux de compression .svz lus pendant que des sauvegardes attendent ;
+// - reprise après un arrêt postérieur au point de reprise, avec des sorties à temps
+//   imposés à partir de t0 != 0 : la sortie texte reprise doit être identique octet
+//   pour octet à celle d'un calcul sans arrêt.
+// Chaque cas affiche OK ou ECHEC ; le programme retourne 1 si un cas échoue.
+// A lancer aussi dans une compilation avec -fsanitize=address ou thread.
+//
+// Usage : validation_sauvegardes [N] [nb_sauvegardes]
+
+#include "SaintVenant.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+// Trames d'un fichier texte de Sauvegarder (N lignes puis une ligne vide chacune)
+// dont toutes les lignes ont bien les 6 colonnes ; -1 si le fichier est incohérent
+static long CompterTrames(const string& nom_fichier, int N)
+{
+    ifstream fichier(nom_fichier);
+    string ligne;
+    long nb_lignes = 0, nb_trames = 0;
+    while (getline(fichier, ligne))
+    {
+        if (ligne.empty())
+        {
+            if (nb_lignes != N)
+                return -1;
+            nb_trames++;
+            nb_lignes = 0;
+            continue;
+        }
+        double valeurs[6];
+        if (sscanf(ligne.c_str(), "%lf %lf %lf %lf %lf %lf", &valeurs[0], &valeurs[1], &valeurs[2],
+                   &valeurs[3], &valeurs[4], &valeurs[5]) != 6)
+            return -1;
+        nb_lignes++;
+    }
+    return (nb_lignes == 0) ? nb_trames : -1;
+}
+
+
+static string LireFichier(const string& nom_fichier)
+{
+    ifstream fichier(nom_fichier, ios::binary);
+    ostringstream contenu;
+    contenu << fichier.rdbuf();
+    return contenu.str();
+}
+
+
+static bool Verdict(const string& cas, bool ok)
+{
+    cout << "  " << cas << " : " << (ok ? "OK" : "ECHEC") << endl;
+    return ok;
+}
+
+
+// Sauvegardes en file à précision maximale (mise en forme lente) puis Initialiser
+// sur une grille 100 fois plus fine
+static bool InitialiserPendantEcriture(int N, int nb_sauvegardes)
+{
+    const string nom_fichier = "validation_sauvegardes.txt";
+    SaintVenant1D solveur;
+    solveur.ActiverSauvegardesAsynchrones(true, nb_sauvegardes, true);
+    solveur.DefinirPrecisionSortie(17);
+    solveur.Initialiser(N, 75.0, 0.9, nom_fichier);
+    solveur.DefinirFondPente(30, 2.5);
+    solveur.ConditionInitialeSoliton(0.3, 12);
+    for (int k = 0; k < nb_sauvegardes; k++)
+    {
+        solveur.Avancer();
+        solveur.Sauvegarder();
+    }
+    solveur.Initialiser(100 * N, 75.0, 0.9, "");
+
+    bool ok = CompterTrames(nom_fichier, N) == nb_sauvegardes;
+    remove(nom_fichier.c_str());
+    return ok;
+}
+
+
+// Même cas avec ChargerReprise, qui réinitialise le solveur
+static bool ReprisePendantEcriture(int N, int nb_sauvegardes)
+{
+    const string nom_fichier = "validation_sauvegardes.txt";
+    const string nom_reprise = "validation_sauvegardes.rep";
+    SaintVenant1D grand;
+    grand.Initialiser(100 * N, 75.0, 0.9, "");
+    grand.DefinirFondPente(30, 2.5);
+    grand.ConditionInitialeSoliton(0.3, 12);
+    bool ok = grand.EcrireReprise(nom_reprise);
+
+    SaintVenant1D solveur;
+    solveur.ActiverSauvegardesAsynchrones(true, nb_sauvegardes, true);
+    solveur.DefinirPrecisionSortie(17);
+    solveur.Initialiser(N, 75.0, 0.9, nom_fichier);
+    solveur.DefinirFondPente(30, 2.5);
+    solveur.ConditionInitialeSoliton(0.3, 12);
+    for (int k = 0; k < nb_sauvegardes; k++)
+        solveur.Sauvegarder();
+    ok = ok && solveur.ChargerReprise(nom_reprise) && solveur.ObtenirH().size() == (size_t)(100 * N);
+
+    ok = ok && CompterTrames(nom_fichier, N) == nb_sauvegardes;
+    remove(nom_fichier.c_str());
+    remove(nom_reprise.c_str());
+    return ok;
+}
+
+
+// Tolérances et taux de compression pendant que le thread d'écriture compresse
+static bool CompressionPendantEcriture(int N, int nb_sauvegardes)
+{
+    const string nom_fichier = "validation_sauvegardes.svz";
+    SaintVenant1D solveur;
+    solveur.ActiverSauvegardesAsynchrones(true, nb_sauvegardes, true);
+    solveur.Initialiser(N, 75.0, 0.9, nom_fichier);
+    solveur.DefinirFondPente(30, 2.5);
+    solveur.ConditionInitialeSoliton(0.3, 12);
+    bool ok = solveur.DefinirCompressionSortie(1e-4, 1e-3, 4);
+    for (int k = 0; k < nb_sauvegardes; k++)
+    {
+        solveur.Avancer();
+        solveur.Sauvegarder();
+    }
+    double taux = solveur.ObtenirTauxCompressionSortie();
+    ok = ok && taux > 1.0;
+    solveur.Initialiser(N, 75.0, 0.9, "");
+    remove(nom_fichier.c_str());
+    return ok;
+}
+
+
+// Soliton sur la pente, sorties tous les 0.25 s à partir du premier pas après 0.1 s
+static void CalculerAvecSorties(SaintVenant1D& solveur, int N, const string& nom_fichier, int nb_sauvegardes)
+{
+    solveur.ActiverSauvegardesAsynchrones(true, nb_sauvegardes, true);
+    solveur.Initialiser(N, 75.0, 0.9, nom_fichier);
+    solveur.DefinirFondPente(30, 2.5);
+    solveur.ConditionInitialeSoliton(0.3, 12);
+    solveur.Sauvegarder();
+    while (solveur.ObtenirTemps() < 0.1)
+        solveur.Avancer();
+    solveur.DefinirIntervalleSorties(0.25);
+}
+
+
+// Calcul arrêté à t_arret, après le point de reprise écrit à t_reprise, puis repris
+// jusqu'à t_final : sans troncature, les trames entre les deux seraient écrites deux fois
+static bool RepriseSortieTexte(int N, int nb_sauvegardes)
+{
+    const string nom_reference = "validation_sauvegardes_reference.txt";
+    const string nom_fichier = "validation_sauvegardes.txt";
+    const string nom_reprise = "validation_sauvegardes.rep";
+    const double t_reprise = 1.1, t_arret = 1.6, t_final = 2.0;
+
+    SaintVenant1D reference;
+    CalculerAvecSorties(reference, N, nom_reference, nb_sauvegardes);
+    while (reference.ObtenirTemps() < t_final)
+        reference.Avancer(t_final);
+    reference.Initialiser(N, 75.0, 0.9, "");
+
+    bool ok = true;
+    {
+        SaintVenant1D arrete;
+        CalculerAvecSorties(arrete, N, nom_fichier, nb_sauvegardes);
+        while (arrete.ObtenirTemps() < t_reprise)
+            arrete.Avancer(t_final);
+        ok = arrete.EcrireReprise(nom_reprise);
+        while (arrete.ObtenirTemps() < t_arret)
+            arrete.Avancer(t_final);
+    }
+
+    // L'échéancier (intervalle et t0) vient du point de reprise
+    SaintVenant1D repris;
+    repris.ActiverSauvegardesAsynchrones(true, nb_sauvegardes, true);
+    ok = ok && repris.ChargerReprise(nom_reprise, nom_fichier);
+    while (ok && repris.ObtenirTemps() < t_final)
+        repris.Avancer(t_final);
+    repris.Initialiser(N, 75.0, 0.9, "");
+
+    string contenu = LireFichier(nom_fichier);
+    ok = ok && !contenu.empty() && contenu == LireFichier(nom_reference);
+    remove(nom_reference.c_str());
+    remove(nom_fichier.c_str());
+    remove(nom_reprise.c_str());
+    return ok;
+}
+
+
+int main(int argc, char** argv)
+{
+    int N = (argc > 1) ? atoi(argv[1]) : 2000;
+    int nb_sauvegardes = (argc > 2) ? atoi(argv[2]) : 16;
+
+    cout << "Sauvegardes asynchrones : N = " << N << ", " << nb_sauvegardes << " sauvegardes en attente" << endl;
+    streambuf* sortie = cout.rdbuf(nullptr);
+    bool initialiser = InitialiserPendantEcriture(N, nb_sauvegardes);
+    bool reprise = ReprisePendantEcriture(N, nb_sauvegardes);
+    bool compression = CompressionPendantEcriture(N, nb_sauvegardes);
+    bool sortie_reprise = RepriseSortieTexte(N, nb_sauvegardes);
+    cout.rdbuf(sortie);
+
+    bool ok = Verdict("Initialiser pendant l'ecriture", initialiser);
+    ok = Verdict("ChargerReprise pendant l'ecriture", reprise) && ok;
+    ok = Verdict("compression .svz pendant l'ecriture", compression) && ok;
+    ok = Verdict("sortie texte apres une reprise", sortie_reprise) && ok;
+    return ok ? 0 : 1;
+}
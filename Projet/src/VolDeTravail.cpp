@@ -0,0 +1,91 @@
+#include "VolDeTravail.h"
+#include <thread>
+
+using namespace std;
+
+OrdonnanceurVolDeTravail::OrdonnanceurVolDeTravail(int nb_threads)
+    : _nb_threads(nb_threads < 1 ? 1 : nb_threads), _nb_vols(0), _arret(false)
+{
+    for (int id = 0; id < _nb_threads; id++)
+        _files.emplace_back(new File());
+}
+
+
+int OrdonnanceurVolDeTravail::Suivante(int id)
+{
+    // 1. Sa propre file, par la tête
+    {
+        File& file = *_files[id];
+        lock_guard<mutex> verrou(file.mutex);
+        if (!file.taches.empty())
+        {
+            int k = file.taches.front();
+            file.taches.pop_front();
+            return k;
+        }
+    }
+
+    // 2. Vol en fin de file chez les autres threads, en commençant par le suivant
+    for (int decalage = 1; decalage < _nb_threads; decalage++)
+    {
+        File& file = *_files[(id + decalage) % _nb_threads];
+        lock_guard<mutex> verrou(file.mutex);
+        if (!file.taches.empty())
+        {
+            int k = file.taches.back();
+            file.taches.pop_back();
+            _nb_vols++;
+            return k;
+        }
+    }
+    return -1;
+}
+
+
+void OrdonnanceurVolDeTravail::Boucle(int id, const function<void(int, int)>& tache)
+{
+    for (int k = Suivante(id); k >= 0 && !_arret; k = Suivante(id))
+    {
+        try
+        {
+            tache(k, id);
+        }
+        catch (...)
+        {
+            // Une exception qui sortirait du thread appellerait std::terminate
+            lock_guard<mutex> verrou(_mutex_erreur);
+            if (!_erreur)
+                _erreur = current_exception();
+            _arret = true;
+        }
+    }
+}
+
+
+void OrdonnanceurVolDeTravail::Executer(int nb_taches, const function<void(int, int)>& tache)
+{
+    _nb_vols = 0;
+    _arret = false;
+    _erreur = nullptr;
+    for (int k = 0; k < nb_taches; k++)
+        _files[k % _nb_threads]->taches.push_back(k);
+
+    // Threads auxiliaires créés pour l'appel (les tâches durent bien plus longtemps)
+    vector<thread> threads;
+    for (int id = 1; id < _nb_threads; id++)
+        threads.emplace_back(&OrdonnanceurVolDeTravail::Boucle, this, id, cref(tache));
+
+    Boucle(0, tache);
+    for (size_t k = 0; k < threads.size(); k++)
+        threads[k].join();
+
+    if (_erreur)
+    {
+        // Tâches non faites retirées : l'ordonnanceur reste utilisable
+        for (auto& file : _files)
+            file->taches.clear();
+        exception_ptr erreur = _erreur;
+        _erreur = nullptr;
+        rethrow_exception(erreur);
+    }
+}
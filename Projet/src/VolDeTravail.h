@@ -0,0 +1,60 @@
+#ifndef _VOL_DE_TRAVAIL_H
+#define _VOL_DE_TRAVAIL_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <exception>
+
+// ========================================
+// Ordonnanceur à vol de travail
+// ========================================
+// Pour des tâches indépendantes de durées très différentes (simulations complètes),
+// où le découpage statique de PoolThreads laisse des threads inactifs.
+// Les tâches sont d'abord réparties en tourniquet dans une file par thread. Chaque
+// thread prend ses tâches en tête de sa file, dans l'ordre donné (du plus coûteux
+// au moins coûteux si l'appelant les a triées) ; quand elle est vide, il vole la
+// dernière tâche de la file d'un autre thread. Les tâches ne créant pas de nouvelles
+// tâches, un thread s'arrête dès que toutes les files sont vides.
+class OrdonnanceurVolDeTravail
+{
+private:
+    struct File
+    {
+        std::mutex mutex;
+        std::deque<int> taches;
+    };
+
+    int _nb_threads;
+    std::vector<std::unique_ptr<File> > _files;
+    std::atomic<long> _nb_vols;
+
+    // Première exception levée par une tâche pendant Executer
+    std::mutex _mutex_erreur;
+    std::exception_ptr _erreur;
+    std::atomic<bool> _arret;   // Une tâche a échoué : plus de nouvelle tâche
+
+    // Tâche suivante du thread id (la sienne ou une tâche volée), -1 s'il n'y en a plus
+    int Suivante(int id);
+    void Boucle(int id, const std::function<void(int, int)>& tache);
+
+public:
+    explicit OrdonnanceurVolDeTravail(int nb_threads);
+
+    int NombreThreads() const { return _nb_threads; }
+
+    // Appelle tache(k, id_thread) pour k = 0 .. nb_taches-1 et retourne quand toutes
+    // sont faites. Le thread appelant sert de thread 0. Si une tâche lève une
+    // exception, les threads finissent leur tâche en cours sans en prendre d'autre,
+    // puis la première exception est relancée par Executer (les tâches restantes ne
+    // sont pas faites).
+    void Executer(int nb_taches, const std::function<void(int, int)>& tache);
+
+    // Nombre de tâches volées pendant le dernier Executer
+    long ObtenirNombreVols() const { return _nb_vols; }
+};
+
+#endif // _VOL_DE_TRAVAIL_H
@@ -19,7 +19,8 @@ int main()
     double L = 75.0;           // Longueur du domaine (en mètres)
     double CFL = 0.9;        // Nombre CFL 
     double t_final = 10;     // Temps final de simulation (secondes)
-    string fichier = "solution.txt";  // Fichier de sortie
+    string fichier = "solution.txt";  // Fichier de sortie (solution.svb : binaire en colonnes, solution.svz : compressé)
+    double intervalle_sorties = 0.1;  // Sauvegarde tous les 0.1 s de temps physique
     double critere_precision = N/(L*t_final);
     
     cout << "Paramètres :" << endl;
@@ -37,6 +38,29 @@ int main()
     
     // Initialiser avec les paramètres
     solveur.Initialiser(N, L, CFL, fichier);
+    // Schéma numérique : "rusanov" ou "hll", suivi de "/hydrostatique" ou "/pente"
+    // solveur.ChoisirSchema("hll/hydrostatique");
+    // Ordre 2 (MUSCL + Runge-Kutta) : limiteur "minmod", "vanleer" ou "mc", CFL <= 0.5 conseillé
+    // solveur.ChoisirOrdre(2, "mc");
+    // Calcul multithread (résultats identiques au calcul séquentiel)
+    // solveur.DefinirNombreThreads(4);
+    // Ne calculer que les zones qui évoluent (blocs de 256 cellules, ordre 1)
+    // solveur.ActiverZonesActives(true, 256);
+    // Pas de temps local : chaque zone avance à son propre pas 2^k dt_min (ordre 1)
+    // solveur.ActiverPasDeTempsLocal(true, 4);
+    // Diagnostics (masse, énergie, crête, rivage...) calculés pendant le balayage d'Avancer
+    // solveur.ActiverDiagnosticsEnLigne(true);
+    // Point de reprise binaire tous les 500 pas (écrit en arrière-plan) ; pour repartir
+    // d'un calcul interrompu, remplacer les conditions initiales ci-dessous par
+    // solveur.ChargerReprise("reprise.bin", fichier);
+    // solveur.ActiverReprises("reprise.bin", 500);
+    // Sauvegardes écrites par un thread dédié (3 tampons, le calcul attend si le disque ne suit pas)
+    // solveur.ActiverSauvegardesAsynchrones(true, 3, true);
+    // Sortie texte avec 17 chiffres significatifs (relecture exacte ; 6 par défaut)
+    // solveur.DefinirPrecisionSortie(17);
+    // Sauvegardes aux temps exacts k * intervalle_sorties (le pas est raccourci pour
+    // les atteindre), identiques d'un calcul à l'autre quel que soit dt
+    solveur.DefinirIntervalleSorties(intervalle_sorties);
     cout << endl;
 
 
@@ -59,6 +83,13 @@ int main()
 
     // Cas E :
     // solveur.DefinirFondDoublePente(15,30,1.8,2.2);
+
+    // Cas F : profil mesuré, CSV "x,z" ou transect binaire (voir Bathymetrie.h),
+    // le bord gauche du domaine à l'abscisse 0 du profil
+    // solveur.ChargerFond("profil_plage.csv", 0.0);
+
+    // Frottement de Manning sur le fond (après le fond ; voir DefinirFrottement)
+    // solveur.DefinirFrottement(0.025);
     // ========================================
     // Condition initale : EAU
     // ========================================
@@ -111,6 +142,13 @@ int main()
     // Sauvegarder l'état initial
     solveur.Sauvegarder();
     cout << endl;
+
+    // Jauges, enveloppes, temps d'arrivée et runup calculés à chaque pas (voir
+    // Observateurs.h) : sans besoin du champ complet, les Sauvegarder deviennent facultatifs
+    // solveur.ActiverObservateurs({ 10.0, 30.0, 45.0 }, "jauges.csv");
+    // Suivi en direct : état publié tous les 10 pas en mémoire partagée, à regarder
+    // pendant le calcul avec "python3 diffusion_directe.py saintvenant"
+    // solveur.ActiverDiffusion("saintvenant", 10);
     
 
     // ========================================
@@ -124,8 +162,8 @@ int main()
     
     while (t < t_final)
     {
-        // Avancer d'un pas de temps
-        solveur.Avancer();
+        // Avancer d'un pas de temps, le dernier raccourci pour finir à t_final
+        solveur.Avancer(t_final);
         
         // Récupérer le temps actuel
         t = solveur.ObtenirTemps();
@@ -143,8 +181,11 @@ int main()
         //Validation de la vitesse et amplitude vague
         // ========================================
 
+        // Tous les diagnostics en un seul passage sur l'état
+        Diagnostics diagnostics = solveur.CalculerDiagnostics();
+
         // 1. Où est la vague maintenant ?
-        double x_actuel = solveur.ObtenirPositionCrete();
+        double x_actuel = diagnostics.x_crete;
         
         // 2. Quelle distance a-t-elle parcourue ?
         double distance = x_actuel - x_depart;
@@ -156,21 +197,24 @@ int main()
         
         // 4. On surveille aussi la hauteur (voir si elle s'écrase)
         
-        double H_max_actuel = solveur.ObtenirSurfaceMax();
+        double H_max_actuel = diagnostics.surface_max;
         
         cout << "  -> Position Crete : " << x_actuel << " m" << endl;
         cout << "  -> Vitesse Moyenne : " << vitesse_mesuree << " m/s" 
              << " (Theo: " << vitesse_theorique << ")" << endl;
         cout << "  -> Hauteur Max    : " << H_max_actuel << " m" << endl;
+        cout << "  -> Zone mouillee  : " << diagnostics.longueur_mouillee << " m, rivage en x = "
+             << diagnostics.x_rivage << " m, Froude max = " << diagnostics.froude_max
+             << " (front mince : " << diagnostics.froude_front << ")" << endl;
 
         // ========================================
         //Validation de l'energie et masse
         // ========================================
 
         // 1. Calculs
-        double masse_actuelle = solveur.CalculerMasseTotale();
+        double masse_actuelle = diagnostics.masse;
         double erreur_masse = masse_actuelle - masse_initiale;
-        double energie_actuelle = solveur.CalculerEnergieTotale();
+        double energie_actuelle = diagnostics.energie;
         double erreur_energie = energie_actuelle - energie_initiale; // L'énergie diminue un peu, c'est normal (dissipation)
 
         // 2. Affichage complet
@@ -182,15 +226,11 @@ int main()
         cout << endl;
         // ------------------------------------------------
 
-
-        // Sauvegarder de temps en temps
-        solveur.Sauvegarder();
-
         }
     }
     
-    // Sauvegarder l'état final
-    solveur.Sauvegarder();
+    // L'état final est la dernière sauvegarde : Avancer(t_final) l'écrit en atteignant
+    // t_final, même hors de l'échéancier des sorties
     
     cout << endl;
     cout << "========================================" << endl;
@@ -200,6 +240,15 @@ int main()
     cout << "  Résultats dans : " << fichier << endl;
     cout << "========================================" << endl;
     cout << endl;
+
+    // solveur.EcrireObservations("enveloppes.csv");
+
+    // Temps par phase et compteurs (si compilés avec cmake -DINSTRUMENTATION=ON)
+    if (solveur.AfficherInstrumentation())
+    {
+        solveur.EcrireInstrumentation("instrumentation.csv");
+        solveur.EcrireInstrumentation("trace_instrumentation.json");
+    }
     
     return 0;
 }
\ No newline at end of file